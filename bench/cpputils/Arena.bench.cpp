@@ -0,0 +1,114 @@
+#include "cpputils/Arena.h"
+#include "cpputils/Benchmark.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// Request-shaped allocation: one iteration serves one "request" that
+// makes 200 small allocations of 16 to 256 bytes (header nodes, tokens),
+// builds a vector of 64 strings and frees it all at the end. Compared:
+// new/delete with std containers against an Arena that is reset() after
+// every request, used directly and through ArenaResource with std::pmr
+// containers.
+
+namespace {
+
+constexpr int SMALL_ALLOCATIONS = 200;
+constexpr int STRINGS = 64;
+
+// Mixed sizes from 16 to 256 bytes, the same sequence every request
+size_t allocationSize(int index)
+{
+    return 16 + (static_cast<size_t>(index) * 37) % 241;
+}
+
+const char* fieldText(int index)
+{
+    // Long enough to leave the small string buffer
+    static const char* const TEXTS[] = {
+        "content-type: application/json; charset=utf-8",
+        "accept-encoding: gzip, deflate, br, zstd",
+        "user-agent: cpputils-benchmark/1.0 (request shaped)",
+        "x-request-id: 0f3a9c2e-5b7d-4e11-9a6c-d2f08b4e7a19",
+    };
+    return TEXTS[index % 4];
+}
+
+void newDeleteRequest(cpputils::BenchmarkState& state)
+{
+    std::vector<void*> allocations(SMALL_ALLOCATIONS);
+    while (state.keepRunning()) {
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            allocations[i] = ::operator new(allocationSize(i));
+            cpputils::doNotOptimize(allocations[i]);
+        }
+        std::vector<std::string> fields;
+        for (int i = 0; i < STRINGS; i++) {
+            fields.emplace_back(fieldText(i));
+        }
+        cpputils::doNotOptimize(fields.data());
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            ::operator delete(allocations[i]);
+        }
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void arenaRequest(cpputils::BenchmarkState& state)
+{
+    cpputils::Arena arena;
+    while (state.keepRunning()) {
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            void* memory = arena.allocate(allocationSize(i));
+            cpputils::doNotOptimize(memory);
+        }
+        {
+            cpputils::ArenaResource resource(arena);
+            std::pmr::vector<std::pmr::string> fields(&resource);
+            for (int i = 0; i < STRINGS; i++) {
+                fields.emplace_back(fieldText(i));
+            }
+            cpputils::doNotOptimize(fields.data());
+        }
+        arena.reset();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+// Only the small allocations: the bump pointer against the general-purpose heap
+void newDeleteSmall(cpputils::BenchmarkState& state)
+{
+    std::vector<void*> allocations(SMALL_ALLOCATIONS);
+    while (state.keepRunning()) {
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            allocations[i] = ::operator new(allocationSize(i));
+            cpputils::doNotOptimize(allocations[i]);
+        }
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            ::operator delete(allocations[i]);
+        }
+    }
+    state.setItemsProcessed(state.getIterations() * SMALL_ALLOCATIONS);
+}
+
+void arenaSmall(cpputils::BenchmarkState& state)
+{
+    cpputils::Arena arena;
+    while (state.keepRunning()) {
+        for (int i = 0; i < SMALL_ALLOCATIONS; i++) {
+            void* memory = arena.allocate(allocationSize(i));
+            cpputils::doNotOptimize(memory);
+        }
+        arena.reset();
+    }
+    state.setItemsProcessed(state.getIterations() * SMALL_ALLOCATIONS);
+}
+
+CPPUTILS_BENCHMARK(newDeleteRequest);
+CPPUTILS_BENCHMARK(arenaRequest);
+CPPUTILS_BENCHMARK(newDeleteSmall);
+CPPUTILS_BENCHMARK(arenaSmall);
+
+} // namespace
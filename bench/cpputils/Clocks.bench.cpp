@@ -0,0 +1,115 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/ClockDomain.h"
+#include "cpputils/Clocks.h"
+#include "cpputils/SharedMemory.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+// Per-call cost of each clock's now(), then drift of the TSC and coarse
+// clocks against steady_clock over a one second sleep. The ClockDomain
+// cases show the raw stamp and the seqlock-guarded conversion separately.
+
+namespace {
+
+template<typename ClockType>
+void clockNow(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(ClockType::now());
+    }
+}
+
+void tscReadTicks(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(cpputils::TscClock::readTicks());
+    }
+}
+
+void tscReadTicksSerialized(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(cpputils::TscClock::readTicksSerialized());
+    }
+}
+
+void clockDriftOverOneSecond(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        const auto steadyStart = std::chrono::steady_clock::now();
+        const auto tscStart = cpputils::TscClock::now();
+        const auto coarseStart = cpputils::CoarseClock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const auto tscElapsed = cpputils::TscClock::now() - tscStart;
+        const auto coarseElapsed = cpputils::CoarseClock::now() - coarseStart;
+        const auto steadyElapsed = std::chrono::steady_clock::now() - steadyStart;
+
+        state.setCounter("tscDriftUs", std::chrono::duration<double, std::micro>(tscElapsed - steadyElapsed).count());
+        state.setCounter("coarseDriftUs",
+                         std::chrono::duration<double, std::micro>(coarseElapsed - steadyElapsed).count());
+    }
+    state.setCounter("tscInvariant", cpputils::TscClock::isTscInvariant() ? 1.0 : 0.0);
+    state.setCounter("tscGHz", cpputils::TscClock::getTicksPerSecond() / 1e9);
+    state.setCounter("coarseResolutionNs", static_cast<double>(cpputils::CoarseClock::getResolution().count()));
+}
+
+uint64_t processId()
+{
+#if defined(_WIN32)
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+// Per-process segment, so concurrent bench runs do not share a domain; removed at exit
+struct BenchClockDomain
+{
+    const std::string key{"cpputils_clock_domain_bench_" + std::to_string(processId())};
+    cpputils::ClockDomain domain{key};
+
+    ~BenchClockDomain() { cpputils::SharedMemory::remove(key); }
+};
+
+cpputils::ClockDomain& benchClockDomain()
+{
+    static BenchClockDomain bench;
+    return bench.domain;
+}
+
+void clockDomainReadTicks(cpputils::BenchmarkState& state)
+{
+    const cpputils::ClockDomain& domain = benchClockDomain();
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(domain.readTicks());
+    }
+}
+
+void clockDomainNow(cpputils::BenchmarkState& state)
+{
+    const cpputils::ClockDomain& domain = benchClockDomain();
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(domain.nowNs());
+    }
+}
+
+CPPUTILS_BENCHMARK(clockNow<std::chrono::steady_clock>);
+CPPUTILS_BENCHMARK(clockNow<std::chrono::system_clock>);
+CPPUTILS_BENCHMARK(clockNow<cpputils::TscClock>);
+CPPUTILS_BENCHMARK(clockNow<cpputils::CoarseClock>);
+CPPUTILS_BENCHMARK(tscReadTicks);
+CPPUTILS_BENCHMARK(tscReadTicksSerialized);
+CPPUTILS_BENCHMARK(clockDomainReadTicks);
+CPPUTILS_BENCHMARK(clockDomainNow);
+CPPUTILS_BENCHMARK(clockDriftOverOneSecond).setIterations(1).setRepetitions(3);
+
+} // namespace
@@ -0,0 +1,90 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/EpochReclamation.h"
+#include "cpputils/WaitFreeCounter.h"
+
+#include <atomic>
+
+// Read-side cost of keeping a shared node alive while it is read, from 1
+// to hardware_concurrency threads: an EpochGuard, a HazardPointer, and a
+// per-object reference count (the wait-free Counter). Plus the write side:
+// allocating a node and retiring it.
+
+namespace {
+
+struct Node
+{
+    int value{42};
+    Counter refs;
+};
+
+cpputils::EpochDomain& domain()
+{
+    static cpputils::EpochDomain instance;
+    return instance;
+}
+
+std::atomic<Node*>& sharedNode()
+{
+    static Node node;
+    static std::atomic<Node*> shared{&node};
+    return shared;
+}
+
+void epochGuardRead(cpputils::BenchmarkState& state)
+{
+    std::atomic<Node*>& shared = sharedNode();
+    while (state.keepRunning()) {
+        cpputils::EpochGuard guard(domain());
+        cpputils::doNotOptimize(shared.load(std::memory_order_acquire)->value);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void hazardPointerRead(cpputils::BenchmarkState& state)
+{
+    std::atomic<Node*>& shared = sharedNode();
+    cpputils::HazardPointer hazard(domain());
+    while (state.keepRunning()) {
+        cpputils::doNotOptimize(hazard.protect(shared)->value);
+        hazard.reset();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void counterRefRead(cpputils::BenchmarkState& state)
+{
+    std::atomic<Node*>& shared = sharedNode();
+    while (state.keepRunning()) {
+        Node* node = shared.load(std::memory_order_acquire);
+        if (node->refs.increment_if_not_zero()) {
+            cpputils::doNotOptimize(node->value);
+            node->refs.decrement();
+        }
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void epochRetire(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        domain().retire(new Node);
+    }
+    domain().synchronize();
+}
+
+void newDelete(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        Node* node = new Node;
+        cpputils::doNotOptimize(node);
+        delete node;
+    }
+}
+
+CPPUTILS_BENCHMARK(epochGuardRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(hazardPointerRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(counterRefRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(epochRetire);
+CPPUTILS_BENCHMARK(newDelete);
+
+} // namespace
@@ -0,0 +1,53 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/Clocks.h"
+#include "cpputils/FlightRecorder.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+
+// Cost of recording into a FlightRecorder: one FlightScope (two clock reads
+// plus one ring write) and one marker, single- and multi-threaded.
+
+namespace {
+
+// One file per clock: recreating a file that is still mapped would truncate it
+template<typename ClockType>
+cpputils::FlightRecorder<ClockType>& benchRecorder()
+{
+    static const std::string path = (std::filesystem::temp_directory_path()
+                                     / (std::is_same_v<ClockType, cpputils::TscClock> ? "cpputils_flight_tsc.bench"
+                                                                                       : "cpputils_flight.bench"))
+                                        .string();
+    static cpputils::FlightRecorder<ClockType> recorder(path, 1 << 12, 64);
+    return recorder;
+}
+
+template<typename ClockType>
+void flightScope(cpputils::BenchmarkState& state)
+{
+    cpputils::FlightRecorder<ClockType>& recorder = benchRecorder<ClockType>();
+    const uint32_t name = recorder.registerName("bench scope");
+    while (state.keepRunning()) {
+        cpputils::FlightScope<ClockType> scope(recorder, name);
+    }
+}
+
+template<typename ClockType>
+void flightMarker(cpputils::BenchmarkState& state)
+{
+    cpputils::FlightRecorder<ClockType>& recorder = benchRecorder<ClockType>();
+    const uint32_t name = recorder.registerName("bench marker");
+    int64_t payload = 0;
+    while (state.keepRunning()) {
+        recorder.marker(name, payload++);
+    }
+}
+
+CPPUTILS_BENCHMARK(flightScope<std::chrono::steady_clock>).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(flightScope<cpputils::TscClock>).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(flightMarker<std::chrono::steady_clock>);
+CPPUTILS_BENCHMARK(flightMarker<cpputils::TscClock>);
+
+} // namespace
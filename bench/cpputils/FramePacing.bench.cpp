@@ -0,0 +1,50 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/FramePacing.h"
+#include "cpputils/LatencyHistogram.h"
+
+#include <chrono>
+#include <thread>
+
+// Pacing jitter at 500Hz: how late each frame deadline is met by plain
+// sleep_until versus FrameLimiter's hybrid sleep-then-spin wait. One
+// iteration is one frame, so ns/iteration should be ~2'000'000.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr std::chrono::milliseconds PERIOD(2);
+
+void reportLateness(cpputils::BenchmarkState& state, const cpputils::LatencyHistogram<>& lateness)
+{
+    state.setCounter("p50LateUs", lateness.getPercentile(50.0).count() / 1e3);
+    state.setCounter("p99LateUs", lateness.getPercentile(99.0).count() / 1e3);
+    state.setCounter("maxLateUs", lateness.getMax().count() / 1e3);
+}
+
+void sleepUntilPacing(cpputils::BenchmarkState& state)
+{
+    cpputils::LatencyHistogram<> lateness;
+    Clock::time_point deadline = Clock::now() + PERIOD;
+    while (state.keepRunning()) {
+        std::this_thread::sleep_until(deadline);
+        lateness.record(Clock::now() - deadline);
+        deadline += PERIOD;
+    }
+    reportLateness(state, lateness);
+}
+
+void frameLimiterPacing(cpputils::BenchmarkState& state)
+{
+    cpputils::LatencyHistogram<> lateness;
+    cpputils::FrameLimiter<Clock> limiter(PERIOD);
+    while (state.keepRunning()) {
+        lateness.record(limiter.wait());
+    }
+    reportLateness(state, lateness);
+    state.setCounter("spinThresholdUs", limiter.getSpinThreshold().count() / 1e3);
+}
+
+CPPUTILS_BENCHMARK(sleepUntilPacing).setIterations(500).setRepetitions(3);
+CPPUTILS_BENCHMARK(frameLimiterPacing).setIterations(500).setRepetitions(3);
+
+} // namespace
@@ -0,0 +1,148 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/Futex.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Lock throughput with 1 to 8 threads hammering one short critical
+// section (AdaptiveMutex, TicketLock, McsLock against std::mutex), and
+// handoff latency: two threads bouncing a token through a pair of
+// Semaphores against a pair of mutex + condition variable mailboxes.
+// One iteration of a ping-pong benchmark is one round trip.
+//
+// The lock benchmarks run a fixed iteration count: once threads outnumber
+// CPUs, a fair lock hands off to a descheduled waiter on every unlock
+// (lock convoy), and calibrating the iteration count on the short runs
+// where threads happen to run one after another would take minutes.
+
+namespace {
+
+constexpr uint64_t ITERATIONS = 100'000;
+
+// A few dependent loads and stores, so the lock is held for a realistic moment
+struct Shared
+{
+    uint64_t counter{0};
+    uint64_t values[8]{};
+
+    void touch()
+    {
+        counter++;
+        values[counter % 8] += counter;
+    }
+};
+
+// glibc and libstdc++ skip std::mutex's atomics until the process starts
+// its first thread; start one so the comparison is fair with 1 thread too.
+void leaveSingleThreadedMode()
+{
+    static const bool started = []() {
+        std::thread([]() {}).join();
+        return true;
+    }();
+    cpputils::doNotOptimize(started);
+}
+
+template<typename Lock>
+void lockThroughput(cpputils::BenchmarkState& state)
+{
+    static Lock lock;
+    static Shared shared;
+    leaveSingleThreadedMode();
+    while (state.keepRunning()) {
+        std::lock_guard<Lock> guard(lock);
+        shared.touch();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void adaptiveMutexLock(cpputils::BenchmarkState& state)
+{
+    lockThroughput<cpputils::AdaptiveMutex>(state);
+}
+
+void ticketLockLock(cpputils::BenchmarkState& state)
+{
+    lockThroughput<cpputils::TicketLock>(state);
+}
+
+void stdMutexLock(cpputils::BenchmarkState& state)
+{
+    lockThroughput<std::mutex>(state);
+}
+
+void mcsLockLock(cpputils::BenchmarkState& state)
+{
+    static cpputils::McsLock lock;
+    static Shared shared;
+    while (state.keepRunning()) {
+        cpputils::McsLock::Guard guard(lock);
+        shared.touch();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+// The baseline mailbox: a flag behind a mutex and a condition variable
+class CondvarSignal
+{
+public:
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready = true;
+        }
+        condition.notify_one();
+    }
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return ready; });
+        ready = false;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool ready{false};
+};
+
+template<typename Signal>
+void pingPong(cpputils::BenchmarkState& state)
+{
+    static Signal ping;
+    static Signal pong;
+    const bool pinger = state.getThreadIndex() == 0;
+    while (state.keepRunning()) {
+        if (pinger) {
+            ping.release();
+            pong.acquire();
+        } else {
+            ping.acquire();
+            pong.release();
+        }
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void semaphorePingPong(cpputils::BenchmarkState& state)
+{
+    pingPong<cpputils::Semaphore>(state);
+}
+
+void condvarPingPong(cpputils::BenchmarkState& state)
+{
+    pingPong<CondvarSignal>(state);
+}
+
+CPPUTILS_BENCHMARK(adaptiveMutexLock).setThreads({1, 2, 4, 8}).setIterations(ITERATIONS).setRepetitions(5);
+CPPUTILS_BENCHMARK(ticketLockLock).setThreads({1, 2, 4, 8}).setIterations(ITERATIONS).setRepetitions(5);
+CPPUTILS_BENCHMARK(mcsLockLock).setThreads({1, 2, 4, 8}).setIterations(ITERATIONS).setRepetitions(5);
+CPPUTILS_BENCHMARK(stdMutexLock).setThreads({1, 2, 4, 8}).setIterations(ITERATIONS).setRepetitions(5);
+CPPUTILS_BENCHMARK(semaphorePingPong).setThreads({2});
+CPPUTILS_BENCHMARK(condvarPingPong).setThreads({2});
+
+} // namespace
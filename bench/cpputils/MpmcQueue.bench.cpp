@@ -0,0 +1,134 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/MpmcQueue.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+// MpmcQueue operation cost on one thread, and fan-in/fan-out throughput
+// with 1/1, 2/2, 4/4 and 8/8 producers/consumers (even benchmark threads
+// produce, odd ones consume) against a bounded mutex + std::deque queue
+// with condition variables.
+
+namespace {
+
+constexpr size_t CAPACITY = 1024;
+constexpr size_t BATCH = 32;
+
+// The baseline: what the MPMC queue replaces
+class MutexQueue
+{
+public:
+    void push(uint64_t value)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return values.size() < CAPACITY; });
+        values.push_back(value);
+        lock.unlock();
+        notEmpty.notify_one();
+    }
+
+    uint64_t pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return !values.empty(); });
+        const uint64_t value = values.front();
+        values.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return value;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<uint64_t> values;
+};
+
+void mpmcPushPop(cpputils::BenchmarkState& state)
+{
+    cpputils::MpmcQueue<uint64_t> queue(CAPACITY);
+    uint64_t value = 0;
+    while (state.keepRunning()) {
+        queue.tryPush(value);
+        queue.tryPop(value);
+    }
+    cpputils::doNotOptimize(value);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void mpmcBatch(cpputils::BenchmarkState& state)
+{
+    cpputils::MpmcQueue<uint64_t> queue(CAPACITY);
+    std::array<uint64_t, BATCH> values{};
+    while (state.keepRunning()) {
+        queue.pushBatch(values);
+        queue.popBatch(values);
+    }
+    state.setItemsProcessed(state.getIterations() * BATCH);
+}
+
+void mpmcFanInOut(cpputils::BenchmarkState& state)
+{
+    static cpputils::MpmcQueue<uint64_t> queue(CAPACITY);
+    const bool producer = state.getThreadIndex() % 2 == 0;
+    uint64_t sum = 0;
+    while (state.keepRunning()) {
+        if (producer)
+            queue.push(sum++);
+        else
+            sum += queue.pop();
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void mpmcFanInOutBatch(cpputils::BenchmarkState& state)
+{
+    static cpputils::MpmcQueue<uint64_t> queue(CAPACITY);
+    const bool producer = state.getThreadIndex() % 2 == 0;
+    std::array<uint64_t, BATCH> values{};
+    uint64_t moved = 0;
+    while (state.keepRunning()) {
+        if (producer) {
+            for (size_t done = 0; done < BATCH;) {
+                const size_t pushed = queue.pushBatch(std::span<const uint64_t>(values.data() + done, BATCH - done));
+                done += pushed;
+                if (pushed == 0)
+                    queue.push(values[done++]);
+            }
+        } else {
+            for (size_t done = 0; done < BATCH;) {
+                done += queue.popBatchAtLeastOne(std::span<uint64_t>(values.data(), BATCH - done));
+            }
+        }
+        moved += BATCH;
+    }
+    state.setItemsProcessed(moved);
+}
+
+void mutexQueueFanInOut(cpputils::BenchmarkState& state)
+{
+    static MutexQueue queue;
+    const bool producer = state.getThreadIndex() % 2 == 0;
+    uint64_t sum = 0;
+    while (state.keepRunning()) {
+        if (producer)
+            queue.push(sum++);
+        else
+            sum += queue.pop();
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations());
+}
+
+CPPUTILS_BENCHMARK(mpmcPushPop);
+CPPUTILS_BENCHMARK(mpmcBatch);
+CPPUTILS_BENCHMARK(mpmcFanInOut).setThreads({2, 4, 8, 16});
+CPPUTILS_BENCHMARK(mpmcFanInOutBatch).setThreads({2, 4, 8, 16});
+CPPUTILS_BENCHMARK(mutexQueueFanInOut).setThreads({2, 4, 8, 16});
+
+} // namespace
@@ -0,0 +1,146 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/ObjectPool.h"
+#include "cpputils/SpscRing.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <thread>
+
+// Allocation cost for a 64-byte message: ObjectPool against malloc/free
+// and std::pmr::synchronized_pool_resource. The churn cases allocate and
+// free on one thread with 64 messages live at a time; the handoff cases
+// have thread 0 allocate messages and pass them through an SpscRing to
+// thread 1, which frees them, so every object is freed on a thread that
+// did not allocate it. One iteration is one message.
+
+namespace {
+
+constexpr size_t LIVE = 64;
+
+struct Message
+{
+    uint64_t sequence{0};
+    uint64_t fields[7]{};
+};
+
+struct PoolAllocator
+{
+    void* allocate() { return pool.allocate(); }
+    void deallocate(void* memory) { pool.deallocate(memory); }
+
+    cpputils::ObjectPool<Message> pool;
+};
+
+struct MallocAllocator
+{
+    void* allocate() { return std::malloc(sizeof(Message)); }
+    void deallocate(void* memory) { std::free(memory); }
+};
+
+struct SynchronizedPoolAllocator
+{
+    void* allocate() { return resource.allocate(sizeof(Message), alignof(Message)); }
+    void deallocate(void* memory) { resource.deallocate(memory, sizeof(Message), alignof(Message)); }
+
+    std::pmr::synchronized_pool_resource resource;
+};
+
+// glibc skips its atomics until the process starts its first thread
+void leaveSingleThreadedMode()
+{
+    static const bool started = []() {
+        std::thread([]() {}).join();
+        return true;
+    }();
+    cpputils::doNotOptimize(started);
+}
+
+template<typename Allocator>
+void churn(cpputils::BenchmarkState& state)
+{
+    static Allocator allocator;
+    leaveSingleThreadedMode();
+    std::array<void*, LIVE> live{};
+    for (void*& memory : live) {
+        memory = allocator.allocate();
+    }
+    uint64_t i = 0;
+    while (state.keepRunning()) {
+        void*& memory = live[i++ % LIVE];
+        allocator.deallocate(memory);
+        memory = allocator.allocate();
+        static_cast<Message*>(memory)->sequence = i;
+    }
+    for (void* memory : live) {
+        allocator.deallocate(memory);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+template<typename Allocator>
+void handoff(cpputils::BenchmarkState& state)
+{
+    static Allocator allocator;
+    static cpputils::SpscRing<void*> ring(1024);
+    if (state.getThreadIndex() == 0) {
+        uint64_t i = 0;
+        while (state.keepRunning()) {
+            void* memory = allocator.allocate();
+            static_cast<Message*>(memory)->sequence = ++i;
+            while (!ring.tryPush(memory)) {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        while (state.keepRunning()) {
+            void* memory = nullptr;
+            while (!ring.tryPop(memory)) {
+                std::this_thread::yield();
+            }
+            cpputils::doNotOptimize(static_cast<Message*>(memory)->sequence);
+            allocator.deallocate(memory);
+        }
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void objectPoolChurn(cpputils::BenchmarkState& state)
+{
+    churn<PoolAllocator>(state);
+}
+
+void mallocChurn(cpputils::BenchmarkState& state)
+{
+    churn<MallocAllocator>(state);
+}
+
+void synchronizedPoolChurn(cpputils::BenchmarkState& state)
+{
+    churn<SynchronizedPoolAllocator>(state);
+}
+
+void objectPoolHandoff(cpputils::BenchmarkState& state)
+{
+    handoff<PoolAllocator>(state);
+}
+
+void mallocHandoff(cpputils::BenchmarkState& state)
+{
+    handoff<MallocAllocator>(state);
+}
+
+void synchronizedPoolHandoff(cpputils::BenchmarkState& state)
+{
+    handoff<SynchronizedPoolAllocator>(state);
+}
+
+CPPUTILS_BENCHMARK(objectPoolChurn);
+CPPUTILS_BENCHMARK(mallocChurn);
+CPPUTILS_BENCHMARK(synchronizedPoolChurn);
+CPPUTILS_BENCHMARK(objectPoolHandoff).setThreads({2});
+CPPUTILS_BENCHMARK(mallocHandoff).setThreads({2});
+CPPUTILS_BENCHMARK(synchronizedPoolHandoff).setThreads({2});
+
+} // namespace
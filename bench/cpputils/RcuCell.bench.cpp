@@ -0,0 +1,89 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/RcuCell.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Reader scaling for a read-mostly table, from 1 to hardware_concurrency
+// threads: RcuCell snapshots (no shared write), RcuCell counted references,
+// a mutex, and std::atomic<std::shared_ptr>. Items/s should grow with the
+// thread count for rcuCellRead only; the others serialise on one line.
+
+namespace {
+
+struct Table
+{
+    std::array<int, 16> routes{};
+};
+
+// libstdc++ skips shared_ptr's atomics until the process starts its first
+// thread; start one so the comparison is fair with 1 thread too.
+void leaveSingleThreadedMode()
+{
+    static const bool started = []() {
+        std::thread([]() {}).join();
+        return true;
+    }();
+    cpputils::doNotOptimize(started);
+}
+
+void rcuCellRead(cpputils::BenchmarkState& state)
+{
+    static cpputils::RcuCell<Table> cell;
+    while (state.keepRunning()) {
+        cpputils::RcuSnapshot<Table> snapshot = cell.read();
+        cpputils::doNotOptimize(snapshot->routes[3]);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void rcuCellAcquire(cpputils::BenchmarkState& state)
+{
+    static cpputils::RcuCell<Table> cell;
+    while (state.keepRunning()) {
+        cpputils::RcuRef<Table> ref = cell.acquire();
+        cpputils::doNotOptimize(ref->routes[3]);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void mutexRead(cpputils::BenchmarkState& state)
+{
+    static std::mutex mutex;
+    static Table table;
+    while (state.keepRunning()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cpputils::doNotOptimize(table.routes[3]);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void atomicSharedPtrRead(cpputils::BenchmarkState& state)
+{
+    leaveSingleThreadedMode();
+    static std::atomic<std::shared_ptr<const Table>> table{std::make_shared<const Table>()};
+    while (state.keepRunning()) {
+        std::shared_ptr<const Table> snapshot = table.load(std::memory_order_acquire);
+        cpputils::doNotOptimize(snapshot->routes[3]);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void rcuCellUpdate(cpputils::BenchmarkState& state)
+{
+    static cpputils::RcuCell<Table> cell;
+    while (state.keepRunning()) {
+        cell.update([](Table& table) { table.routes[0]++; });
+    }
+}
+
+CPPUTILS_BENCHMARK(rcuCellRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(rcuCellAcquire).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(mutexRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(atomicSharedPtrRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(rcuCellUpdate);
+
+} // namespace
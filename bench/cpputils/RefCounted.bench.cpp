@@ -0,0 +1,96 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/RefCounted.h"
+
+#include <memory>
+#include <thread>
+
+// RefPtr against std::shared_ptr: creation, copy + release of one shared
+// object from 1 to hardware_concurrency threads, and weak -> strong upgrade.
+
+namespace {
+
+struct Payload : public cpputils::RefCounted
+{
+    int value{42};
+};
+
+// libstdc++ skips shared_ptr's atomics until the process starts its first
+// thread; start one so shared_ptr pays for them as in a real program.
+void leaveSingleThreadedMode()
+{
+    static const bool started = []() {
+        std::thread([]() {}).join();
+        return true;
+    }();
+    cpputils::doNotOptimize(started);
+}
+
+void refPtrMake(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        cpputils::RefPtr<Payload> object = cpputils::makeRef<Payload>();
+        cpputils::doNotOptimize(object);
+    }
+}
+
+void sharedPtrMake(cpputils::BenchmarkState& state)
+{
+    leaveSingleThreadedMode();
+    while (state.keepRunning()) {
+        std::shared_ptr<Payload> object = std::make_shared<Payload>();
+        cpputils::doNotOptimize(object);
+    }
+}
+
+void refPtrCopy(cpputils::BenchmarkState& state)
+{
+    static const cpputils::RefPtr<Payload> shared = cpputils::makeRef<Payload>();
+    while (state.keepRunning()) {
+        cpputils::RefPtr<Payload> copy = shared;
+        cpputils::doNotOptimize(copy);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void sharedPtrCopy(cpputils::BenchmarkState& state)
+{
+    leaveSingleThreadedMode();
+    static const std::shared_ptr<Payload> shared = std::make_shared<Payload>();
+    while (state.keepRunning()) {
+        std::shared_ptr<Payload> copy = shared;
+        cpputils::doNotOptimize(copy);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void weakRefLock(cpputils::BenchmarkState& state)
+{
+    static const cpputils::RefPtr<Payload> shared = cpputils::makeRef<Payload>();
+    static const cpputils::WeakRef<Payload> weak(shared);
+    while (state.keepRunning()) {
+        cpputils::RefPtr<Payload> locked = weak.lock();
+        cpputils::doNotOptimize(locked);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void weakPtrLock(cpputils::BenchmarkState& state)
+{
+    leaveSingleThreadedMode();
+    static const std::shared_ptr<Payload> shared = std::make_shared<Payload>();
+    static const std::weak_ptr<Payload> weak(shared);
+    while (state.keepRunning()) {
+        std::shared_ptr<Payload> locked = weak.lock();
+        cpputils::doNotOptimize(locked);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+CPPUTILS_BENCHMARK(refPtrMake);
+CPPUTILS_BENCHMARK(sharedPtrMake);
+CPPUTILS_BENCHMARK(refPtrCopy).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(sharedPtrCopy).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(weakRefLock).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(weakPtrLock).setThreadsUpToHardware();
+
+} // namespace
@@ -0,0 +1,138 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/CpuRelax.h"
+#include "cpputils/Seqlock.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Reader throughput for a 48-byte snapshot while a writer thread publishes
+// a new one every 100 ns (10 MHz), from 1 to hardware_concurrency
+// readers: Seqlock, MultiWriterSeqlock and a mutex-guarded copy. The
+// writer is a separate thread started by benchmark thread 0, so on a
+// machine with few cores it also competes with the readers for CPU time.
+
+namespace {
+
+constexpr std::chrono::nanoseconds WRITE_PERIOD{100};
+
+struct Quote
+{
+    std::array<uint64_t, 6> fields{};
+};
+
+struct MutexQuote
+{
+    void store(const Quote& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quote = value;
+    }
+
+    Quote load()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return quote;
+    }
+
+    std::mutex mutex;
+    Quote quote;
+};
+
+// Publishes to `target` at 10 MHz for as long as it exists
+template<typename Target>
+class PeriodicWriter
+{
+public:
+    explicit PeriodicWriter(Target& target) :
+        thread([this, &target]() {
+            Quote quote;
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+            while (!stopping.load(std::memory_order_relaxed)) {
+                quote.fields.fill(quote.fields[0] + 1);
+                target.store(quote);
+                next += WRITE_PERIOD;
+                while (std::chrono::steady_clock::now() < next) {
+                    cpputils::cpuRelax();
+                }
+            }
+        })
+    {}
+
+    ~PeriodicWriter()
+    {
+        stopping.store(true, std::memory_order_relaxed);
+        thread.join();
+    }
+
+private:
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+};
+
+template<typename Target>
+void readUnderWriter(cpputils::BenchmarkState& state, Target& target)
+{
+    std::unique_ptr<PeriodicWriter<Target>> writer;
+    if (state.getThreadIndex() == 0)
+        writer = std::make_unique<PeriodicWriter<Target>>(target);
+
+    uint64_t sum = 0;
+    while (state.keepRunning()) {
+        sum += target.load().fields[5];
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void seqlockRead(cpputils::BenchmarkState& state)
+{
+    static cpputils::Seqlock<Quote> seqlock;
+    uint64_t sum = 0;
+    while (state.keepRunning()) {
+        sum += seqlock.load().fields[5];
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void seqlockReadWhileWriting(cpputils::BenchmarkState& state)
+{
+    static cpputils::Seqlock<Quote> seqlock;
+    readUnderWriter(state, seqlock);
+}
+
+void multiWriterSeqlockReadWhileWriting(cpputils::BenchmarkState& state)
+{
+    static cpputils::MultiWriterSeqlock<Quote> seqlock;
+    readUnderWriter(state, seqlock);
+}
+
+void mutexReadWhileWriting(cpputils::BenchmarkState& state)
+{
+    static MutexQuote quote;
+    readUnderWriter(state, quote);
+}
+
+void seqlockStore(cpputils::BenchmarkState& state)
+{
+    cpputils::Seqlock<Quote> seqlock;
+    Quote quote;
+    while (state.keepRunning()) {
+        quote.fields[0]++;
+        seqlock.store(quote);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+CPPUTILS_BENCHMARK(seqlockRead).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(seqlockReadWhileWriting).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(multiWriterSeqlockReadWhileWriting).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(mutexReadWhileWriting).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(seqlockStore);
+
+} // namespace
@@ -0,0 +1,58 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/ShardedCounter.h"
+#include "cpputils/WaitFreeCounter.h"
+
+#include <atomic>
+#include <cstdint>
+
+// Contention scaling from 1 to hardware_concurrency threads, every thread
+// hammering one counter: a plain fetch_add, the wait-free Counter
+// (increment/decrement pairs), ShardedCounter::add and ShardedRefCount
+// get/put pairs.
+
+namespace {
+
+void atomicFetchAdd(cpputils::BenchmarkState& state)
+{
+    static std::atomic<uint64_t> counter{0};
+    while (state.keepRunning()) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void waitFreeCounterGetPut(cpputils::BenchmarkState& state)
+{
+    static Counter counter;
+    while (state.keepRunning()) {
+        counter.increment_if_not_zero();
+        counter.decrement();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void shardedCounterAdd(cpputils::BenchmarkState& state)
+{
+    static cpputils::ShardedCounter counter;
+    while (state.keepRunning()) {
+        counter.add();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void shardedRefCountGetPut(cpputils::BenchmarkState& state)
+{
+    static cpputils::ShardedRefCount refs;
+    while (state.keepRunning()) {
+        refs.get();
+        refs.put();
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+CPPUTILS_BENCHMARK(atomicFetchAdd).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(waitFreeCounterGetPut).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(shardedCounterAdd).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(shardedRefCountGetPut).setThreadsUpToHardware();
+
+} // namespace
@@ -0,0 +1,121 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/SpscRing.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <thread>
+
+// SpscRing message rate. The same-thread cases measure the cost of the
+// operations themselves; the threaded cases run a consumer thread that
+// drains the ring while the benchmark thread produces, which is the
+// >100M msgs/s target with batching (and needs at least two cores).
+
+namespace {
+
+constexpr size_t BATCH = 64;
+
+void spscPushPop(cpputils::BenchmarkState& state)
+{
+    cpputils::SpscRing<uint64_t> ring(1024);
+    uint64_t value = 0;
+    while (state.keepRunning()) {
+        ring.tryPush(value);
+        ring.tryPop(value);
+    }
+    cpputils::doNotOptimize(value);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void spscBatch(cpputils::BenchmarkState& state)
+{
+    cpputils::SpscRing<uint64_t> ring(1024);
+    std::array<uint64_t, BATCH> values{};
+    while (state.keepRunning()) {
+        ring.pushBatch(values);
+        ring.popBatch(values);
+    }
+    state.setItemsProcessed(state.getIterations() * BATCH);
+}
+
+void spscReserveCommit(cpputils::BenchmarkState& state)
+{
+    cpputils::SpscRing<uint64_t> ring(1024);
+    uint64_t sum = 0;
+    while (state.keepRunning()) {
+        std::span<uint64_t> slots = ring.reserve(BATCH);
+        for (size_t i = 0; i < slots.size(); i++) {
+            slots[i] = i;
+        }
+        ring.commit(slots.size());
+        std::span<const uint64_t> queued = ring.peek();
+        for (uint64_t value : queued) {
+            sum += value;
+        }
+        ring.consume(queued.size());
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations() * BATCH);
+}
+
+// Producer on the benchmark thread, consumer on its own thread
+template<bool batched>
+void runProducerConsumer(cpputils::BenchmarkState& state)
+{
+    cpputils::SpscRing<uint64_t> ring(4096);
+    std::atomic<bool> stop{false};
+    std::thread consumer([&ring, &stop]() {
+        std::array<uint64_t, BATCH> out{};
+        uint64_t sum = 0;
+        while (!stop.load(std::memory_order_relaxed) || !ring.empty()) {
+            const size_t count = ring.popBatch(out);
+            for (size_t i = 0; i < count; i++) {
+                sum += out[i];
+            }
+            if (count == 0)
+                std::this_thread::yield();
+        }
+        cpputils::doNotOptimize(sum);
+    });
+
+    uint64_t pushed = 0;
+    std::array<uint64_t, BATCH> values{};
+    while (state.keepRunning()) {
+        if constexpr (batched) {
+            size_t done = 0;
+            while (done < BATCH) {
+                done += ring.pushBatch(std::span<const uint64_t>(values.data() + done, BATCH - done));
+                if (done < BATCH)
+                    std::this_thread::yield();
+            }
+            pushed += BATCH;
+        } else {
+            while (!ring.tryPush(pushed)) {
+                std::this_thread::yield();
+            }
+            pushed++;
+        }
+    }
+    stop = true;
+    consumer.join();
+    state.setItemsProcessed(pushed);
+}
+
+void spscProducerConsumer(cpputils::BenchmarkState& state)
+{
+    runProducerConsumer<false>(state);
+}
+
+void spscProducerConsumerBatch(cpputils::BenchmarkState& state)
+{
+    runProducerConsumer<true>(state);
+}
+
+CPPUTILS_BENCHMARK(spscPushPop);
+CPPUTILS_BENCHMARK(spscBatch);
+CPPUTILS_BENCHMARK(spscReserveCommit);
+CPPUTILS_BENCHMARK(spscProducerConsumer);
+CPPUTILS_BENCHMARK(spscProducerConsumerBatch);
+
+} // namespace
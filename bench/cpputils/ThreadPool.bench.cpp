@@ -0,0 +1,235 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool against the usual mutex + condition variable + std::function
+// pool: recursive fork-join (fib with a serial cutoff, waiting tasks help
+// or block) and fine-grained throughput (batches of tiny tasks run to
+// completion), with as many workers as hardware threads.
+
+namespace {
+
+constexpr uint32_t FIB_N = 24;
+constexpr uint32_t FIB_CUTOFF = 12;
+constexpr size_t TASKS_PER_ITERATION = 1000;
+
+// The baseline: one shared queue, one lock, a heap-allocated std::function per task
+class MutexPool
+{
+public:
+    explicit MutexPool(size_t threadCount)
+    {
+        for (size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([this]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        ready.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                        if (tasks.empty())
+                            return;
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~MutexPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    // Runs queued tasks on the calling thread until none are left
+    void helpUntilEmpty()
+    {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping{false};
+};
+
+// Counts tasks submitted to a MutexPool; wait() helps run queued tasks, then blocks
+class MutexLatch
+{
+public:
+    void add() { pending.fetch_add(1, std::memory_order_relaxed); }
+
+    void done()
+    {
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+
+    void wait(MutexPool& pool)
+    {
+        pool.helpUntilEmpty();
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    std::atomic<uint32_t> pending{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+size_t workerCount()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+uint64_t serialFib(uint32_t n)
+{
+    return n < 2 ? n : serialFib(n - 1) + serialFib(n - 2);
+}
+
+uint64_t poolFib(cpputils::ThreadPool& pool, uint32_t n)
+{
+    if (n < FIB_CUTOFF)
+        return serialFib(n);
+    uint64_t left = 0;
+    cpputils::TaskGroup group(pool);
+    group.run([&]() { left = poolFib(pool, n - 1); });
+    const uint64_t right = poolFib(pool, n - 2);
+    group.wait();
+    return left + right;
+}
+
+uint64_t mutexPoolFib(MutexPool& pool, uint32_t n)
+{
+    if (n < FIB_CUTOFF)
+        return serialFib(n);
+    uint64_t left = 0;
+    MutexLatch latch;
+    latch.add();
+    pool.submit([&]() {
+        left = mutexPoolFib(pool, n - 1);
+        latch.done();
+    });
+    const uint64_t right = mutexPoolFib(pool, n - 2);
+    latch.wait(pool);
+    return left + right;
+}
+
+void threadPoolForkJoin(cpputils::BenchmarkState& state)
+{
+    cpputils::ThreadPool pool(workerCount());
+    uint64_t result = 0;
+    while (state.keepRunning()) {
+        cpputils::TaskGroup group(pool);
+        group.run([&]() { result = poolFib(pool, FIB_N); });
+        group.wait();
+    }
+    cpputils::doNotOptimize(result);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void mutexPoolForkJoin(cpputils::BenchmarkState& state)
+{
+    MutexPool pool(workerCount());
+    uint64_t result = 0;
+    while (state.keepRunning()) {
+        result = mutexPoolFib(pool, FIB_N);
+    }
+    cpputils::doNotOptimize(result);
+    state.setItemsProcessed(state.getIterations());
+}
+
+void threadPoolTinyTasks(cpputils::BenchmarkState& state)
+{
+    cpputils::ThreadPool pool(workerCount());
+    std::atomic<uint64_t> sum{0};
+    while (state.keepRunning()) {
+        cpputils::TaskGroup group(pool);
+        for (size_t i = 0; i < TASKS_PER_ITERATION; i++) {
+            group.run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations() * TASKS_PER_ITERATION);
+}
+
+void mutexPoolTinyTasks(cpputils::BenchmarkState& state)
+{
+    MutexPool pool(workerCount());
+    std::atomic<uint64_t> sum{0};
+    while (state.keepRunning()) {
+        MutexLatch latch;
+        for (size_t i = 0; i < TASKS_PER_ITERATION; i++) {
+            latch.add();
+            pool.submit([&sum, &latch, i]() {
+                sum.fetch_add(i, std::memory_order_relaxed);
+                latch.done();
+            });
+        }
+        latch.wait(pool);
+    }
+    cpputils::doNotOptimize(sum);
+    state.setItemsProcessed(state.getIterations() * TASKS_PER_ITERATION);
+}
+
+// Tiny tasks spawned from inside the pool: they go to a worker deque, not the injection queue
+void threadPoolParallelFor(cpputils::BenchmarkState& state)
+{
+    cpputils::ThreadPool pool(workerCount());
+    std::vector<uint64_t> values(TASKS_PER_ITERATION * 16, 1);
+    while (state.keepRunning()) {
+        pool.parallelFor(0, values.size(), [&](size_t i) { values[i] += i; }, 16);
+    }
+    cpputils::doNotOptimize(values.data());
+    state.setItemsProcessed(state.getIterations() * TASKS_PER_ITERATION);
+}
+
+CPPUTILS_BENCHMARK(threadPoolForkJoin);
+CPPUTILS_BENCHMARK(mutexPoolForkJoin);
+CPPUTILS_BENCHMARK(threadPoolTinyTasks);
+CPPUTILS_BENCHMARK(mutexPoolTinyTasks);
+CPPUTILS_BENCHMARK(threadPoolParallelFor);
+
+} // namespace
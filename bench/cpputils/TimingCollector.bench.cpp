@@ -0,0 +1,42 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/LatencyHistogram.h"
+#include "cpputils/TimingCollector.h"
+
+#include <chrono>
+#include <mutex>
+
+// Contention benchmark: every thread records into the same sink as fast as it can.
+// Compares the sharded collector against one histogram behind a mutex.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void shardedCollectorRecord(cpputils::BenchmarkState& state)
+{
+    static cpputils::ShardedTimingCollector<Clock> collector;
+
+    int64_t i = state.getThreadIndex();
+    while (state.keepRunning()) {
+        collector.record(std::chrono::nanoseconds(100 + (i++ & 1023)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void mutexHistogramRecord(cpputils::BenchmarkState& state)
+{
+    static std::mutex mutex;
+    static cpputils::LatencyHistogram<> histogram;
+
+    int64_t i = state.getThreadIndex();
+    while (state.keepRunning()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        histogram.record(std::chrono::nanoseconds(100 + (i++ & 1023)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+CPPUTILS_BENCHMARK(shardedCollectorRecord).setThreadsUpToHardware();
+CPPUTILS_BENCHMARK(mutexHistogramRecord).setThreadsUpToHardware();
+
+} // namespace
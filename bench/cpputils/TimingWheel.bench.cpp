@@ -0,0 +1,125 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/TimingWheel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+// 1M outstanding timeouts spread over 60s at 1ms resolution, e.g. idle
+// timeouts for 1M connections. Compares TimingWheel against a
+// std::priority_queue timer heap (lazy cancellation by generation):
+// - rearm: push one connection's deadline back, as on every received packet
+// - tick:  advance 1ms, expire the ~17 due timers and re-arm them 60s out
+
+namespace {
+
+constexpr size_t TIMER_COUNT = 1'000'000;
+constexpr uint64_t SPREAD_TICKS = 60'000;
+
+struct HeapEntry
+{
+    uint64_t expiryTick;
+    uint32_t id;
+    uint32_t generation;
+
+    bool operator>(const HeapEntry& other) const { return expiryTick > other.expiryTick; }
+};
+
+using TimerHeap = std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>>;
+
+struct HeapTimers
+{
+    HeapTimers()
+    {
+        std::mt19937_64 random(1);
+        generations.resize(TIMER_COUNT, 0);
+        for (uint32_t id = 0; id < TIMER_COUNT; id++) {
+            heap.push({1 + random() % SPREAD_TICKS, id, 0});
+        }
+    }
+
+    TimerHeap heap;
+    std::vector<uint32_t> generations;
+};
+
+struct WheelTimers
+{
+    WheelTimers() : nodes(std::make_unique<cpputils::TimerNode[]>(TIMER_COUNT))
+    {
+        wheel = std::make_unique<cpputils::TimingWheel<>>();
+        std::mt19937_64 random(1);
+        for (size_t i = 0; i < TIMER_COUNT; i++) {
+            wheel->scheduleTick(nodes[i], 1 + random() % SPREAD_TICKS);
+        }
+    }
+
+    // Declared first so the wheel is destroyed (and unlinks them) before the nodes
+    std::unique_ptr<cpputils::TimerNode[]> nodes;
+    std::unique_ptr<cpputils::TimingWheel<>> wheel;
+};
+
+void timingWheelRearm(cpputils::BenchmarkState& state)
+{
+    WheelTimers timers;
+    std::mt19937_64 random(2);
+    while (state.keepRunning()) {
+        cpputils::TimerNode& node = timers.nodes[random() % TIMER_COUNT];
+        timers.wheel->scheduleTick(node, timers.wheel->getCurrentTick() + 1 + random() % SPREAD_TICKS);
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void timerHeapRearm(cpputils::BenchmarkState& state)
+{
+    HeapTimers timers;
+    std::mt19937_64 random(2);
+    while (state.keepRunning()) {
+        const uint32_t id = static_cast<uint32_t>(random() % TIMER_COUNT);
+        timers.heap.push({1 + random() % SPREAD_TICKS, id, ++timers.generations[id]});
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void timingWheelTick(cpputils::BenchmarkState& state)
+{
+    WheelTimers timers;
+    cpputils::TimingWheel<>& wheel = *timers.wheel;
+    uint64_t expired = 0;
+    uint64_t tick = 0;
+    while (state.keepRunning()) {
+        expired += wheel.advanceToTick(++tick, [&wheel](cpputils::TimerNode& node) {
+            wheel.scheduleTick(node, wheel.getCurrentTick() + SPREAD_TICKS);
+        });
+    }
+    state.setItemsProcessed(expired);
+}
+
+void timerHeapTick(cpputils::BenchmarkState& state)
+{
+    HeapTimers timers;
+    uint64_t expired = 0;
+    uint64_t tick = 0;
+    while (state.keepRunning()) {
+        tick++;
+        while (!timers.heap.empty() && timers.heap.top().expiryTick <= tick) {
+            const HeapEntry entry = timers.heap.top();
+            timers.heap.pop();
+            if (entry.generation != timers.generations[entry.id])
+                continue;
+            expired++;
+            timers.heap.push({tick + SPREAD_TICKS, entry.id, entry.generation});
+        }
+    }
+    state.setItemsProcessed(expired);
+}
+
+CPPUTILS_BENCHMARK(timingWheelRearm);
+CPPUTILS_BENCHMARK(timerHeapRearm);
+CPPUTILS_BENCHMARK(timingWheelTick);
+CPPUTILS_BENCHMARK(timerHeapTick);
+
+} // namespace
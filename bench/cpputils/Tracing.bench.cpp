@@ -0,0 +1,27 @@
+#include "cpputils/Benchmark.h"
+#include "cpputils/Clocks.h"
+#include "cpputils/Tracing.h"
+
+#include <chrono>
+
+// Cost of one TraceScope (two clock reads plus one ring write) with tracing
+// enabled and disabled, for the default steady_clock and for TscClock.
+
+namespace {
+
+template<typename ClockType, bool enabled>
+void traceScope(cpputils::BenchmarkState& state)
+{
+    cpputils::Tracer<ClockType> tracer(1 << 16);
+    tracer.setEnabled(enabled);
+    while (state.keepRunning()) {
+        cpputils::TraceScope<ClockType> scope("bench", "bench", tracer);
+    }
+}
+
+CPPUTILS_BENCHMARK(traceScope<std::chrono::steady_clock, true>);
+CPPUTILS_BENCHMARK(traceScope<std::chrono::steady_clock, false>);
+CPPUTILS_BENCHMARK(traceScope<cpputils::TscClock, true>);
+CPPUTILS_BENCHMARK(traceScope<cpputils::TscClock, false>);
+
+} // namespace
@@ -0,0 +1,13 @@
+#include "cpputils/AllocationTracker.h"
+#include "cpputils/Benchmark.h"
+
+// Benchmarks register themselves from bench/cpputils/*.bench.cpp.
+// Usage: cpputils_bench [--filter=REGEX] [--json[=PATH]] [--repetitions=N] [--min-time-ms=N] [--allocations] [--list]
+
+// Lets --allocations report heap allocations per iteration
+CPPUTILS_DEFINE_ALLOCATION_HOOKS();
+
+int main(int argc, char** argv)
+{
+    return cpputils::BenchmarkRunner::main(argc, argv);
+}
@@ -1,6 +1,8 @@
 #ifndef CPPUTILS_ALIGNED_BUFFER_H
 #define CPPUTILS_ALIGNED_BUFFER_H
 
+#include <cstddef>
+#include <cstdlib>
 
 #ifdef _WIN32
     #include <malloc.h>
@@ -13,12 +15,15 @@
 #endif
 
 namespace cpputils {
-    void* aligned_alloc(size_t size, size_t alignment)
+    // Destructive interference size assumed by the padded/sharded structures in this library
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    inline void* aligned_alloc(size_t size, size_t alignment)
     {
         return ALIGNED_ALLOC(size, alignment);
     }
 
-    void aligned_free(void* ptr)
+    inline void aligned_free(void* ptr)
     {
         ALIGNED_FREE(ptr);
     }
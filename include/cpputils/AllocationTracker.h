@@ -0,0 +1,383 @@
+#ifndef CPPUTILS_ALLOCATION_TRACKER_H
+#define CPPUTILS_ALLOCATION_TRACKER_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#elif defined(__linux__)
+    #include <malloc.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// struct AllocationCounters
+//
+// Heap activity of one thread. Byte counts use the allocator's usable
+// size (malloc_usable_size / _msize) so allocations and frees balance
+// even for unsized delete. Memory freed by another thread than the one
+// that allocated it is counted on the freeing thread, so currentBytes
+// is a per-thread net figure and can go negative.
+//------------------------------------------------------------
+struct AllocationCounters
+{
+    uint64_t allocations{0};
+    uint64_t deallocations{0};
+    uint64_t bytesAllocated{0};
+    uint64_t bytesFreed{0};
+    int64_t currentBytes{0};
+    int64_t peakBytes{0};
+};
+
+//------------------------------------------------------------
+// class AllocationTracker
+//
+// Process-wide switch and per-thread counters fed by the global
+// operator new/delete replacements that CPPUTILS_DEFINE_ALLOCATION_HOOKS()
+// defines. Tracking is opt-in twice over: the hooks must be defined in
+// exactly one translation unit of the executable, and setEnabled(true)
+// must be called. While disabled the hooks cost one relaxed load and a
+// predictable branch on top of malloc/free.
+//------------------------------------------------------------
+class AllocationTracker
+{
+public:
+    static void setEnabled(bool enable) { enabledFlag().store(enable, std::memory_order_relaxed); }
+
+    static bool isEnabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+    // True when CPPUTILS_DEFINE_ALLOCATION_HOOKS() is linked into the executable
+    static bool hooksInstalled() { return hooksInstalledFlag().load(std::memory_order_relaxed); }
+
+    static AllocationCounters& threadCounters() { return counters; }
+
+    static void onAllocate(void* ptr)
+    {
+        const uint64_t size = usableSize(ptr);
+        counters.allocations++;
+        counters.bytesAllocated += size;
+        counters.currentBytes += static_cast<int64_t>(size);
+        counters.peakBytes = std::max(counters.peakBytes, counters.currentBytes);
+    }
+
+    static void onFree(void* ptr, size_t alignment = 0)
+    {
+        const uint64_t size = usableSize(ptr, alignment);
+        counters.deallocations++;
+        counters.bytesFreed += size;
+        counters.currentBytes -= static_cast<int64_t>(size);
+    }
+
+    static size_t usableSize([[maybe_unused]] void* ptr, [[maybe_unused]] size_t alignment = 0)
+    {
+#if defined(_WIN32)
+        return alignment == 0 ? _msize(ptr) : _aligned_msize(ptr, alignment, 0);
+#elif defined(__linux__)
+        return malloc_usable_size(ptr);
+#else
+        return 0;
+#endif
+    }
+
+    static std::atomic<bool>& enabledFlag()
+    {
+        static constinit std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    static std::atomic<bool>& hooksInstalledFlag()
+    {
+        static constinit std::atomic<bool> installed{false};
+        return installed;
+    }
+
+private:
+    // constinit: no lazy-init guard inside operator new
+    static constinit thread_local inline AllocationCounters counters{};
+};
+
+//------------------------------------------------------------
+// class AllocationScope
+//
+// Heap activity of the calling thread between construction and now,
+// plus the elapsed time on clockType, so a scope can report both
+// duration and allocations per operation, or a test can assert a hot
+// path does not allocate:
+//
+//     cpputils::AllocationScope<> scope;
+//     hotPath();
+//     EXPECT_EQ(scope.getAllocations(), 0u);
+//
+// Scopes nest; the peak is the high-water mark above the scope's start.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class AllocationScope
+{
+public:
+    AllocationScope()
+    {
+        AllocationCounters& counters = AllocationTracker::threadCounters();
+        start = counters;
+        counters.peakBytes = counters.currentBytes;
+        startTime = clockType::now();
+    }
+
+    ~AllocationScope()
+    {
+        AllocationCounters& counters = AllocationTracker::threadCounters();
+        counters.peakBytes = std::max(counters.peakBytes, start.peakBytes);
+    }
+
+    AllocationScope(const AllocationScope& other) = delete;
+    AllocationScope& operator=(const AllocationScope& other) = delete;
+
+    uint64_t getAllocations() const { return AllocationTracker::threadCounters().allocations - start.allocations; }
+
+    uint64_t getDeallocations() const
+    {
+        return AllocationTracker::threadCounters().deallocations - start.deallocations;
+    }
+
+    uint64_t getBytesAllocated() const
+    {
+        return AllocationTracker::threadCounters().bytesAllocated - start.bytesAllocated;
+    }
+
+    // Bytes allocated in the scope and not yet freed
+    int64_t getNetBytes() const { return AllocationTracker::threadCounters().currentBytes - start.currentBytes; }
+
+    int64_t getPeakBytes() const
+    {
+        const AllocationCounters& counters = AllocationTracker::threadCounters();
+        return std::max(counters.peakBytes, counters.currentBytes) - start.currentBytes;
+    }
+
+    double getAllocationsPerOp(uint64_t operations) const
+    {
+        return operations == 0 ? 0.0 : static_cast<double>(getAllocations()) / static_cast<double>(operations);
+    }
+
+    template<ChronoDuration durationType>
+    durationType getDuration() const
+    {
+        return std::chrono::duration_cast<durationType>(clockType::now() - startTime);
+    }
+
+private:
+    AllocationCounters start;
+    clockType::time_point startTime;
+};
+
+//------------------------------------------------------------
+// class ScopePrintAllocations
+//
+// ScopePrintTimer that also prints the scope's heap activity:
+// "<prefix><duration> allocs=N bytes=N peak=N".
+//------------------------------------------------------------
+template<Clock clockType, ChronoDuration durationType>
+class ScopePrintAllocations
+{
+public:
+    ScopePrintAllocations(const std::string& printoutPrefix, std::ostream& ostream = std::cout) :
+        _printoutPrefix(printoutPrefix), _ostream(ostream)
+    {}
+
+    ~ScopePrintAllocations()
+    {
+        // Read everything before the stream write, which may allocate itself
+        const long long count = scope.template getDuration<durationType>().count();
+        const uint64_t allocations = scope.getAllocations();
+        const uint64_t bytes = scope.getBytesAllocated();
+        const int64_t peak = scope.getPeakBytes();
+        _ostream << _printoutPrefix << count << " allocs=" << allocations << " bytes=" << bytes << " peak=" << peak
+                 << std::endl;
+    }
+
+private:
+    AllocationScope<clockType> scope;
+    const std::string _printoutPrefix;
+    std::ostream& _ostream;
+};
+
+//------------------------------------------------------------
+// class TrackingMemoryResource
+//
+// std::pmr::memory_resource that forwards to `upstream` and counts what
+// passes through it. Works without the global hooks and counts exact
+// requested sizes. Counters are atomics, so the resource may be shared
+// if the upstream is thread-safe.
+//------------------------------------------------------------
+class TrackingMemoryResource : public std::pmr::memory_resource
+{
+public:
+    explicit TrackingMemoryResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+        upstream(upstream)
+    {}
+
+    uint64_t getAllocations() const { return allocations.load(std::memory_order_relaxed); }
+    uint64_t getDeallocations() const { return deallocations.load(std::memory_order_relaxed); }
+    uint64_t getBytesAllocated() const { return bytesAllocated.load(std::memory_order_relaxed); }
+    int64_t getCurrentBytes() const { return currentBytes.load(std::memory_order_relaxed); }
+    int64_t getPeakBytes() const { return peakBytes.load(std::memory_order_relaxed); }
+
+    void reset()
+    {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        bytesAllocated.store(0, std::memory_order_relaxed);
+        peakBytes.store(currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        void* ptr = upstream->allocate(bytes, alignment);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+        const int64_t current = currentBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed)
+                                + static_cast<int64_t>(bytes);
+        int64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(ptr, bytes, alignment);
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        currentBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream;
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytesAllocated{0};
+    std::atomic<int64_t> currentBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+};
+
+namespace detail {
+
+inline void* trackedAllocate(size_t size, size_t alignment)
+{
+    size = size == 0 ? 1 : size;
+    void* ptr = nullptr;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ptr = std::malloc(size);
+    } else {
+        // std::aligned_alloc requires a size that is a multiple of the alignment
+        ptr = aligned_alloc((size + alignment - 1) / alignment * alignment, alignment);
+    }
+    if (ptr != nullptr && AllocationTracker::isEnabled()) [[unlikely]]
+        AllocationTracker::onAllocate(ptr);
+    return ptr;
+}
+
+inline void trackedFree(void* ptr, size_t alignment)
+{
+    if (ptr == nullptr)
+        return;
+    const bool overAligned = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    if (AllocationTracker::isEnabled()) [[unlikely]]
+        AllocationTracker::onFree(ptr, overAligned ? alignment : 0);
+    if (overAligned)
+        aligned_free(ptr);
+    else
+        std::free(ptr);
+}
+
+inline void* trackedNew(size_t size, size_t alignment)
+{
+    void* ptr = trackedAllocate(size, alignment);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+} // namespace detail
+
+} // namespace cpputils
+
+// Replaces the global operator new/delete family with versions that feed
+// AllocationTracker. Use once, at namespace scope, in one .cpp file of
+// the executable (tests, benchmarks, or the application itself).
+#define CPPUTILS_DEFINE_ALLOCATION_HOOKS()                                                                             \
+    static const bool cpputilsAllocationHooksInstalled = []() {                                                        \
+        ::cpputils::AllocationTracker::hooksInstalledFlag().store(true, std::memory_order_relaxed);                    \
+        return true;                                                                                                   \
+    }();                                                                                                               \
+    void* operator new(std::size_t size)                                                                               \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedNew(size, 0);                                                                \
+    }                                                                                                                  \
+    void* operator new[](std::size_t size)                                                                             \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedNew(size, 0);                                                                \
+    }                                                                                                                  \
+    void* operator new(std::size_t size, std::align_val_t alignment)                                                   \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedNew(size, static_cast<std::size_t>(alignment));                              \
+    }                                                                                                                  \
+    void* operator new[](std::size_t size, std::align_val_t alignment)                                                 \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedNew(size, static_cast<std::size_t>(alignment));                              \
+    }                                                                                                                  \
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept                                               \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedAllocate(size, 0);                                                           \
+    }                                                                                                                  \
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept                                             \
+    {                                                                                                                  \
+        return ::cpputils::detail::trackedAllocate(size, 0);                                                           \
+    }                                                                                                                  \
+    void operator delete(void* ptr) noexcept                                                                           \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, 0);                                                                       \
+    }                                                                                                                  \
+    void operator delete[](void* ptr) noexcept                                                                         \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, 0);                                                                       \
+    }                                                                                                                  \
+    void operator delete(void* ptr, std::size_t) noexcept                                                              \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, 0);                                                                       \
+    }                                                                                                                  \
+    void operator delete[](void* ptr, std::size_t) noexcept                                                            \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, 0);                                                                       \
+    }                                                                                                                  \
+    void operator delete(void* ptr, std::align_val_t alignment) noexcept                                               \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, static_cast<std::size_t>(alignment));                                     \
+    }                                                                                                                  \
+    void operator delete[](void* ptr, std::align_val_t alignment) noexcept                                             \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, static_cast<std::size_t>(alignment));                                     \
+    }                                                                                                                  \
+    void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept                                  \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, static_cast<std::size_t>(alignment));                                     \
+    }                                                                                                                  \
+    void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept                                \
+    {                                                                                                                  \
+        ::cpputils::detail::trackedFree(ptr, static_cast<std::size_t>(alignment));                                     \
+    }                                                                                                                  \
+    static_assert(true, "")
+
+#endif // End CPPUTILS_ALLOCATION_TRACKER_H
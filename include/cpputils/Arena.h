@@ -0,0 +1,233 @@
+#ifndef CPPUTILS_ARENA_H
+#define CPPUTILS_ARENA_H
+
+#include "cpputils/Alignment.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class Arena
+//
+// Monotonic region allocator for scratch memory that dies all at once,
+// such as everything built while serving one request. allocate() bumps a
+// pointer through a chain of AlignedBuffer blocks; nothing is freed
+// individually. reset() rewinds to the first block in O(1) and keeps
+// every block, so an arena reused per request stops touching the heap
+// once it has grown to the largest request's size.
+//
+// mark()/rewind() (or an Arena::Scope) free everything allocated since
+// the mark, for nested scratch work. Allocations larger than a block get
+// a block of their own, which is kept and reused like the others until
+// release().
+//
+// Destructors of objects placed in the arena never run, so create() and
+// allocateArray() only take trivially destructible types. Not
+// thread-safe: use one arena per thread or per request.
+//------------------------------------------------------------
+class Arena
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    // Position to rewind() to
+    struct Mark
+    {
+        size_t block{0};
+        size_t offset{0};
+    };
+
+    // Rewinds the arena, when it goes away, to where it was when it was made
+    class Scope
+    {
+    public:
+        explicit Scope(Arena& arena) : arena(arena), mark(arena.mark()) {}
+        ~Scope() { arena.rewind(mark); }
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+
+    private:
+        Arena& arena;
+        const Mark mark;
+    };
+
+    // Blocks are aligned to `blockAlignment`, a power of two
+    explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE, size_t blockAlignment = CACHE_LINE_SIZE) :
+        blockSize(roundUp(std::max<size_t>(blockSize, blockAlignment), blockAlignment)),
+        blockAlignment(blockAlignment)
+    {}
+
+    Arena(const Arena& other) = delete;
+    Arena& operator=(const Arena& other) = delete;
+
+    // No move operations for now: Scopes and ArenaResources hold references
+    Arena(Arena&& other) noexcept = delete;
+    Arena& operator=(Arena&& other) noexcept = delete;
+
+    // `alignment` must be a power of two. nullptr if the system is out of memory.
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT)
+    {
+        const uintptr_t aligned = roundUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+        const uintptr_t limit = reinterpret_cast<uintptr_t>(end);
+        if (cursor != nullptr && aligned <= limit && bytes <= limit - aligned) [[likely]] {
+            cursor = reinterpret_cast<char*>(aligned + bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocateFromNextBlock(bytes, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        void* memory = allocate(sizeof(T), alignof(T));
+        return memory != nullptr ? ::new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    // Default-initialised: trivial types are left uninitialised
+    template<typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        T* memory = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        if (memory != nullptr)
+            std::uninitialized_default_construct_n(memory, count);
+        return memory;
+    }
+
+    Mark mark() const
+    {
+        if (cursor == nullptr)
+            return Mark{};
+        return Mark{currentBlock, static_cast<size_t>(cursor - static_cast<char*>(blocks[currentBlock].buf))};
+    }
+
+    // Frees everything allocated since `position` was taken; keeps the blocks
+    void rewind(const Mark& position)
+    {
+        if (blocks.empty())
+            return;
+        currentBlock = position.block;
+        AlignedBuffer& block = blocks[currentBlock];
+        cursor = static_cast<char*>(block.buf) + position.offset;
+        end = static_cast<char*>(block.buf) + block.size;
+    }
+
+    // Frees everything; keeps the blocks for reuse
+    void reset() { rewind(Mark{}); }
+
+    // Frees everything and returns the blocks to the system
+    void release()
+    {
+        blocks.clear();
+        currentBlock = 0;
+        cursor = nullptr;
+        end = nullptr;
+    }
+
+    size_t getBlockSize() const { return blockSize; }
+    size_t getBlockCount() const { return blocks.size(); }
+
+    size_t getBytesReserved() const
+    {
+        size_t total = 0;
+        for (const AlignedBuffer& block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    static uintptr_t roundUp(uintptr_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+    // Slow path: the current block is full
+    void* allocateFromNextBlock(size_t bytes, size_t alignment)
+    {
+        // A block start is aligned to blockAlignment; padding covers any stricter alignment
+        const size_t needed = bytes + (alignment > blockAlignment ? alignment - blockAlignment : 0);
+
+        // Reuse kept blocks that are big enough; skip the ones that are not
+        size_t next = cursor == nullptr ? 0 : currentBlock + 1;
+        while (next < blocks.size() && blocks[next].size < needed) {
+            next++;
+        }
+        if (next == blocks.size()) {
+            AlignedBuffer block(roundUp(std::max(blockSize, needed), blockAlignment), blockAlignment);
+            if (block.buf == nullptr) {
+                std::cerr << "ERROR cpputils Arena::allocate() could not allocate a block for " << bytes << " bytes"
+                          << std::endl;
+                return nullptr;
+            }
+            blocks.push_back(std::move(block));
+        }
+
+        currentBlock = next;
+        cursor = static_cast<char*>(blocks[next].buf);
+        end = cursor + blocks[next].size;
+        return allocate(bytes, alignment);
+    }
+
+    size_t blockSize;
+    size_t blockAlignment;
+    std::vector<AlignedBuffer> blocks;
+    size_t currentBlock{0};
+    char* cursor{nullptr};
+    char* end{nullptr};
+};
+
+//------------------------------------------------------------
+// class ArenaResource
+//
+// std::pmr::memory_resource over an Arena, so std::pmr containers and
+// strings can allocate from it:
+//
+//     cpputils::ArenaResource resource(arena);
+//     std::pmr::vector<int> values(&resource);
+//
+// deallocate() is a no-op: memory comes back with arena.reset(), after
+// every container using it is gone. As the memory_resource contract
+// requires, allocation failure throws std::bad_alloc.
+//------------------------------------------------------------
+class ArenaResource : public std::pmr::memory_resource
+{
+public:
+    explicit ArenaResource(Arena& arena) : arena(arena) {}
+
+    Arena& getArena() { return arena; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        void* memory = arena.allocate(bytes, alignment);
+        if (memory == nullptr)
+            throw std::bad_alloc();
+        return memory;
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+    {
+        (void)pointer;
+        (void)bytes;
+        (void)alignment;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Arena& arena;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_ARENA_H
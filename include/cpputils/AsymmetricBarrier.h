@@ -0,0 +1,71 @@
+#ifndef CPPUTILS_ASYMMETRIC_BARRIER_H
+#define CPPUTILS_ASYMMETRIC_BARRIER_H
+
+#include <atomic>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <linux/membarrier.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+//------------------------------------------------------------
+// Asymmetric memory barriers
+//
+// A store followed by a load of a different location needs a full
+// fence on both sides (Dekker). When one side runs millions of times
+// per second and the other rarely, the fast side can use
+// asymmetricLightBarrier() (compiler-only) as long as the slow side
+// calls asymmetricHeavyBarrier(), which forces a full fence on every
+// running thread of the process (membarrier() on Linux,
+// FlushProcessWriteBuffers() on Windows).
+//
+// Where that is unavailable both degrade to a seq_cst thread fence.
+//------------------------------------------------------------
+
+namespace cpputils {
+
+inline bool processWideBarrierAvailable()
+{
+#if defined(_WIN32)
+    return true;
+#elif defined(__linux__) && defined(SYS_membarrier)
+    static const bool available = []() {
+        const long commands = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+        if (commands < 0 || (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0)
+            return false;
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+inline void asymmetricLightBarrier()
+{
+    if (processWideBarrierAvailable()) [[likely]]
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void asymmetricHeavyBarrier()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!processWideBarrierAvailable())
+        return;
+
+#if defined(_WIN32)
+    FlushProcessWriteBuffers();
+#elif defined(__linux__) && defined(SYS_membarrier)
+    syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_ASYMMETRIC_BARRIER_H
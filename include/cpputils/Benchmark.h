@@ -0,0 +1,680 @@
+#ifndef CPPUTILS_BENCHMARK_H
+#define CPPUTILS_BENCHMARK_H
+
+#include "cpputils/AllocationTracker.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// Optimization barriers
+//
+// doNotOptimize() forces `value` to be materialized, so the computation
+// producing it cannot be removed as dead code. clobberMemory() forces all
+// pending writes to memory, so stores inside the loop cannot be elided.
+// Neither emits an instruction on GCC/Clang.
+//------------------------------------------------------------
+template<typename T>
+inline void doNotOptimize(T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile void* volatile sink = &value;
+    static_cast<void>(sink);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile void* volatile sink = &value;
+    static_cast<void>(sink);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline void clobberMemory()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+//------------------------------------------------------------
+// class BenchmarkState
+//
+// Handed to every benchmark function, once per thread and run:
+//
+//     void myBenchmark(cpputils::BenchmarkState& state)
+//     {
+//         setup();                     // not timed
+//         while (state.keepRunning()) {
+//             cpputils::doNotOptimize(work());
+//         }
+//     }
+//
+// The clock starts on the first keepRunning() call and stops when it
+// returns false, so the loop costs one decrement and one branch per
+// iteration. Counters are summed over threads and reported per run.
+// Heap allocations inside the timed loop are counted when the runner
+// tracks them (see BenchmarkRunner::Options::trackAllocations).
+//------------------------------------------------------------
+class BenchmarkState
+{
+public:
+    BenchmarkState(uint64_t iterations, int64_t arg, int threadIndex, int threadCount) :
+        iterations(iterations), arg(arg), threadIndex(threadIndex), threadCount(threadCount)
+    {}
+
+    bool keepRunning()
+    {
+        if (remaining != 0) [[likely]] {
+            remaining--;
+            return true;
+        }
+        return advance();
+    }
+
+    // Excludes the code between pauseTiming() and resumeTiming() from the measurement
+    void pauseTiming() { pauseTimer.reset(); }
+    void resumeTiming() { pausedNs += pauseTimer.getElapsedTimeNs(); }
+
+    void setCounter(const std::string& name, double value) { counters[name] = value; }
+    void setItemsProcessed(uint64_t count) { itemsProcessed = count; }
+
+    uint64_t getIterations() const { return iterations; }
+    int64_t getArg() const { return arg; }
+    int getThreadIndex() const { return threadIndex; }
+    int getThreadCount() const { return threadCount; }
+
+    int64_t getElapsedNs() const { return elapsedNs; }
+    uint64_t getAllocations() const { return allocations; }
+    uint64_t getItemsProcessed() const { return itemsProcessed; }
+    const std::map<std::string, double>& getCounters() const { return counters; }
+
+private:
+    bool advance()
+    {
+        if (!started) {
+            started = true;
+            remaining = iterations - 1;
+            allocations = AllocationTracker::threadCounters().allocations;
+            timer.reset();
+            return true;
+        }
+        elapsedNs = timer.getElapsedTimeNs() - pausedNs;
+        allocations = AllocationTracker::threadCounters().allocations - allocations;
+        return false;
+    }
+
+    uint64_t iterations;
+    uint64_t remaining{0};
+    bool started{false};
+    int64_t arg;
+    int threadIndex;
+    int threadCount;
+
+    ResettableTimer<std::chrono::steady_clock> timer;
+    ResettableTimer<std::chrono::steady_clock> pauseTimer;
+    int64_t pausedNs{0};
+    int64_t elapsedNs{0};
+    uint64_t allocations{0};
+
+    uint64_t itemsProcessed{0};
+    std::map<std::string, double> counters;
+};
+
+//------------------------------------------------------------
+// struct BenchmarkStatistics
+//
+// Robust summary of the per-repetition samples. Samples further than
+// outlierMads scaled MADs (and at least 1%) from the median are rejected
+// before the mean, min and max are taken; median and MAD always use every
+// sample. The 1% floor keeps very tight runs from rejecting normal noise.
+//------------------------------------------------------------
+struct BenchmarkStatistics
+{
+    double median{0.0};
+    double mad{0.0}; // Median absolute deviation, scaled by 1.4826 to estimate sigma
+    double mean{0.0};
+    double min{0.0};
+    double max{0.0};
+    size_t rejected{0};
+
+    static double medianOf(std::vector<double> values)
+    {
+        if (values.empty())
+            return 0.0;
+        const size_t middle = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + middle, values.end());
+        if (values.size() & 1)
+            return values[middle];
+        const double upper = values[middle];
+        return (*std::max_element(values.begin(), values.begin() + middle) + upper) / 2.0;
+    }
+
+    static BenchmarkStatistics compute(const std::vector<double>& samples, double outlierMads = 3.0)
+    {
+        BenchmarkStatistics statistics;
+        if (samples.empty())
+            return statistics;
+
+        statistics.median = medianOf(samples);
+        std::vector<double> deviations;
+        deviations.reserve(samples.size());
+        for (double sample : samples) {
+            deviations.push_back(std::abs(sample - statistics.median));
+        }
+        statistics.mad = medianOf(deviations) * 1.4826;
+
+        const double tolerance = std::max(outlierMads * statistics.mad, std::abs(statistics.median) * 0.01);
+        double sum = 0.0;
+        size_t kept = 0;
+        statistics.min = statistics.median;
+        statistics.max = statistics.median;
+        for (double sample : samples) {
+            if (std::abs(sample - statistics.median) > tolerance) {
+                statistics.rejected++;
+                continue;
+            }
+            sum += sample;
+            kept++;
+            statistics.min = std::min(statistics.min, sample);
+            statistics.max = std::max(statistics.max, sample);
+        }
+        statistics.mean = sum / static_cast<double>(kept);
+        return statistics;
+    }
+};
+
+//------------------------------------------------------------
+// struct BenchmarkResult
+//------------------------------------------------------------
+struct BenchmarkResult
+{
+    std::string name;
+    int threads{1};
+    uint64_t iterations{0};
+    size_t repetitions{0};
+    BenchmarkStatistics nsPerIteration;
+    double itemsPerSecond{0.0};
+    double allocationsPerIteration{0.0};
+    std::map<std::string, double> counters;
+};
+
+//------------------------------------------------------------
+// class BenchmarkDefinition
+//
+// Registered benchmark. Builder methods return *this so they can be
+// chained onto CPPUTILS_BENCHMARK(). Every (arg, thread count) pair
+// is run and reported as its own benchmark.
+//------------------------------------------------------------
+class BenchmarkDefinition
+{
+public:
+    using Function = std::function<void(BenchmarkState&)>;
+
+    BenchmarkDefinition(std::string name, Function function) : name(std::move(name)), function(std::move(function)) {}
+
+    BenchmarkDefinition& setThreads(std::vector<int> counts)
+    {
+        threadCounts = std::move(counts);
+        return *this;
+    }
+
+    // Powers of two from 1 up to std::thread::hardware_concurrency()
+    BenchmarkDefinition& setThreadsUpToHardware()
+    {
+        const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        threadCounts.clear();
+        for (int count = 1; count < maxThreads; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(maxThreads);
+        return *this;
+    }
+
+    BenchmarkDefinition& setArgs(std::vector<int64_t> values)
+    {
+        args = std::move(values);
+        return *this;
+    }
+
+    // Skips calibration and runs exactly `count` iterations per repetition
+    BenchmarkDefinition& setIterations(uint64_t count)
+    {
+        fixedIterations = count;
+        return *this;
+    }
+
+    BenchmarkDefinition& setRepetitions(size_t count)
+    {
+        repetitions = count;
+        return *this;
+    }
+
+    std::string name;
+    Function function;
+    std::vector<int> threadCounts{1};
+    std::vector<int64_t> args;
+    uint64_t fixedIterations{0};
+    size_t repetitions{0};
+};
+
+//------------------------------------------------------------
+// class BenchmarkRunner
+//
+// Runs registered benchmarks: a calibration phase grows the iteration
+// count until one run takes at least minTime, a warm-up phase keeps
+// running at that count for warmupTime, then `repetitions` timed runs
+// are summarized with BenchmarkStatistics. Multi-threaded runs release
+// all threads through a latch and report the mean per-thread time.
+//------------------------------------------------------------
+class BenchmarkRunner
+{
+public:
+    struct Options
+    {
+        std::string filter;
+        std::string jsonPath;
+        size_t repetitions{10};
+        std::chrono::milliseconds minTime{50};
+        std::chrono::milliseconds warmupTime{100};
+        double outlierMads{3.0};
+        bool list{false};
+        // Reports allocsPerIter; needs CPPUTILS_DEFINE_ALLOCATION_HOOKS() in the executable
+        bool trackAllocations{false};
+    };
+
+    static std::vector<std::unique_ptr<BenchmarkDefinition>>& registry()
+    {
+        static std::vector<std::unique_ptr<BenchmarkDefinition>> definitions;
+        return definitions;
+    }
+
+    static BenchmarkDefinition& add(std::string name, BenchmarkDefinition::Function function)
+    {
+        registry().push_back(std::make_unique<BenchmarkDefinition>(std::move(name), std::move(function)));
+        return *registry().back();
+    }
+
+    // Returns false and prints the reason when the arguments are invalid
+    static bool parseArguments(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            const size_t equals = argument.find('=');
+            const std::string key = argument.substr(0, equals);
+            const std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+            if (key == "--filter") {
+                options.filter = value;
+            } else if (key == "--json") {
+                options.jsonPath = value.empty() ? "-" : value;
+            } else if (key == "--repetitions" && !value.empty()) {
+                options.repetitions = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            } else if (key == "--min-time-ms" && !value.empty()) {
+                options.minTime = std::chrono::milliseconds(std::strtoll(value.c_str(), nullptr, 10));
+            } else if (key == "--warmup-ms" && !value.empty()) {
+                options.warmupTime = std::chrono::milliseconds(std::strtoll(value.c_str(), nullptr, 10));
+            } else if (key == "--list") {
+                options.list = true;
+            } else if (key == "--allocations") {
+                options.trackAllocations = true;
+            } else {
+                std::cerr << "ERROR cpputils BenchmarkRunner::parseArguments() unknown argument " << argument << '\n'
+                          << "usage: " << argv[0]
+                          << " [--filter=REGEX] [--json[=PATH]] [--repetitions=N] [--min-time-ms=N]"
+                             " [--warmup-ms=N] [--allocations] [--list]"
+                          << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    explicit BenchmarkRunner(Options options) : options(std::move(options)) {}
+
+    std::vector<BenchmarkResult> run(std::ostream& ostream = std::cout)
+    {
+        std::vector<BenchmarkResult> results;
+
+        std::regex filter;
+        try {
+            filter = std::regex(options.filter.empty() ? ".*" : options.filter);
+        } catch (const std::regex_error& error) {
+            std::cerr << "ERROR cpputils BenchmarkRunner::run() invalid filter " << options.filter << ": "
+                      << error.what() << std::endl;
+            return results;
+        }
+
+        if (!options.list)
+            writeHeader(ostream);
+
+        const bool trackAllocations = options.trackAllocations && AllocationTracker::hooksInstalled();
+        if (options.trackAllocations && !trackAllocations) {
+            std::cerr << "ERROR cpputils BenchmarkRunner::run() --allocations needs CPPUTILS_DEFINE_ALLOCATION_HOOKS()"
+                      << std::endl;
+        }
+        const bool wasTracking = AllocationTracker::isEnabled();
+        AllocationTracker::setEnabled(wasTracking || trackAllocations);
+
+        for (const std::unique_ptr<BenchmarkDefinition>& definition : registry()) {
+            const std::vector<int64_t> args = definition->args.empty() ? std::vector<int64_t>{0} : definition->args;
+            for (int64_t arg : args) {
+                for (int threadCount : definition->threadCounts) {
+                    std::string name = definition->name;
+                    if (!definition->args.empty())
+                        name += "/" + std::to_string(arg);
+                    if (definition->threadCounts.size() > 1 || threadCount > 1)
+                        name += "/threads:" + std::to_string(threadCount);
+
+                    if (!std::regex_search(name, filter))
+                        continue;
+                    if (options.list) {
+                        ostream << name << '\n';
+                        continue;
+                    }
+
+                    results.push_back(runOne(*definition, name, arg, threadCount));
+                    if (trackAllocations)
+                        results.back().counters["allocsPerIter"] = results.back().allocationsPerIteration;
+                    writeResult(ostream, results.back());
+                }
+            }
+        }
+        AllocationTracker::setEnabled(wasTracking);
+        ostream.flush();
+        return results;
+    }
+
+    static void writeJson(std::ostream& ostream, const std::vector<BenchmarkResult>& results)
+    {
+        char date[32] = "";
+        const std::time_t now = std::time(nullptr);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &local);
+
+        ostream << "{\n  \"context\": {\"date\": \"" << date
+                << "\", \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ", \"build\": \""
+#if defined(NDEBUG)
+                << "release"
+#else
+                << "debug"
+#endif
+                << "\"},\n  \"benchmarks\": [";
+
+        const std::streamsize precision = ostream.precision(10);
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& result = results[i];
+            const BenchmarkStatistics& ns = result.nsPerIteration;
+            ostream << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+            writeJsonString(ostream, result.name);
+            ostream << ", \"threads\": " << result.threads << ", \"iterations\": " << result.iterations
+                    << ", \"repetitions\": " << result.repetitions << ", \"rejected\": " << ns.rejected;
+            writeJsonField(ostream, "median_ns", ns.median);
+            writeJsonField(ostream, "mad_ns", ns.mad);
+            writeJsonField(ostream, "mean_ns", ns.mean);
+            writeJsonField(ostream, "min_ns", ns.min);
+            writeJsonField(ostream, "max_ns", ns.max);
+            writeJsonField(ostream, "items_per_second", result.itemsPerSecond);
+            ostream << ", \"counters\": {";
+            bool first = true;
+            for (const auto& [name, value] : result.counters) {
+                ostream << (first ? "" : ", ");
+                writeJsonString(ostream, name);
+                ostream << ": ";
+                writeJsonNumber(ostream, value);
+                first = false;
+            }
+            ostream << "}}";
+        }
+        ostream << "\n  ]\n}\n";
+        ostream.precision(precision);
+        ostream.flush();
+    }
+
+    // Entry point for bench/main.cpp: parses arguments, runs and writes JSON if requested
+    static int main(int argc, char** argv)
+    {
+        Options options;
+        if (!parseArguments(argc, argv, options))
+            return EXIT_FAILURE;
+
+        BenchmarkRunner runner(options);
+        const bool jsonToStdout = options.jsonPath == "-";
+        const std::vector<BenchmarkResult> results = runner.run(jsonToStdout ? std::cerr : std::cout);
+
+        if (options.jsonPath.empty() || options.list)
+            return EXIT_SUCCESS;
+        if (jsonToStdout) {
+            writeJson(std::cout, results);
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream file(options.jsonPath);
+        if (!file) {
+            std::cerr << "ERROR cpputils BenchmarkRunner::main() failed to open " << options.jsonPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        writeJson(file, results);
+        return EXIT_SUCCESS;
+    }
+
+private:
+    struct RunSample
+    {
+        double nsPerIteration{0.0};
+        double maxElapsedNs{0.0};
+        uint64_t allocations{0};
+        uint64_t itemsProcessed{0};
+        std::map<std::string, double> counters;
+    };
+
+    static RunSample runThreads(BenchmarkDefinition& definition, uint64_t iterations, int64_t arg, int threadCount)
+    {
+        std::vector<BenchmarkState> states;
+        states.reserve(threadCount);
+        for (int t = 0; t < threadCount; t++) {
+            states.emplace_back(iterations, arg, t, threadCount);
+        }
+
+        if (threadCount == 1) {
+            definition.function(states[0]);
+        } else {
+            std::latch startLatch(threadCount);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; t++) {
+                threads.emplace_back([&, t]() {
+                    startLatch.arrive_and_wait();
+                    definition.function(states[t]);
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        RunSample sample;
+        double totalNs = 0.0;
+        for (const BenchmarkState& state : states) {
+            totalNs += static_cast<double>(state.getElapsedNs());
+            sample.maxElapsedNs = std::max(sample.maxElapsedNs, static_cast<double>(state.getElapsedNs()));
+            sample.allocations += state.getAllocations();
+            sample.itemsProcessed += state.getItemsProcessed();
+            for (const auto& [name, value] : state.getCounters()) {
+                sample.counters[name] += value;
+            }
+        }
+        sample.nsPerIteration = totalNs / threadCount / static_cast<double>(iterations);
+        return sample;
+    }
+
+    BenchmarkResult runOne(BenchmarkDefinition& definition, const std::string& name, int64_t arg, int threadCount)
+    {
+        const double minTimeNs = static_cast<double>(std::chrono::nanoseconds(options.minTime).count());
+
+        // Calibration: grow the iteration count until one run takes minTime
+        uint64_t iterations = definition.fixedIterations;
+        if (iterations == 0) {
+            iterations = 1;
+            for (;;) {
+                const double elapsedNs = runThreads(definition, iterations, arg, threadCount).maxElapsedNs;
+                if (elapsedNs >= minTimeNs || iterations >= 1'000'000'000'000ull)
+                    break;
+                const double growth = elapsedNs <= 0.0 ? 100.0 : std::clamp(1.4 * minTimeNs / elapsedNs, 2.0, 100.0);
+                iterations = static_cast<uint64_t>(static_cast<double>(iterations) * growth);
+            }
+        }
+
+        // Warm-up: caches, branch predictors, frequency scaling and lazy allocations
+        const ImmutableTimer<std::chrono::steady_clock> warmupTimer;
+        do {
+            runThreads(definition, iterations, arg, threadCount);
+        } while (warmupTimer.getDuration<std::chrono::milliseconds>() < options.warmupTime);
+
+        const size_t repetitions = definition.repetitions != 0 ? definition.repetitions : options.repetitions;
+        std::vector<double> nsSamples;
+        std::vector<double> itemRates;
+        std::vector<double> allocationRates;
+        std::map<std::string, std::vector<double>> counterSamples;
+        for (size_t r = 0; r < repetitions; r++) {
+            RunSample sample = runThreads(definition, iterations, arg, threadCount);
+            nsSamples.push_back(sample.nsPerIteration);
+            allocationRates.push_back(static_cast<double>(sample.allocations)
+                                      / static_cast<double>(iterations * static_cast<uint64_t>(threadCount)));
+            if (sample.itemsProcessed != 0 && sample.maxElapsedNs > 0.0)
+                itemRates.push_back(static_cast<double>(sample.itemsProcessed) / sample.maxElapsedNs * 1e9);
+            for (const auto& [counterName, value] : sample.counters) {
+                counterSamples[counterName].push_back(value);
+            }
+        }
+
+        BenchmarkResult result;
+        result.name = name;
+        result.threads = threadCount;
+        result.iterations = iterations;
+        result.repetitions = repetitions;
+        result.nsPerIteration = BenchmarkStatistics::compute(nsSamples, options.outlierMads);
+        result.itemsPerSecond = BenchmarkStatistics::medianOf(itemRates);
+        result.allocationsPerIteration = BenchmarkStatistics::medianOf(allocationRates);
+        for (const auto& [counterName, values] : counterSamples) {
+            result.counters[counterName] = BenchmarkStatistics::medianOf(values);
+        }
+        return result;
+    }
+
+    static void writeHeader(std::ostream& ostream)
+    {
+        const std::ios_base::fmtflags flags = ostream.flags();
+        ostream << std::left << std::setw(56) << "benchmark" << std::right << std::setw(14) << "iterations"
+                << std::setw(14) << "median ns" << std::setw(10) << "mad %" << std::setw(10) << "rejected"
+                << "  counters\n";
+        ostream.flags(flags);
+    }
+
+    static void writeResult(std::ostream& ostream, const BenchmarkResult& result)
+    {
+        // Leave the caller's stream formatting as it was
+        const std::ios_base::fmtflags flags = ostream.flags();
+        const std::streamsize precision = ostream.precision();
+        const BenchmarkStatistics& ns = result.nsPerIteration;
+        const double madPercent = ns.median > 0.0 ? ns.mad / ns.median * 100.0 : 0.0;
+        ostream << std::left << std::setw(56) << result.name << std::right << std::setw(14) << result.iterations
+                << std::fixed << std::setprecision(2) << std::setw(14) << ns.median << std::setw(10) << madPercent
+                << std::setw(10) << ns.rejected << " ";
+        if (result.itemsPerSecond > 0.0)
+            ostream << " items/s=" << std::setprecision(0) << result.itemsPerSecond;
+        for (const auto& [name, value] : result.counters) {
+            ostream << ' ' << name << '=' << std::setprecision(3) << value;
+        }
+        ostream.flags(flags);
+        ostream.precision(precision);
+        ostream << std::endl;
+    }
+
+    // JSON has no NaN or infinity
+    static void writeJsonNumber(std::ostream& ostream, double value)
+    {
+        if (std::isfinite(value)) {
+            ostream << value;
+        } else {
+            ostream << "null";
+        }
+    }
+
+    static void writeJsonField(std::ostream& ostream, const char* name, double value)
+    {
+        ostream << ", \"" << name << "\": ";
+        writeJsonNumber(ostream, value);
+    }
+
+    static void writeJsonString(std::ostream& ostream, const std::string& text)
+    {
+        ostream << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                ostream << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                ostream << escaped;
+            } else {
+                ostream << c;
+            }
+        }
+        ostream << '"';
+    }
+
+    Options options;
+};
+
+} // namespace cpputils
+
+#define CPPUTILS_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define CPPUTILS_BENCHMARK_CONCAT(a, b) CPPUTILS_BENCHMARK_CONCAT_INNER(a, b)
+
+// Registers a benchmark function (void(cpputils::BenchmarkState&)) under its
+// own spelling. Builder calls can be chained:
+//     CPPUTILS_BENCHMARK(pushPop<1024>).setThreads({1, 2, 4});
+#define CPPUTILS_BENCHMARK(...)                                                                                        \
+    [[maybe_unused]] static ::cpputils::BenchmarkDefinition&                                                           \
+        CPPUTILS_BENCHMARK_CONCAT(cpputilsBenchmark, __LINE__)                                                         \
+        = ::cpputils::BenchmarkRunner::add(#__VA_ARGS__, __VA_ARGS__)
+
+#endif // End CPPUTILS_BENCHMARK_H
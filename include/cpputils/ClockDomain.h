@@ -0,0 +1,208 @@
+#ifndef CPPUTILS_CLOCK_DOMAIN_H
+#define CPPUTILS_CLOCK_DOMAIN_H
+
+#include "cpputils/Clocks.h"
+#include "cpputils/Seqlock.h"
+#include "cpputils/SharedMemory.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// struct ClockCalibration
+//
+// Maps raw counter ticks onto a common nanosecond timeline:
+//   ns = baseNs + (ticks - baseTicks) * nsPerTick
+// baseNs is in steady_clock's epoch (CLOCK_MONOTONIC / QPC), which every
+// process on the machine shares; systemOffsetNs converts it to
+// system_clock time for display. Without an invariant TSC the ticks are
+// steady_clock nanoseconds and the mapping is the identity.
+//------------------------------------------------------------
+struct ClockCalibration
+{
+    uint64_t generation{0}; // 0 = never published, +1 per recalibration
+    bool useTsc{false};
+    uint64_t baseTicks{0};
+    int64_t baseNs{0};
+    uint64_t nsPerTickFixed{0}; // 32.32 fixed point
+    double ticksPerSecond{0.0};
+    int64_t systemOffsetNs{0}; // system_clock - steady_clock at calibration
+
+    int64_t toNs(uint64_t ticks) const
+    {
+        if (!useTsc)
+            return static_cast<int64_t>(ticks);
+
+        // Signed so stamps taken shortly before a recalibration still convert
+        const int64_t deltaTicks = static_cast<int64_t>(ticks - baseTicks);
+        const uint64_t magnitude
+            = deltaTicks < 0 ? 0 - static_cast<uint64_t>(deltaTicks) : static_cast<uint64_t>(deltaTicks);
+#if defined(__SIZEOF_INT128__)
+        const int64_t deltaNs
+            = static_cast<int64_t>((static_cast<unsigned __int128>(magnitude) * nsPerTickFixed) >> 32);
+#else
+        const int64_t deltaNs = static_cast<int64_t>(static_cast<double>(magnitude)
+                                                     * static_cast<double>(nsPerTickFixed) / 4294967296.0);
+#endif
+        return deltaTicks < 0 ? baseNs - deltaNs : baseNs + deltaNs;
+    }
+};
+
+//------------------------------------------------------------
+// class ClockDomain
+//
+// A timeline shared by cooperating processes. TscClock time points are
+// only comparable within one process, because each process calibrates
+// the counter on its own. A ClockDomain keeps one calibration record in
+// a SharedMemory segment: the first process to attach calibrates and
+// publishes it, the others adopt it. Every process then stamps with
+// readTicks() (a bare rdtsc, no syscall) and converts with toNs(),
+// which gives the same answer for the same instant in every process, so
+// their traces can be merged.
+//
+// recalibrate() re-measures the tick rate and republishes the record
+// continuously (no jump at the switch). The record is a
+// MultiWriterSeqlock: readers never block and retry only if they overlap
+// an update, and any process may recalibrate.
+//------------------------------------------------------------
+class ClockDomain
+{
+public:
+    explicit ClockDomain(const std::string& key,
+                         std::chrono::nanoseconds calibrationTime = std::chrono::milliseconds(20)) :
+        memory(key, sizeof(SharedRecord))
+    {
+        if (!memory.valid())
+            return;
+
+        record = static_cast<SharedRecord*>(memory.data());
+        if (read().generation == 0) {
+            // Measured outside the write side so a crash here cannot wedge other processes
+            const ClockCalibration measured = measure(calibrationTime);
+            publish([&measured](const ClockCalibration& current) {
+                // Lost the race to another process: keep its record
+                return current.generation != 0 ? current : measured;
+            });
+        }
+        useTsc = read().useTsc;
+    }
+
+    ClockDomain(const ClockDomain& other) = delete;
+    ClockDomain& operator=(const ClockDomain& other) = delete;
+
+    bool valid() const { return record != nullptr; }
+
+    // Raw stamp in the domain's tick units; convert later with toNs()
+    uint64_t readTicks() const
+    {
+        if (useTsc) [[likely]]
+            return TscClock::readTicks();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    // Domain time in nanoseconds, in steady_clock's epoch
+    int64_t toNs(uint64_t ticks) const { return read().toNs(ticks); }
+
+    int64_t nowNs() const { return toNs(readTicks()); }
+
+    std::chrono::steady_clock::time_point toSteadyTime(uint64_t ticks) const
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(toNs(ticks))));
+    }
+
+    std::chrono::system_clock::time_point toSystemTime(uint64_t ticks) const
+    {
+        const ClockCalibration calibration = read();
+        return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(calibration.toNs(ticks) + calibration.systemOffsetNs)));
+    }
+
+    // Consistent copy of the published record
+    ClockCalibration read() const
+    {
+        if (record == nullptr)
+            return ClockCalibration();
+        return record->load();
+    }
+
+    // Re-measures the tick rate over `calibrationTime` and publishes it.
+    // Domain time stays continuous: the new record starts where the old one is now.
+    void recalibrate(std::chrono::nanoseconds calibrationTime = std::chrono::milliseconds(20))
+    {
+        if (record == nullptr)
+            return;
+
+        const ClockCalibration measured = measure(calibrationTime);
+        publish([&measured](const ClockCalibration& current) {
+            ClockCalibration next = measured;
+            if (current.generation != 0 && current.useTsc == measured.useTsc)
+                next.baseNs = current.toNs(measured.baseTicks);
+            next.generation = current.generation + 1;
+            return next;
+        });
+    }
+
+private:
+    // The zero-filled segment reads as generation 0: not yet published
+    using SharedRecord = MultiWriterSeqlock<ClockCalibration>;
+
+    template<typename UpdateFunc>
+    void publish(UpdateFunc&& update)
+    {
+        record->update([&update](const ClockCalibration& current) {
+            ClockCalibration next = update(current);
+            if (next.generation == 0)
+                next.generation = 1;
+            return next;
+        });
+    }
+
+    // Measures ticks against steady_clock; the result is based at the end of the window
+    static ClockCalibration measure(std::chrono::nanoseconds calibrationTime)
+    {
+        using steady = std::chrono::steady_clock;
+        ClockCalibration result;
+        result.systemOffsetNs
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+                  .count()
+              - std::chrono::duration_cast<std::chrono::nanoseconds>(steady::now().time_since_epoch()).count();
+        if (!TscClock::isTscInvariant())
+            return result;
+
+        const steady::time_point steadyStart = steady::now();
+        const uint64_t ticksStart = TscClock::readTicks();
+        steady::time_point steadyEnd = steadyStart;
+        while (steadyEnd - steadyStart < calibrationTime) {
+            steadyEnd = steady::now();
+        }
+        const uint64_t ticksEnd = TscClock::readTicks();
+
+        const double elapsedNs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(steadyEnd - steadyStart).count());
+        const double ticks = static_cast<double>(ticksEnd - ticksStart);
+        if (ticks <= 0.0 || elapsedNs <= 0.0)
+            return result;
+
+        result.useTsc = true;
+        result.baseTicks = ticksEnd;
+        result.baseNs = std::chrono::duration_cast<std::chrono::nanoseconds>(steadyEnd.time_since_epoch()).count();
+        result.nsPerTickFixed = static_cast<uint64_t>(elapsedNs / ticks * 4294967296.0);
+        result.ticksPerSecond = ticks / elapsedNs * 1e9;
+        return result;
+    }
+
+    SharedMemory memory;
+    SharedRecord* record{nullptr};
+    bool useTsc{false};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_CLOCK_DOMAIN_H
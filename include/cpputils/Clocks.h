@@ -0,0 +1,291 @@
+#ifndef CPPUTILS_CLOCKS_H
+#define CPPUTILS_CLOCKS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define CPPUTILS_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <cpuid.h>
+    #include <x86intrin.h>
+    #define CPPUTILS_HAS_TSC 1
+#else
+    #define CPPUTILS_HAS_TSC 0
+#endif
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <time.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class TscClock
+//
+// Clock backed by the CPU timestamp counter. now() is a rdtsc and a
+// fixed-point multiply (~6-10ns) instead of a vDSO call. The tick rate
+// is calibrated against std::chrono::steady_clock on first use (~10ms),
+// and time points share steady_clock's epoch at that moment.
+//
+// When the CPU does not advertise an invariant TSC (constant rate across
+// P-states, not halted in C-states), or the target is not x86, now()
+// falls back to steady_clock. isTscInvariant() reports which path is in use.
+//------------------------------------------------------------
+class TscClock
+{
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<TscClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        const Calibration& c = calibration();
+        if (c.useTsc) [[likely]]
+            return time_point(duration(c.baseNs + ticksToNs(c, readTicks() - c.baseTicks)));
+
+        return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+    }
+
+    // Raw counter value. Not ordered against surrounding loads/stores.
+    static uint64_t readTicks() noexcept
+    {
+#if CPPUTILS_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // rdtscp: waits for all prior instructions to finish before reading.
+    // Use this for the closing stamp of a measured region.
+    static uint64_t readTicksSerialized() noexcept
+    {
+#if CPPUTILS_HAS_TSC
+        unsigned int aux;
+        return __rdtscp(&aux);
+#else
+        return readTicks();
+#endif
+    }
+
+    static bool isTscInvariant() { return calibration().useTsc; }
+
+    static double getTicksPerSecond() { return calibration().ticksPerSecond; }
+
+    // Converts a difference of readTicks() values to nanoseconds
+    static int64_t ticksToNs(uint64_t ticks) { return ticksToNs(calibration(), ticks); }
+
+private:
+    struct Calibration
+    {
+        bool useTsc{false};
+        uint64_t baseTicks{0};
+        int64_t baseNs{0};
+        uint64_t nsPerTickFixed{0}; // ns per tick, 32.32 fixed point
+        double ticksPerSecond{0.0};
+    };
+
+    static int64_t ticksToNs(const Calibration& c, uint64_t ticks) noexcept
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        uint64_t high;
+        const uint64_t low = _umul128(ticks, c.nsPerTickFixed, &high);
+        return static_cast<int64_t>((high << 32) | (low >> 32));
+#elif defined(__SIZEOF_INT128__)
+        return static_cast<int64_t>((static_cast<unsigned __int128>(ticks) * c.nsPerTickFixed) >> 32);
+#else
+        return static_cast<int64_t>(static_cast<double>(ticks) * static_cast<double>(c.nsPerTickFixed) / 4294967296.0);
+#endif
+    }
+
+    static bool cpuHasInvariantTsc()
+    {
+#if CPPUTILS_HAS_TSC && defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 0x80000000);
+        if (static_cast<unsigned int>(regs[0]) < 0x80000007)
+            return false;
+        __cpuid(regs, 0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#elif CPPUTILS_HAS_TSC
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+            return false;
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    static const Calibration& calibration()
+    {
+        static const Calibration c = []() {
+            Calibration result;
+            if (!cpuHasInvariantTsc())
+                return result;
+
+            using steady = std::chrono::steady_clock;
+            const steady::time_point steadyStart = steady::now();
+            const uint64_t ticksStart = readTicks();
+
+            steady::time_point steadyEnd = steadyStart;
+            while (steadyEnd - steadyStart < std::chrono::milliseconds(10)) {
+                steadyEnd = steady::now();
+            }
+            const uint64_t ticksEnd = readTicks();
+
+            const double elapsedNs = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(steadyEnd - steadyStart).count());
+            const double ticks = static_cast<double>(ticksEnd - ticksStart);
+            if (ticks <= 0.0)
+                return result;
+
+            result.useTsc = true;
+            result.baseTicks = ticksStart;
+            result.baseNs = std::chrono::duration_cast<std::chrono::nanoseconds>(steadyStart.time_since_epoch()).count();
+            result.nsPerTickFixed = static_cast<uint64_t>(elapsedNs / ticks * 4294967296.0);
+            result.ticksPerSecond = ticks / elapsedNs * 1e9;
+            return result;
+        }();
+        return c;
+    }
+};
+
+//------------------------------------------------------------
+// class CoarseClock
+//
+// Cheap clock for code that only needs millisecond-ish resolution, e.g.
+// timeouts and rate limiting. Reads the tick the kernel already keeps
+// (CLOCK_MONOTONIC_COARSE on Linux, GetTickCount64() on Windows) instead
+// of reading the hardware clock source. Resolution is the scheduler tick
+// (1-4ms on Linux, ~15.6ms on Windows); see getResolution().
+//------------------------------------------------------------
+class CoarseClock
+{
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<CoarseClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+#if defined(_WIN32)
+        return time_point(std::chrono::milliseconds(GetTickCount64()));
+#elif defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return time_point(duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec));
+#else
+        return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+    }
+
+    static duration getResolution()
+    {
+#if defined(_WIN32)
+        DWORD adjustment, increment;
+        BOOL disabled;
+        if (GetSystemTimeAdjustment(&adjustment, &increment, &disabled))
+            return duration(static_cast<int64_t>(increment) * 100);
+        return std::chrono::milliseconds(16);
+#elif defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+        timespec ts;
+        clock_getres(CLOCK_MONOTONIC_COARSE, &ts);
+        return duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec);
+#else
+        return duration(1);
+#endif
+    }
+};
+
+//------------------------------------------------------------
+// class ThreadCpuClock
+//
+// CPU time consumed by the calling thread (user + system), from
+// CLOCK_THREAD_CPUTIME_ID on Linux and GetThreadTimes() on Windows
+// (100ns granularity). It stops while the thread is blocked or
+// descheduled, so wall time minus thread CPU time over a region is the
+// time spent off-CPU. Time points from different threads are unrelated.
+//------------------------------------------------------------
+class ThreadCpuClock
+{
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ThreadCpuClock>;
+    static constexpr bool is_steady = false;
+
+    static time_point now() noexcept
+    {
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return time_point();
+        return time_point(duration((fileTimeTicks(kernel) + fileTimeTicks(user)) * 100));
+#elif defined(__linux__)
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return time_point(duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec));
+#else
+        return time_point();
+#endif
+    }
+
+#if defined(_WIN32)
+    static int64_t fileTimeTicks(const FILETIME& fileTime)
+    {
+        return static_cast<int64_t>((static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime);
+    }
+#endif
+};
+
+//------------------------------------------------------------
+// class ProcessCpuClock
+//
+// CPU time consumed by all threads of the process (user + system), from
+// CLOCK_PROCESS_CPUTIME_ID on Linux and GetProcessTimes() on Windows.
+// Over a region it can exceed wall time when several threads run.
+//------------------------------------------------------------
+class ProcessCpuClock
+{
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ProcessCpuClock>;
+    static constexpr bool is_steady = false;
+
+    static time_point now() noexcept
+    {
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return time_point();
+        return time_point(
+            duration((ThreadCpuClock::fileTimeTicks(kernel) + ThreadCpuClock::fileTimeTicks(user)) * 100));
+#elif defined(__linux__)
+        timespec ts;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return time_point(duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec));
+#else
+        return time_point();
+#endif
+    }
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_CLOCKS_H
@@ -0,0 +1,33 @@
+#ifndef CPPUTILS_CPU_RELAX_H
+#define CPPUTILS_CPU_RELAX_H
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// cpuRelax()
+//
+// Spin-wait hint. Lets the sibling hyperthread run and avoids the
+// memory-order mis-speculation penalty when a spin loop exits.
+//------------------------------------------------------------
+inline void cpuRelax()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_CPU_RELAX_H
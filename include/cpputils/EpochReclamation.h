@@ -0,0 +1,342 @@
+#ifndef CPPUTILS_EPOCH_RECLAMATION_H
+#define CPPUTILS_EPOCH_RECLAMATION_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/AsymmetricBarrier.h"
+#include "cpputils/PerThread.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class EpochDomain
+//
+// Safe memory reclamation for lock-free structures. A node unlinked
+// from a shared structure may still be in use by readers that loaded
+// it earlier, so it is retire()d instead of deleted, and freed once
+// every reader that could have seen it has moved on.
+//
+// Readers wrap each traversal in an EpochGuard. Entering announces the
+// global epoch in the thread's own record with a plain store and an
+// asymmetricLightBarrier(): no atomic read-modify-write and no shared
+// cache line written per access. The epoch advances only when every
+// reader inside a guard has announced the current epoch; the reclaimer
+// pays for that check with an asymmetricHeavyBarrier() once per batch
+// of retires. A node retired in epoch e is freed once the epoch reaches
+// e + 2: every guard that was open when it was unlinked has closed.
+//
+// A guard held for a long time stalls reclamation for every thread.
+// For references kept across blocking calls use a HazardPointer, which
+// pins one node instead of the whole epoch.
+//
+// Retired nodes of a thread that exits stay pending until another
+// thread calls synchronize() or the domain is destroyed.
+//------------------------------------------------------------
+class EpochDomain
+{
+public:
+    explicit EpochDomain(size_t retireBatch = 64) : retireBatch(std::max<size_t>(retireBatch, 1)) {}
+
+    EpochDomain(const EpochDomain& other) = delete;
+    EpochDomain& operator=(const EpochDomain& other) = delete;
+
+    // No guard or hazard pointer may be live; frees everything still pending
+    ~EpochDomain()
+    {
+        records.forEach([](ThreadRecord& record) {
+            for (const Retired& retired : record.retired) {
+                retired.deleter(retired.pointer);
+            }
+            record.retired.clear();
+        });
+    }
+
+    // Defers `delete object` until no reader can still hold it. The object
+    // must already be unlinked from every shared structure.
+    template<typename T>
+    void retire(T* object)
+    {
+        retire(static_cast<void*>(object), [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+
+    void retire(void* pointer, void (*deleter)(void*))
+    {
+        if (pointer == nullptr)
+            return;
+
+        ThreadRecord& record = records.local();
+        size_t pending = 0;
+        {
+            std::lock_guard<std::mutex> lock(record.retiredMutex);
+            record.retired.push_back({pointer, deleter, globalEpoch.load(std::memory_order_acquire)});
+            pending = record.retired.size();
+        }
+        if (pending >= std::max(record.nextReclaimAt, retireBatch)) {
+            reclaim();
+            std::lock_guard<std::mutex> lock(record.retiredMutex);
+            // Nodes pinned by a slow reader stay; wait for a full batch of new ones
+            record.nextReclaimAt = record.retired.size() + retireBatch;
+        }
+    }
+
+    // Tries to advance the epoch and frees the calling thread's retired nodes
+    // that are now safe. Returns how many were freed.
+    size_t reclaim()
+    {
+        ThreadRecord& record = records.local();
+        const std::vector<void*> hazards = scan();
+        return freeSafe(record, globalEpoch.load(std::memory_order_acquire), hazards);
+    }
+
+    // Blocks until every node retired so far, by any thread, is freed, except
+    // those still held by a HazardPointer. Must not be called inside a guard.
+    void synchronize()
+    {
+        if (records.local().nesting != 0) {
+            std::cerr << "ERROR cpputils EpochDomain::synchronize() called inside an EpochGuard" << std::endl;
+            return;
+        }
+
+        const uint64_t target = globalEpoch.load(std::memory_order_acquire) + 2;
+        std::vector<void*> hazards = scan();
+        while (globalEpoch.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+            hazards = scan();
+        }
+
+        // Collected first: deleters may retire() and must not run under the registry lock
+        std::vector<ThreadRecord*> all;
+        records.forEach([&all](ThreadRecord& record) { all.push_back(&record); });
+        const uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+        for (ThreadRecord* record : all) {
+            freeSafe(*record, epoch, hazards);
+        }
+    }
+
+    uint64_t getEpoch() const { return globalEpoch.load(std::memory_order_relaxed); }
+
+    // Retired nodes not yet freed, over all threads
+    size_t getPendingCount()
+    {
+        size_t pending = 0;
+        records.forEach([&pending](ThreadRecord& record) {
+            std::lock_guard<std::mutex> lock(record.retiredMutex);
+            pending += record.retired.size();
+        });
+        return pending;
+    }
+
+private:
+    friend class EpochGuard;
+    friend class HazardPointer;
+
+    static constexpr size_t HAZARD_SLOTS = 8;
+    static constexpr uint64_t ACTIVE = 1; // Announcement is (epoch << 1) | ACTIVE, 0 when outside guards
+
+    struct Retired
+    {
+        void* pointer;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    struct ThreadRecord
+    {
+        // Written by the owner on every guard, read by reclaimers
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> announced{0};
+        std::array<std::atomic<void*>, HAZARD_SLOTS> hazards{};
+
+        // Owner only
+        alignas(CACHE_LINE_SIZE) uint32_t nesting{0};
+        uint32_t usedHazards{0};
+        size_t nextReclaimAt{0};
+
+        std::mutex retiredMutex;
+        std::vector<Retired> retired;
+    };
+
+    ThreadRecord& enter()
+    {
+        ThreadRecord& record = records.local();
+        if (record.nesting++ == 0) {
+            record.announced.store((globalEpoch.load(std::memory_order_relaxed) << 1) | ACTIVE,
+                                   std::memory_order_relaxed);
+            // Pairs with the heavy barrier in scan(): either the reclaimer sees this
+            // announcement, or this thread's loads see the reclaimer's unlink
+            asymmetricLightBarrier();
+        }
+        return record;
+    }
+
+    void exit(ThreadRecord& record)
+    {
+        if (--record.nesting == 0)
+            record.announced.store(0, std::memory_order_release);
+    }
+
+    // Advances the epoch if every active reader has announced the current one,
+    // and returns the sorted set of hazard pointers
+    std::vector<void*> scan()
+    {
+        asymmetricHeavyBarrier();
+
+        uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+        bool caughtUp = true;
+        std::vector<void*> hazards;
+        records.forEach([&](ThreadRecord& record) {
+            // Announcement first: a guard's exit publishes the hazards set inside it
+            const uint64_t announced = record.announced.load(std::memory_order_acquire);
+            if ((announced & ACTIVE) && (announced >> 1) != epoch)
+                caughtUp = false;
+            for (std::atomic<void*>& hazard : record.hazards) {
+                void* pointer = hazard.load(std::memory_order_acquire);
+                if (pointer != nullptr)
+                    hazards.push_back(pointer);
+            }
+        });
+        if (caughtUp)
+            globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+
+        std::sort(hazards.begin(), hazards.end());
+        return hazards;
+    }
+
+    // Frees the record's nodes retired at least two epochs ago and not hazarded.
+    // Deleters run outside the lock, as they may retire() in turn.
+    static size_t freeSafe(ThreadRecord& record, uint64_t epoch, const std::vector<void*>& hazards)
+    {
+        std::vector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> lock(record.retiredMutex);
+            std::vector<Retired>& retired = record.retired;
+            const auto firstPending = std::stable_partition(retired.begin(), retired.end(), [&](const Retired& r) {
+                return r.epoch + 2 <= epoch && !std::binary_search(hazards.begin(), hazards.end(), r.pointer);
+            });
+            ready.assign(retired.begin(), firstPending);
+            retired.erase(retired.begin(), firstPending);
+        }
+        for (const Retired& retired : ready) {
+            retired.deleter(retired.pointer);
+        }
+        return ready.size();
+    }
+
+    const size_t retireBatch;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> globalEpoch{1};
+    PerThread<ThreadRecord> records;
+};
+
+//------------------------------------------------------------
+// class EpochGuard
+//
+// Read-side critical section: nodes loaded from the domain's structures
+// stay valid until the guard is destroyed. Guards nest and are cheap;
+// keep them short, since an open guard holds back every retire().
+//------------------------------------------------------------
+class EpochGuard
+{
+public:
+    explicit EpochGuard(EpochDomain& domain) : domain(domain), record(domain.enter()) {}
+
+    EpochGuard(const EpochGuard& other) = delete;
+    EpochGuard& operator=(const EpochGuard& other) = delete;
+
+    ~EpochGuard() { domain.exit(record); }
+
+private:
+    EpochDomain& domain;
+    EpochDomain::ThreadRecord& record;
+};
+
+//------------------------------------------------------------
+// class HazardPointer
+//
+// Keeps a single node alive without holding back the epoch, for
+// references held across blocking calls. protect() publishes the
+// pointer in one of the thread's hazard slots; a retired node is not
+// freed while any slot holds it. Each thread has 8 slots; beyond that
+// a HazardPointer falls back to holding an EpochGuard for its lifetime,
+// which is still safe but stalls reclamation.
+//
+// Must be used and destroyed on the thread that created it.
+//------------------------------------------------------------
+class HazardPointer
+{
+public:
+    explicit HazardPointer(EpochDomain& domain) : domain(domain), record(domain.records.local())
+    {
+        for (size_t i = 0; i < EpochDomain::HAZARD_SLOTS; i++) {
+            if ((record.usedHazards & (1u << i)) == 0) {
+                record.usedHazards |= 1u << i;
+                slot = &record.hazards[i];
+                return;
+            }
+        }
+        domain.enter();
+    }
+
+    HazardPointer(const HazardPointer& other) = delete;
+    HazardPointer& operator=(const HazardPointer& other) = delete;
+
+    ~HazardPointer()
+    {
+        if (slot == nullptr) {
+            domain.exit(record);
+            return;
+        }
+        slot->store(nullptr, std::memory_order_release);
+        record.usedHazards &= ~(1u << (slot - record.hazards.data()));
+    }
+
+    // Loads `source` and keeps the node alive until reset() or the next protect()
+    template<typename T>
+    T* protect(const std::atomic<T*>& source)
+    {
+        T* pointer = source.load(std::memory_order_acquire);
+        if (slot == nullptr)
+            return pointer;
+
+        for (;;) {
+            slot->store(pointer, std::memory_order_relaxed);
+            asymmetricLightBarrier();
+            // Still reachable after the slot is visible: no reclaimer can miss it
+            T* current = source.load(std::memory_order_acquire);
+            if (current == pointer)
+                return pointer;
+            pointer = current;
+        }
+    }
+
+    // Protects a node already kept alive another way, e.g. loaded inside an EpochGuard
+    template<typename T>
+    void set(T* pointer)
+    {
+        if (slot != nullptr)
+            slot->store(pointer, std::memory_order_release);
+    }
+
+    void reset()
+    {
+        if (slot != nullptr)
+            slot->store(nullptr, std::memory_order_release);
+    }
+
+private:
+    EpochDomain& domain;
+    EpochDomain::ThreadRecord& record;
+    std::atomic<void*>* slot{nullptr};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_EPOCH_RECLAMATION_H
@@ -0,0 +1,98 @@
+#ifndef CPPUTILS_EVENT_COUNT_H
+#define CPPUTILS_EVENT_COUNT_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/AsymmetricBarrier.h"
+#include "cpputils/CpuRelax.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class EventCount
+//
+// Lets threads sleep until a condition on some other lock-free state
+// becomes true, without the state's fast path paying for it. A waiter
+// calls await(condition): it spins a little, then registers, re-checks
+// and parks on std::atomic::wait (a futex on Linux, WaitOnAddress on
+// Windows). Whoever changes the state calls notify() afterwards.
+//
+// notify() is a plain load behind an asymmetricLightBarrier() when no
+// one sleeps; the thread about to sleep pays for the matching heavy
+// barrier. Wakers claim the registrations they notify, so a burst of
+// notify() calls wakes a sleeper once, not once per call while it is
+// still getting scheduled.
+//------------------------------------------------------------
+class EventCount
+{
+public:
+    static constexpr int DEFAULT_SPIN_LIMIT = 128;
+
+    // Returns once condition() is true; condition() may have side effects
+    // (e.g. a try-pop) and is not called again after it succeeds
+    template<typename Condition>
+    void await(Condition&& condition, int spinLimit = DEFAULT_SPIN_LIMIT)
+    {
+        for (int spin = 0; spin < spinLimit; spin++) {
+            if (condition())
+                return;
+            cpuRelax();
+        }
+        for (;;) {
+            const uint32_t key = events.load(std::memory_order_acquire);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            // Pairs with the light barrier in notify(): either the notifier sees
+            // us registered, or the re-check below sees its change
+            asymmetricHeavyBarrier();
+            if (condition()) {
+                // Withdraw. If a waker already claimed us, this takes another
+                // sleeper's registration instead; that sleeper was just notified.
+                claimSleepers(1);
+                return;
+            }
+            events.wait(key, std::memory_order_acquire);
+        }
+    }
+
+    // Wakes up to `count` sleepers; call after making a condition true
+    void notify(uint32_t count = 1)
+    {
+        asymmetricLightBarrier();
+        if (sleepers.load(std::memory_order_relaxed) == 0) [[likely]]
+            return;
+
+        const uint32_t claimed = claimSleepers(count);
+        if (claimed == 0)
+            return;
+        events.fetch_add(1, std::memory_order_release);
+        if (claimed == 1)
+            events.notify_one();
+        else
+            events.notify_all();
+    }
+
+    void notifyAll() { notify(UINT32_MAX); }
+
+private:
+    // Takes up to `count` registrations; returns how many it took
+    uint32_t claimSleepers(uint32_t count)
+    {
+        uint32_t registered = sleepers.load(std::memory_order_relaxed);
+        while (registered != 0) {
+            const uint32_t claimed = std::min(registered, count);
+            if (sleepers.compare_exchange_weak(registered, registered - claimed, std::memory_order_relaxed))
+                return claimed;
+        }
+        return 0;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> events{0};
+    std::atomic<uint32_t> sleepers{0}; // Registered and not yet claimed by a waker
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_EVENT_COUNT_H
@@ -0,0 +1,585 @@
+#ifndef CPPUTILS_FLIGHT_RECORDER_H
+#define CPPUTILS_FLIGHT_RECORDER_H
+
+#include "cpputils/MappedFile.h"
+#include "cpputils/PerThread.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace cpputils {
+
+enum class FlightEventType : uint32_t
+{
+    SCOPE,   // timestamp = scope start, value = duration in ns
+    COUNTER, // value = double bits
+    MARKER,  // value = user payload
+};
+
+//------------------------------------------------------------
+// Flight recorder file format (version 1, native byte order)
+//
+//   FlightFileHeader
+//   FlightName[nameCapacity]
+//   threadCapacity x { FlightThreadHeader, FlightEvent[eventsPerThread] }
+//
+// The file starts zero-filled, and zeros mean "empty" everywhere after
+// the header. Every record publishes itself with a final release store
+// (a name's length, an event's sequence), so a reader of a crashed
+// process' file, or of a live one, skips anything only partly written.
+//------------------------------------------------------------
+namespace flight {
+
+inline constexpr char MAGIC[8] = {'C', 'P', 'U', 'F', 'L', 'T', 'R', '\0'};
+inline constexpr uint32_t VERSION = 1;
+inline constexpr size_t NAME_BYTES = 60;
+inline constexpr size_t THREAD_NAME_BYTES = 44;
+
+struct alignas(64) FlightFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;
+    uint64_t fileBytes;
+    uint64_t processId;
+    uint32_t nameCapacity;
+    uint32_t threadCapacity;
+    uint64_t eventsPerThread;
+    uint64_t namesOffset;
+    uint64_t threadsOffset;
+    uint64_t threadStride;
+    int64_t clockOriginNs;  // Recorder clock at open...
+    int64_t systemOriginNs; // ...and system_clock at the same moment
+    std::atomic<uint32_t> threadCount;
+    std::atomic<uint32_t> nameCount;
+    std::atomic<uint64_t> droppedEvents; // Recorded by threads beyond threadCapacity
+};
+
+struct FlightName
+{
+    std::atomic<uint32_t> length; // Published last
+    char text[NAME_BYTES];
+};
+
+struct alignas(64) FlightThreadHeader
+{
+    std::atomic<uint64_t> head; // Events ever written by the thread
+    std::atomic<uint64_t> threadId;
+    std::atomic<uint32_t> nameLength;
+    char name[THREAD_NAME_BYTES];
+};
+
+struct FlightEvent
+{
+    std::atomic<uint64_t> sequence; // Ring index + 1 once complete, 0 while being written
+    std::atomic<int64_t> timestampNs;
+    std::atomic<uint64_t> value;
+    std::atomic<uint32_t> nameId;
+    std::atomic<FlightEventType> type;
+};
+
+static_assert(sizeof(FlightName) == 64);
+static_assert(sizeof(FlightThreadHeader) == 64);
+static_assert(sizeof(FlightEvent) == 32);
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+
+inline uint64_t currentThreadId()
+{
+#if defined(_WIN32)
+    return GetCurrentThreadId();
+#elif defined(__linux__)
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    return std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+}
+
+inline uint64_t processId()
+{
+#if defined(_WIN32)
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+} // namespace flight
+
+//------------------------------------------------------------
+// class FlightRecorder
+//
+// Always-on black box: every thread appends fixed-size timestamped events
+// (scopes, counters, markers) to its own ring inside a memory-mapped file.
+// The mapping is shared with the page cache, so when the process dies,
+// however it dies, the kernel still writes the last eventsPerThread
+// events of each thread to disk. cpputils_flightdump (src/flightdump)
+// prints them.
+//
+// Recording is lock-free and never allocates: a PerThread lookup, a clock
+// read and a handful of relaxed stores into the ring, the same cost as a
+// Tracer event (see FlightRecorder.bench.cpp). The first event of a
+// thread claims the next free ring; threads beyond threadCapacity are not
+// recorded and only counted. Event names are registered once, outside the
+// hot path, and referred to by id.
+//
+// Rings are found through PerThread, keyed by std::thread::id, and are
+// never released. A thread that is handed the recycled id of an exited
+// thread appends to that thread's ring, and its events are reported under
+// the exited thread's OS thread id and name. Record from long-lived
+// threads (e.g. a pool) rather than one thread per task.
+//
+// The file is recreated on open, so give each run its own path (e.g.
+// with the pid) or copy the file off before restarting a crashed process.
+// Destroy the recorder only after its recording threads are done.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class FlightRecorder
+{
+public:
+    explicit FlightRecorder(const std::string& path,
+                            size_t eventsPerThread = 8192,
+                            size_t threadCapacity = 32,
+                            size_t nameCapacity = 1024) :
+        file(path, MappedFileMode::CREATE,
+             fileBytes(roundUpToPowerOfTwo(eventsPerThread), threadCapacity, nameCapacity)),
+        rings([this]() { return std::make_unique<ThreadRing>(claimRing()); })
+    {
+        if (!file.valid())
+            return;
+
+        // Touch every page now rather than on the first event that lands on it
+        const long pageSize = pageBytes();
+        unsigned char* bytes = static_cast<unsigned char*>(file.data());
+        for (size_t offset = 0; offset < file.size(); offset += static_cast<size_t>(pageSize)) {
+            bytes[offset] = 0;
+        }
+
+        header = static_cast<flight::FlightFileHeader*>(file.data());
+        header->version = flight::VERSION;
+        header->headerBytes = sizeof(flight::FlightFileHeader);
+        header->fileBytes = file.size();
+        header->processId = flight::processId();
+        header->nameCapacity = static_cast<uint32_t>(nameCapacity);
+        header->threadCapacity = static_cast<uint32_t>(threadCapacity);
+        header->eventsPerThread = roundUpToPowerOfTwo(eventsPerThread);
+        header->namesOffset = sizeof(flight::FlightFileHeader);
+        header->threadsOffset = header->namesOffset + nameCapacity * sizeof(flight::FlightName);
+        header->threadStride = threadStride(header->eventsPerThread);
+        header->clockOriginNs = toNs(clockType::now());
+        header->systemOriginNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count();
+        // Magic last: a file cut short during setup is not mistaken for a recording
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header->magic, flight::MAGIC, sizeof(flight::MAGIC));
+    }
+
+    FlightRecorder(const FlightRecorder& other) = delete;
+    FlightRecorder& operator=(const FlightRecorder& other) = delete;
+
+    bool valid() const { return header != nullptr; }
+
+    const std::string& getPath() const { return file.getPath(); }
+
+    // Returns the id of `name`, registering it on first use. Takes a lock;
+    // keep the id (e.g. in a static) rather than calling this per event.
+    uint32_t registerName(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(namesMutex);
+        const auto [it, inserted] = nameIds.try_emplace(std::string(name), static_cast<uint32_t>(nameIds.size()));
+        if (!inserted || header == nullptr)
+            return it->second;
+
+        const uint32_t id = it->second;
+        if (id >= header->nameCapacity) {
+            if (id == header->nameCapacity) {
+                std::cerr << "ERROR cpputils FlightRecorder::registerName() Name table full, further names are "
+                             "recorded by id only"
+                          << std::endl;
+            }
+            return id;
+        }
+
+        flight::FlightName& entry = names()[id];
+        const size_t length = std::min(name.size(), flight::NAME_BYTES);
+        std::memcpy(entry.text, name.data(), length);
+        entry.length.store(static_cast<uint32_t>(length), std::memory_order_release);
+        header->nameCount.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // Names the calling thread's ring (truncated to 44 bytes)
+    void setThreadName(std::string_view name)
+    {
+        flight::FlightThreadHeader* ring = rings.local().header;
+        if (ring == nullptr)
+            return;
+
+        const size_t length = std::min(name.size(), flight::THREAD_NAME_BYTES);
+        ring->nameLength.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(ring->name, name.data(), length);
+        ring->nameLength.store(static_cast<uint32_t>(length), std::memory_order_release);
+    }
+
+    void scope(uint32_t nameId, clockType::time_point start, clockType::time_point end)
+    {
+        const int64_t startNs = toNs(start);
+        write(FlightEventType::SCOPE, nameId, startNs, static_cast<uint64_t>(toNs(end) - startNs));
+    }
+
+    void counter(uint32_t nameId, double value)
+    {
+        write(FlightEventType::COUNTER, nameId, toNs(clockType::now()), std::bit_cast<uint64_t>(value));
+    }
+
+    void marker(uint32_t nameId, int64_t payload = 0)
+    {
+        write(FlightEventType::MARKER, nameId, toNs(clockType::now()), static_cast<uint64_t>(payload));
+    }
+
+    // Forces the recording to disk. Not needed to survive a process crash,
+    // only an OS crash or power loss; blocks on I/O.
+    bool flush() { return file.flush(); }
+
+private:
+    struct ThreadRing
+    {
+        flight::FlightThreadHeader* header{nullptr};
+        flight::FlightEvent* events{nullptr};
+        uint64_t mask{0};
+    };
+
+    void write(FlightEventType type, uint32_t nameId, int64_t timestampNs, uint64_t value)
+    {
+        if (header == nullptr) [[unlikely]]
+            return;
+
+        ThreadRing& ring = rings.local();
+        if (ring.header == nullptr) [[unlikely]] {
+            header->droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Single writer per ring: head is only read back by readers
+        const uint64_t index = ring.header->head.load(std::memory_order_relaxed);
+        flight::FlightEvent& event = ring.events[index & ring.mask];
+
+        // Invalidate the slot before overwriting it, then publish it with its new sequence
+        event.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        event.timestampNs.store(timestampNs, std::memory_order_relaxed);
+        event.value.store(value, std::memory_order_relaxed);
+        event.nameId.store(nameId, std::memory_order_relaxed);
+        event.type.store(type, std::memory_order_relaxed);
+        event.sequence.store(index + 1, std::memory_order_release);
+
+        ring.header->head.store(index + 1, std::memory_order_relaxed);
+    }
+
+    // Called by PerThread (under its lock) on a thread's first event
+    ThreadRing claimRing()
+    {
+        ThreadRing ring;
+        if (header == nullptr)
+            return ring;
+
+        const uint32_t index = header->threadCount.fetch_add(1, std::memory_order_relaxed);
+        if (index >= header->threadCapacity) {
+            header->threadCount.store(header->threadCapacity, std::memory_order_relaxed);
+            return ring;
+        }
+
+        unsigned char* base = static_cast<unsigned char*>(file.data()) + header->threadsOffset
+                              + index * header->threadStride;
+        ring.header = reinterpret_cast<flight::FlightThreadHeader*>(base);
+        ring.events = reinterpret_cast<flight::FlightEvent*>(base + sizeof(flight::FlightThreadHeader));
+        ring.mask = header->eventsPerThread - 1;
+        ring.header->threadId.store(flight::currentThreadId(), std::memory_order_relaxed);
+        return ring;
+    }
+
+    flight::FlightName* names()
+    {
+        return reinterpret_cast<flight::FlightName*>(static_cast<unsigned char*>(file.data()) + header->namesOffset);
+    }
+
+    static int64_t toNs(clockType::time_point timePoint)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+    }
+
+    static size_t roundUpToPowerOfTwo(size_t value) { return std::bit_ceil(std::max<size_t>(value, 2)); }
+
+    static size_t threadStride(size_t capacity)
+    {
+        return sizeof(flight::FlightThreadHeader) + capacity * sizeof(flight::FlightEvent);
+    }
+
+    static size_t fileBytes(size_t capacity, size_t threadCapacity, size_t nameCapacity)
+    {
+        return sizeof(flight::FlightFileHeader) + nameCapacity * sizeof(flight::FlightName)
+               + threadCapacity * threadStride(capacity);
+    }
+
+    static long pageBytes()
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<long>(info.dwPageSize);
+#elif defined(__linux__)
+        return sysconf(_SC_PAGESIZE);
+#else
+        return 4096;
+#endif
+    }
+
+    MappedFile file;
+    flight::FlightFileHeader* header{nullptr};
+    PerThread<ThreadRing> rings;
+    std::mutex namesMutex;
+    std::unordered_map<std::string, uint32_t> nameIds;
+};
+
+//------------------------------------------------------------
+// class FlightScope
+//
+// Records one SCOPE event covering its lifetime.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class FlightScope
+{
+public:
+    FlightScope(FlightRecorder<clockType>& recorder, uint32_t nameId) :
+        recorder(recorder), nameId(nameId), startTime(clockType::now())
+    {}
+
+    ~FlightScope() { recorder.scope(nameId, startTime, clockType::now()); }
+
+    FlightScope(const FlightScope& other) = delete;
+    FlightScope& operator=(const FlightScope& other) = delete;
+
+private:
+    FlightRecorder<clockType>& recorder;
+    uint32_t nameId;
+    clockType::time_point startTime;
+};
+
+//------------------------------------------------------------
+// class FlightRecordReader
+//
+// Decodes a flight recorder file, written by a live or crashed process.
+// Opens the file read-only and validates the header against the file
+// size before touching anything else.
+//------------------------------------------------------------
+class FlightRecordReader
+{
+public:
+    struct Record
+    {
+        int64_t timestampNs; // Recorder clock
+        int64_t wallTimeNs;  // system_clock, from the origin pair in the header
+        uint64_t value;
+        uint32_t nameId;
+        FlightEventType type;
+        uint32_t threadIndex;
+        uint64_t sequence; // Write order within the thread's ring, from 1
+
+        int64_t getDurationNs() const { return static_cast<int64_t>(value); }
+        double getCounterValue() const { return std::bit_cast<double>(value); }
+        int64_t getPayload() const { return static_cast<int64_t>(value); }
+    };
+
+    struct ThreadInfo
+    {
+        uint64_t threadId;
+        std::string name;
+        uint64_t eventsWritten;
+    };
+
+    explicit FlightRecordReader(const std::string& path) : file(path, MappedFileMode::READ_ONLY) { validate(); }
+
+    FlightRecordReader(const FlightRecordReader& other) = delete;
+    FlightRecordReader& operator=(const FlightRecordReader& other) = delete;
+
+    bool valid() const { return header != nullptr; }
+
+    uint64_t getProcessId() const { return header->processId; }
+    uint64_t getDroppedEvents() const { return header->droppedEvents.load(std::memory_order_relaxed); }
+    uint64_t getEventsPerThread() const { return header->eventsPerThread; }
+    uint32_t getThreadCapacity() const { return header->threadCapacity; }
+
+    // Registered name, or "#<id>" when it did not fit the name table
+    std::string getName(uint32_t nameId) const
+    {
+        const uint32_t nameCount = std::min(header->nameCount.load(std::memory_order_acquire), header->nameCapacity);
+        if (nameId < nameCount) {
+            const flight::FlightName& entry = names()[nameId];
+            const uint32_t length = entry.length.load(std::memory_order_acquire);
+            if (length > 0)
+                return std::string(entry.text, std::min<size_t>(length, flight::NAME_BYTES));
+        }
+        return "#" + std::to_string(nameId);
+    }
+
+    std::vector<ThreadInfo> getThreads() const
+    {
+        std::vector<ThreadInfo> threads;
+        for (uint32_t i = 0; i < getThreadCount(); i++) {
+            const flight::FlightThreadHeader& ring = threadHeader(i);
+            const uint32_t length = ring.nameLength.load(std::memory_order_acquire);
+            threads.push_back({ring.threadId.load(std::memory_order_relaxed),
+                               std::string(ring.name, std::min<size_t>(length, flight::THREAD_NAME_BYTES)),
+                               ring.head.load(std::memory_order_relaxed)});
+        }
+        return threads;
+    }
+
+    // Every complete event still in the rings, oldest first
+    std::vector<Record> readEvents() const
+    {
+        std::vector<Record> records;
+        for (uint32_t i = 0; i < getThreadCount(); i++) {
+            readRing(i, records);
+        }
+        // Slots are scanned in slot order, not write order; ties on a coarse clock keep per-thread order
+        std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+            return std::tie(a.timestampNs, a.threadIndex, a.sequence)
+                 < std::tie(b.timestampNs, b.threadIndex, b.sequence);
+        });
+        return records;
+    }
+
+    // Events within `window` of the newest one
+    std::vector<Record> readLastEvents(std::chrono::nanoseconds window) const
+    {
+        std::vector<Record> records = readEvents();
+        if (records.empty())
+            return records;
+
+        const int64_t cutoffNs = records.back().timestampNs - window.count();
+        const auto first = std::lower_bound(records.begin(), records.end(), cutoffNs,
+                                            [](const Record& r, int64_t ns) { return r.timestampNs < ns; });
+        records.erase(records.begin(), first);
+        return records;
+    }
+
+private:
+    void validate()
+    {
+        if (!file.valid())
+            return;
+        if (file.size() < sizeof(flight::FlightFileHeader)) {
+            std::cerr << "ERROR cpputils FlightRecordReader() " << file.getPath() << " is too small" << std::endl;
+            return;
+        }
+
+        const flight::FlightFileHeader* candidate = static_cast<const flight::FlightFileHeader*>(file.data());
+        if (std::memcmp(candidate->magic, flight::MAGIC, sizeof(flight::MAGIC)) != 0
+            || candidate->version != flight::VERSION) {
+            std::cerr << "ERROR cpputils FlightRecordReader() " << file.getPath()
+                      << " is not a version " << flight::VERSION << " flight recording" << std::endl;
+            return;
+        }
+
+        const uint64_t events = candidate->eventsPerThread;
+        const bool layoutValid
+            = candidate->headerBytes == sizeof(flight::FlightFileHeader) && events >= 2 && std::has_single_bit(events)
+              && candidate->namesOffset == sizeof(flight::FlightFileHeader)
+              && candidate->threadsOffset
+                     == candidate->namesOffset + uint64_t{candidate->nameCapacity} * sizeof(flight::FlightName)
+              && candidate->threadStride == sizeof(flight::FlightThreadHeader) + events * sizeof(flight::FlightEvent)
+              && candidate->threadsOffset + uint64_t{candidate->threadCapacity} * candidate->threadStride
+                     <= file.size();
+        if (!layoutValid) {
+            std::cerr << "ERROR cpputils FlightRecordReader() " << file.getPath() << " has a corrupt header"
+                      << std::endl;
+            return;
+        }
+        header = candidate;
+    }
+
+    uint32_t getThreadCount() const
+    {
+        return std::min(header->threadCount.load(std::memory_order_acquire), header->threadCapacity);
+    }
+
+    const flight::FlightName* names() const
+    {
+        return reinterpret_cast<const flight::FlightName*>(static_cast<const unsigned char*>(file.data())
+                                                           + header->namesOffset);
+    }
+
+    const unsigned char* ringBase(uint32_t threadIndex) const
+    {
+        return static_cast<const unsigned char*>(file.data()) + header->threadsOffset
+               + threadIndex * header->threadStride;
+    }
+
+    const flight::FlightThreadHeader& threadHeader(uint32_t threadIndex) const
+    {
+        return *reinterpret_cast<const flight::FlightThreadHeader*>(ringBase(threadIndex));
+    }
+
+    void readRing(uint32_t threadIndex, std::vector<Record>& records) const
+    {
+        const flight::FlightEvent* events = reinterpret_cast<const flight::FlightEvent*>(
+            ringBase(threadIndex) + sizeof(flight::FlightThreadHeader));
+        const uint64_t capacity = header->eventsPerThread;
+
+        // Scan by sequence rather than trusting head: a crash can land between
+        // publishing an event and advancing head. Each slot only ever holds the
+        // latest event written to it, so every valid slot is part of the window.
+        for (uint64_t slot = 0; slot < capacity; slot++) {
+            const flight::FlightEvent& event = events[slot];
+            const uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+            if (sequence == 0 || ((sequence - 1) & (capacity - 1)) != slot)
+                continue;
+
+            Record record{event.timestampNs.load(std::memory_order_relaxed),
+                          0,
+                          event.value.load(std::memory_order_relaxed),
+                          event.nameId.load(std::memory_order_relaxed),
+                          event.type.load(std::memory_order_relaxed),
+                          threadIndex,
+                          sequence};
+
+            // Rewritten while we copied it (live process)
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            record.wallTimeNs = header->systemOriginNs + (record.timestampNs - header->clockOriginNs);
+            records.push_back(record);
+        }
+    }
+
+    MappedFile file;
+    const flight::FlightFileHeader* header{nullptr};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_FLIGHT_RECORDER_H
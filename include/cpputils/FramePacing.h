@@ -0,0 +1,226 @@
+#ifndef CPPUTILS_FRAME_PACING_H
+#define CPPUTILS_FRAME_PACING_H
+
+#include "cpputils/CpuRelax.h"
+#include "cpputils/LatencyHistogram.h"
+#include "cpputils/Timer.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class FramePacingTimer
+//
+// FramerateTimer with the statistics that show stutter rather than hide
+// it: standard deviation of the frametime, 1% and 0.1% low framerates
+// (the framerate at the 99th / 99.9th percentile frametime) and a
+// frametime histogram, all over the last sampleCount frames.
+//
+// markFrame() is O(1): the frame leaving the window is removed from the
+// running sums and the histogram as the new one is added. The sum of
+// squares is recomputed from the window once per wrap so floating point
+// error cannot accumulate. Low framerate queries walk the histogram.
+//------------------------------------------------------------
+template<Clock clockType, size_t sampleCount>
+class FramePacingTimer
+{
+    static_assert(sampleCount > 0);
+
+public:
+    // ~1.6% resolution, frametimes up to ~68s
+    using Histogram = LatencyHistogram<6, 36>;
+
+    FramePacingTimer() { lastMeasuredTime = clockType::now(); }
+
+    void reset()
+    {
+        lastMeasuredTime = clockType::now();
+        timings.fill(std::chrono::nanoseconds(0));
+        index = 0;
+        filled = 0;
+        timingsSumNs = 0;
+        timingsSquaresSumNs = 0.0;
+        histogram.reset();
+    }
+
+    void markFrame()
+    {
+        const typename clockType::time_point frameTime = clockType::now();
+        std::chrono::nanoseconds elapsedTime
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(frameTime - lastMeasuredTime);
+        elapsedTime = elapsedTime.count() < 0 ? std::chrono::nanoseconds(0) : elapsedTime;
+        lastMeasuredTime = frameTime;
+
+        if (filled == sampleCount) {
+            const std::chrono::nanoseconds leaving = timings[index];
+            histogram.remove(leaving);
+            timingsSumNs -= leaving.count();
+            timingsSquaresSumNs -= static_cast<double>(leaving.count()) * static_cast<double>(leaving.count());
+        } else {
+            filled++;
+        }
+
+        timings[index] = elapsedTime;
+        histogram.record(elapsedTime);
+        timingsSumNs += elapsedTime.count();
+        timingsSquaresSumNs += static_cast<double>(elapsedTime.count()) * static_cast<double>(elapsedTime.count());
+        index = (index + 1) % sampleCount;
+
+        if (index == 0) {
+            timingsSquaresSumNs = 0.0;
+            for (const std::chrono::nanoseconds& timing : timings) {
+                timingsSquaresSumNs += static_cast<double>(timing.count()) * static_cast<double>(timing.count());
+            }
+        }
+    }
+
+    // Frames currently in the window, sampleCount once warmed up
+    size_t getSampleCount() const { return filled; }
+
+    double getFrametimeMs() const
+    {
+        return filled == 0 ? 0.0 : static_cast<double>(timingsSumNs) / static_cast<double>(filled) / 1'000'000;
+    }
+
+    double getFramerate() const
+    {
+        const double frametimeMs = getFrametimeMs();
+        return frametimeMs <= 0.0 ? 0.0 : 1'000.0 / frametimeMs;
+    }
+
+    double getFrametimeVarianceMs2() const
+    {
+        if (filled == 0)
+            return 0.0;
+
+        const double meanNs = static_cast<double>(timingsSumNs) / static_cast<double>(filled);
+        const double varianceNs2 = timingsSquaresSumNs / static_cast<double>(filled) - meanNs * meanNs;
+        return varianceNs2 > 0.0 ? varianceNs2 / 1e12 : 0.0;
+    }
+
+    double getFrametimeStdDevMs() const { return std::sqrt(getFrametimeVarianceMs2()); }
+
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getFrametimePercentile(double percentile) const
+    {
+        return histogram.template getPercentile<durationType>(percentile);
+    }
+
+    double getOnePercentLowFramerate() const { return framerateAtPercentile(99.0); }
+
+    double getPointOnePercentLowFramerate() const { return framerateAtPercentile(99.9); }
+
+    const Histogram& getHistogram() const { return histogram; }
+
+private:
+    double framerateAtPercentile(double percentile) const
+    {
+        const int64_t frametimeNs = histogram.getPercentile(percentile).count();
+        return frametimeNs <= 0 ? 0.0 : 1e9 / static_cast<double>(frametimeNs);
+    }
+
+    clockType::time_point lastMeasuredTime{};
+    std::array<std::chrono::nanoseconds, sampleCount> timings{};
+    size_t index{0};
+    size_t filled{0};
+    int64_t timingsSumNs{0};
+    double timingsSquaresSumNs{0.0};
+    Histogram histogram;
+};
+
+//------------------------------------------------------------
+// class FrameLimiter
+//
+// Paces a loop to a fixed period. wait() blocks until the next deadline
+// with a hybrid wait: the thread sleeps while the deadline is further
+// away than the expected oversleep, then spins on the clock for the rest.
+// The expected oversleep is learned from every sleep (exponentially
+// weighted mean + 3 deviations), so the spin stays short on a quiet
+// Linux box (~60us timer slack) and grows where sleeps are coarse. The
+// spin is capped at half a period so a noisy machine cannot turn the
+// limiter into a busy loop; on Windows raise the timer resolution
+// (timeBeginPeriod) for sub-millisecond pacing.
+//
+// Deadlines advance by exactly one period, so small misses do not
+// accumulate drift. If a frame overruns a whole period the schedule
+// restarts from the current time instead of bursting to catch up.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class FrameLimiter
+{
+public:
+    explicit FrameLimiter(std::chrono::nanoseconds period) : period(period) { reset(); }
+
+    void reset() { nextDeadline = clockType::now() + period; }
+
+    void setPeriod(std::chrono::nanoseconds newPeriod)
+    {
+        period = newPeriod;
+        reset();
+    }
+
+    std::chrono::nanoseconds getPeriod() const { return period; }
+
+    // Time kept for spinning before each deadline, at most half a period
+    std::chrono::nanoseconds getSpinThreshold() const
+    {
+        const std::chrono::nanoseconds threshold(static_cast<int64_t>(oversleepMeanNs + 3.0 * oversleepDeviationNs));
+        return threshold < period / 2 ? threshold : period / 2;
+    }
+
+    // Returns how late the deadline was met (0 when on time)
+    std::chrono::nanoseconds wait()
+    {
+        const typename clockType::time_point deadline = nextDeadline;
+
+        for (;;) {
+            const typename clockType::time_point now = clockType::now();
+            const std::chrono::nanoseconds remaining
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            const std::chrono::nanoseconds sleepTime = remaining - getSpinThreshold();
+            if (sleepTime <= std::chrono::nanoseconds(0))
+                break;
+
+            std::this_thread::sleep_for(sleepTime);
+            const std::chrono::nanoseconds slept
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(clockType::now() - now);
+            learnOversleep(static_cast<double>((slept - sleepTime).count()));
+        }
+
+        typename clockType::time_point now = clockType::now();
+        while (now < deadline) {
+            cpuRelax();
+            now = clockType::now();
+        }
+
+        const std::chrono::nanoseconds lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline);
+        nextDeadline = lateness >= period ? now + period : deadline + period;
+        return lateness;
+    }
+
+private:
+    void learnOversleep(double oversleepNs)
+    {
+        oversleepNs = oversleepNs < 0.0 ? 0.0 : oversleepNs;
+        const double error = oversleepNs - oversleepMeanNs;
+        oversleepMeanNs += error * OVERSLEEP_WEIGHT;
+        oversleepDeviationNs += (std::abs(error) - oversleepDeviationNs) * OVERSLEEP_WEIGHT;
+    }
+
+    static constexpr double OVERSLEEP_WEIGHT = 1.0 / 16.0;
+
+    std::chrono::nanoseconds period;
+    clockType::time_point nextDeadline{};
+    // Start pessimistic (one coarse scheduler tick) and learn downwards
+    double oversleepMeanNs{1'000'000.0};
+    double oversleepDeviationNs{0.0};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_FRAME_PACING_H
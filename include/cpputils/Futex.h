@@ -0,0 +1,505 @@
+#ifndef CPPUTILS_FUTEX_H
+#define CPPUTILS_FUTEX_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/CpuRelax.h"
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+//------------------------------------------------------------
+// Futex-based synchronization
+//
+// Small locks and one-shot/counting primitives that spin briefly and
+// then park in the kernel on their own 32-bit word, so an uncontended
+// operation is one atomic RMW and a wakeup is one syscall only when
+// somebody is actually asleep. futexWait()/futexWake() call futex(2)
+// directly on Linux and fall back to std::atomic::wait/notify elsewhere.
+// On a single-CPU machine nothing spins: the thread being waited for
+// cannot make progress until the waiter gives up the CPU.
+//
+// AdaptiveMutex and TicketLock satisfy Lockable (hence try_lock), so
+// std::lock_guard, std::unique_lock and std::scoped_lock work with them.
+//------------------------------------------------------------
+
+namespace cpputils {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit integers");
+
+// Sleeps while `word` holds `expected`; may return spuriously
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    word.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+// Wakes up to `count` threads sleeping in futexWait() on `word`
+inline void futexWake(std::atomic<uint32_t>& word, int count)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    if (count == 1)
+        word.notify_one();
+    else
+        word.notify_all();
+#endif
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>& word)
+{
+    futexWake(word, INT_MAX);
+}
+
+namespace detail {
+
+// futexWait()/futexWake() restricted to waiters whose masks intersect, so a
+// waker can pick out particular sleepers on a shared word. Without
+// FUTEX_WAIT_BITSET every sleeper wakes and re-checks.
+inline void futexWaitMasked(std::atomic<uint32_t>& word, uint32_t expected, uint32_t mask)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_BITSET_PRIVATE, expected, nullptr, nullptr,
+            mask);
+#else
+    (void)mask;
+    word.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+inline void futexWakeMasked(std::atomic<uint32_t>& word, uint32_t mask)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_BITSET_PRIVATE, INT_MAX, nullptr, nullptr,
+            mask);
+#else
+    (void)mask;
+    word.notify_all();
+#endif
+}
+
+// Spinning only pays off if the thread we wait for can run meanwhile
+inline int futexSpinLimit(int limit)
+{
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    return multiCore ? limit : 0;
+}
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class AdaptiveMutex
+//
+// 4-byte mutex (Drepper, "Futexes Are Tricky", mutex 3): 0 unlocked,
+// 1 locked, 2 locked with possible sleepers. lock() is one CAS when free.
+// A contender spins for a while in case the holder is about to leave,
+// but not once somebody is already asleep: then it queues behind them.
+// unlock() makes a syscall only in the contended state. Not fair.
+//------------------------------------------------------------
+class AdaptiveMutex
+{
+public:
+    static constexpr int SPIN_LIMIT = 100;
+
+    AdaptiveMutex() = default;
+    AdaptiveMutex(const AdaptiveMutex& other) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex& other) = delete;
+
+    void lock()
+    {
+        uint32_t expected = UNLOCKED;
+        if (!state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            [[unlikely]]
+            lockContended();
+    }
+
+    bool try_lock()
+    {
+        uint32_t expected = UNLOCKED;
+        return state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        if (state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+            futexWake(state, 1);
+    }
+
+private:
+    static constexpr uint32_t UNLOCKED = 0;
+    static constexpr uint32_t LOCKED = 1;
+    static constexpr uint32_t CONTENDED = 2;
+
+    void lockContended()
+    {
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            cpuRelax();
+            uint32_t current = state.load(std::memory_order_relaxed);
+            if (current == CONTENDED)
+                break;
+            if (current == UNLOCKED
+                && state.compare_exchange_weak(current, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+        // Taking the lock as CONTENDED may cost one needless wake; it never loses one
+        while (state.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED) {
+            futexWait(state, CONTENDED);
+        }
+    }
+
+    std::atomic<uint32_t> state{UNLOCKED};
+};
+
+//------------------------------------------------------------
+// class TicketLock
+//
+// FIFO lock on one cache line: lock() takes a ticket and waits for the
+// serving counter to reach it, so under heavy contention no thread can
+// be overtaken indefinitely. Waiters spin, then park on the serving
+// counter tagged with ticket % 32, so unlock() wakes only the next
+// ticket's holder (and any waiter 32, 64, ... places behind it), and
+// makes no syscall when nobody is parked.
+//------------------------------------------------------------
+class alignas(CACHE_LINE_SIZE) TicketLock
+{
+public:
+    static constexpr int SPIN_LIMIT = 200;
+
+    TicketLock() = default;
+    TicketLock(const TicketLock& other) = delete;
+    TicketLock& operator=(const TicketLock& other) = delete;
+
+    void lock()
+    {
+        const uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+        if (serving.load(std::memory_order_acquire) == ticket) [[likely]]
+            return;
+
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            cpuRelax();
+            if (serving.load(std::memory_order_acquire) == ticket)
+                return;
+        }
+
+        // seq_cst pairs with unlock(): it sees us parked or we see its increment
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t current = serving.load(std::memory_order_seq_cst);
+        while (current != ticket) {
+            detail::futexWaitMasked(serving, current, wakeMask(ticket));
+            current = serving.load(std::memory_order_seq_cst);
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool try_lock()
+    {
+        const uint32_t current = serving.load(std::memory_order_acquire);
+        uint32_t expected = current;
+        return next.compare_exchange_strong(expected, current + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        const uint32_t nextTicket = serving.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (sleepers.load(std::memory_order_seq_cst) != 0)
+            detail::futexWakeMasked(serving, wakeMask(nextTicket));
+    }
+
+private:
+    static uint32_t wakeMask(uint32_t ticket) { return 1u << (ticket % 32); }
+
+    std::atomic<uint32_t> next{0};    // Next ticket to hand out
+    std::atomic<uint32_t> serving{0}; // Ticket that holds the lock
+    std::atomic<uint32_t> sleepers{0};
+};
+
+//------------------------------------------------------------
+// class McsLock
+//
+// Queue lock (Mellor-Crummey & Scott): each waiter spins, then parks, on
+// a flag in its own Node, and unlock() hands the lock straight to the
+// next node. FIFO like TicketLock, but a handoff touches one waiter's
+// cache line instead of invalidating every waiter's. The lock itself is
+// one pointer. Each acquisition needs a Node that lives until unlock();
+// McsLock::Guard keeps one on the stack:
+//
+//     cpputils::McsLock::Guard guard(lock);
+//------------------------------------------------------------
+class McsLock
+{
+public:
+    static constexpr int SPIN_LIMIT = 200;
+
+    struct alignas(CACHE_LINE_SIZE) Node
+    {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<uint32_t> state{0};
+    };
+
+    class Guard
+    {
+    public:
+        explicit Guard(McsLock& lock) : lock(lock) { lock.lock(node); }
+        ~Guard() { lock.unlock(node); }
+
+        Guard(const Guard& other) = delete;
+        Guard& operator=(const Guard& other) = delete;
+
+    private:
+        McsLock& lock;
+        Node node;
+    };
+
+    McsLock() = default;
+    McsLock(const McsLock& other) = delete;
+    McsLock& operator=(const McsLock& other) = delete;
+
+    void lock(Node& node)
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.state.store(WAITING, std::memory_order_relaxed);
+        Node* previous = tail.exchange(&node, std::memory_order_acq_rel);
+        if (previous == nullptr) [[likely]]
+            return;
+
+        previous->next.store(&node, std::memory_order_release);
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            if (node.state.load(std::memory_order_acquire) == GRANTED)
+                return;
+            cpuRelax();
+        }
+        uint32_t expected = WAITING;
+        if (node.state.compare_exchange_strong(expected, PARKED, std::memory_order_acquire)) {
+            do {
+                futexWait(node.state, PARKED);
+            } while (node.state.load(std::memory_order_acquire) != GRANTED);
+        }
+    }
+
+    bool tryLock(Node& node)
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        return tail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock(Node& node)
+    {
+        Node* successor = node.next.load(std::memory_order_acquire);
+        if (successor == nullptr) {
+            Node* expected = &node;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+                return;
+            // A successor has swapped itself in but not linked yet: it is about to
+            for (int spin = 0; (successor = node.next.load(std::memory_order_acquire)) == nullptr; spin++) {
+                if (spin < SPIN_LIMIT)
+                    cpuRelax();
+                else
+                    std::this_thread::yield();
+            }
+        }
+        // The successor may return (and its Node go away) as soon as it sees GRANTED;
+        // a wake on a dead futex word is harmless, since every wait re-checks its state
+        if (successor->state.exchange(GRANTED, std::memory_order_release) == PARKED)
+            futexWake(successor->state, 1);
+    }
+
+private:
+    static constexpr uint32_t WAITING = 0;
+    static constexpr uint32_t PARKED = 1;
+    static constexpr uint32_t GRANTED = 2;
+
+    std::atomic<Node*> tail{nullptr};
+};
+
+//------------------------------------------------------------
+// class OneShotEvent
+//
+// 4-byte flag that threads can wait on until it is set, once. set()
+// makes a syscall only if somebody went to sleep waiting.
+//------------------------------------------------------------
+class OneShotEvent
+{
+public:
+    static constexpr int SPIN_LIMIT = 100;
+
+    OneShotEvent() = default;
+    OneShotEvent(const OneShotEvent& other) = delete;
+    OneShotEvent& operator=(const OneShotEvent& other) = delete;
+
+    void set()
+    {
+        if (state.exchange(SET, std::memory_order_release) == WAITED_ON)
+            futexWakeAll(state);
+    }
+
+    bool isSet() const { return state.load(std::memory_order_acquire) == SET; }
+
+    void wait()
+    {
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            if (isSet())
+                return;
+            cpuRelax();
+        }
+        uint32_t current = state.load(std::memory_order_acquire);
+        while (current != SET) {
+            if (current == UNSET
+                && !state.compare_exchange_weak(current, WAITED_ON, std::memory_order_relaxed,
+                                                std::memory_order_acquire)) {
+                continue;
+            }
+            futexWait(state, WAITED_ON);
+            current = state.load(std::memory_order_acquire);
+        }
+    }
+
+private:
+    static constexpr uint32_t UNSET = 0;
+    static constexpr uint32_t SET = 1;
+    static constexpr uint32_t WAITED_ON = 2; // Unset, and somebody may be asleep
+
+    std::atomic<uint32_t> state{UNSET};
+};
+
+//------------------------------------------------------------
+// class Semaphore
+//
+// Counting semaphore: the count and a sleeper count, 8 bytes. acquire()
+// takes one unit, spinning and then parking while the count is zero;
+// release(n) adds n and wakes at most n sleepers, and makes no syscall
+// when nobody sleeps.
+//------------------------------------------------------------
+class Semaphore
+{
+public:
+    static constexpr int SPIN_LIMIT = 100;
+
+    explicit Semaphore(uint32_t initial = 0) : count(initial) {}
+
+    Semaphore(const Semaphore& other) = delete;
+    Semaphore& operator=(const Semaphore& other) = delete;
+
+    bool tryAcquire()
+    {
+        uint32_t current = count.load(std::memory_order_relaxed);
+        while (current != 0) {
+            if (count.compare_exchange_weak(current, current - 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    void acquire()
+    {
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            if (tryAcquire())
+                return;
+            cpuRelax();
+        }
+
+        // seq_cst pairs with release(): it sees us asleep or we see its units
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t current = count.load(std::memory_order_seq_cst);
+        for (;;) {
+            if (current == 0) {
+                futexWait(count, 0);
+                current = count.load(std::memory_order_seq_cst);
+            } else if (count.compare_exchange_weak(current, current - 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void release(uint32_t units = 1)
+    {
+        count.fetch_add(units, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) != 0)
+            futexWake(count, units > INT_MAX ? INT_MAX : static_cast<int>(units));
+    }
+
+    // Snapshot; stale as soon as it returns
+    uint32_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sleepers{0};
+};
+
+//------------------------------------------------------------
+// class Latch
+//
+// 4-byte countdown latch in the manner of std::latch: wait() returns once
+// countDown() has been called `expected` times in total. The top bit of
+// the word records that somebody may be asleep, so the final countDown()
+// makes a syscall only then.
+//------------------------------------------------------------
+class Latch
+{
+public:
+    static constexpr int SPIN_LIMIT = 100;
+
+    // expected < 2^31
+    explicit Latch(uint32_t expected) : state(expected & COUNT_MASK) {}
+
+    Latch(const Latch& other) = delete;
+    Latch& operator=(const Latch& other) = delete;
+
+    void countDown(uint32_t units = 1)
+    {
+        const uint32_t previous = state.fetch_sub(units, std::memory_order_acq_rel);
+        if ((previous & COUNT_MASK) == units && (previous & SLEEPERS) != 0)
+            futexWakeAll(state);
+    }
+
+    bool tryWait() const { return (state.load(std::memory_order_acquire) & COUNT_MASK) == 0; }
+
+    void wait()
+    {
+        for (int spin = 0, limit = detail::futexSpinLimit(SPIN_LIMIT); spin < limit; spin++) {
+            if (tryWait())
+                return;
+            cpuRelax();
+        }
+        uint32_t current = state.load(std::memory_order_acquire);
+        while ((current & COUNT_MASK) != 0) {
+            if ((current & SLEEPERS) == 0) {
+                current = state.fetch_or(SLEEPERS, std::memory_order_acquire) | SLEEPERS;
+                continue;
+            }
+            futexWait(state, current);
+            current = state.load(std::memory_order_acquire);
+        }
+    }
+
+    void arriveAndWait(uint32_t units = 1)
+    {
+        countDown(units);
+        wait();
+    }
+
+private:
+    static constexpr uint32_t SLEEPERS = 0x80000000u;
+    static constexpr uint32_t COUNT_MASK = ~SLEEPERS;
+
+    std::atomic<uint32_t> state;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_FUTEX_H
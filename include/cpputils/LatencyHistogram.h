@@ -0,0 +1,225 @@
+#ifndef CPPUTILS_LATENCY_HISTOGRAM_H
+#define CPPUTILS_LATENCY_HISTOGRAM_H
+
+#include "cpputils/Timer.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class LatencyHistogram
+//
+// Log-linear bucketed histogram of durations (HDR histogram layout).
+// Values below 2^precisionBits ns get one bucket each. Above that,
+// every power-of-two range is split into 2^precisionBits linear
+// sub-buckets, so any reported value is within 2^-precisionBits of
+// the recorded one. Values of 2^rangeBits ns (~73 minutes with the
+// default) or more are clamped into the last bucket.
+//
+// Storage is a fixed std::array: recording is O(1) and never allocates.
+//------------------------------------------------------------
+template<size_t precisionBits = 7, size_t rangeBits = 42>
+class LatencyHistogram
+{
+    static_assert(precisionBits >= 1 && precisionBits < rangeBits && rangeBits < 64);
+
+public:
+    static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << precisionBits;
+    static constexpr size_t BUCKET_COUNT = (rangeBits - precisionBits + 1) * SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_TRACKABLE_NS = (uint64_t{1} << rangeBits) - 1;
+
+    static constexpr size_t bucketIndex(uint64_t valueNs)
+    {
+        if (valueNs > MAX_TRACKABLE_NS)
+            valueNs = MAX_TRACKABLE_NS;
+        if (valueNs < SUB_BUCKET_COUNT)
+            return static_cast<size_t>(valueNs);
+
+        const size_t shift = static_cast<size_t>(std::bit_width(valueNs)) - 1 - precisionBits;
+        return shift * SUB_BUCKET_COUNT + static_cast<size_t>(valueNs >> shift);
+    }
+
+    static constexpr uint64_t bucketLowerBound(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+            return index;
+
+        const size_t shift = index / SUB_BUCKET_COUNT - 1;
+        return static_cast<uint64_t>(index - shift * SUB_BUCKET_COUNT) << shift;
+    }
+
+    static constexpr uint64_t bucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+            return index;
+
+        const size_t shift = index / SUB_BUCKET_COUNT - 1;
+        return bucketLowerBound(index) + (uint64_t{1} << shift) - 1;
+    }
+
+    LatencyHistogram() { reset(); }
+
+    void reset()
+    {
+        counts.fill(0);
+        totalCount = 0;
+        minNs = std::numeric_limits<uint64_t>::max();
+        maxNs = 0;
+        sumNs = 0;
+        sumSquaresNs = 0.0;
+    }
+
+    void record(std::chrono::nanoseconds duration, uint64_t count = 1)
+    {
+        const uint64_t valueNs = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+
+        counts[bucketIndex(valueNs)] += count;
+        totalCount += count;
+        minNs = valueNs < minNs ? valueNs : minNs;
+        maxNs = valueNs > maxNs ? valueNs : maxNs;
+        sumNs += valueNs * count;
+        sumSquaresNs += static_cast<double>(valueNs) * static_cast<double>(valueNs) * static_cast<double>(count);
+    }
+
+    // Takes back samples added by record(), e.g. when a value leaves a
+    // rolling window. Only remove what was recorded: counts are unsigned.
+    // Min and max cannot be rolled back and keep covering every value
+    // recorded since reset(), so percentiles are clamped to a wider range.
+    void remove(std::chrono::nanoseconds duration, uint64_t count = 1)
+    {
+        const uint64_t valueNs = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+
+        counts[bucketIndex(valueNs)] -= count;
+        totalCount -= count;
+        sumNs -= valueNs * count;
+        sumSquaresNs -= static_cast<double>(valueNs) * static_cast<double>(valueNs) * static_cast<double>(count);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        if (other.totalCount == 0)
+            return;
+
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] += other.counts[i];
+        }
+        totalCount += other.totalCount;
+        minNs = other.minNs < minNs ? other.minNs : minNs;
+        maxNs = other.maxNs > maxNs ? other.maxNs : maxNs;
+        sumNs += other.sumNs;
+        sumSquaresNs += other.sumSquaresNs;
+    }
+
+    uint64_t getCount() const { return totalCount; }
+
+    uint64_t getBucketCount(size_t index) const { return counts[index]; }
+
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getMin() const
+    {
+        return std::chrono::duration_cast<durationType>(std::chrono::nanoseconds(totalCount == 0 ? 0 : minNs));
+    }
+
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getMax() const
+    {
+        return std::chrono::duration_cast<durationType>(std::chrono::nanoseconds(maxNs));
+    }
+
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getSum() const
+    {
+        return std::chrono::duration_cast<durationType>(std::chrono::nanoseconds(sumNs));
+    }
+
+    double getMeanNs() const { return totalCount == 0 ? 0.0 : static_cast<double>(sumNs) / totalCount; }
+
+    double getStdDevNs() const
+    {
+        if (totalCount == 0)
+            return 0.0;
+
+        const double mean = getMeanNs();
+        const double variance = sumSquaresNs / totalCount - mean * mean;
+        return variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+
+    // percentile is in [0, 100]. The result is the highest value that is
+    // equivalent to the bucket holding the requested rank, clamped to the
+    // exact min/max that were recorded.
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getPercentile(double percentile) const
+    {
+        if (totalCount == 0)
+            return durationType(0);
+
+        percentile = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+        uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(totalCount)));
+        rank = rank == 0 ? 1 : (rank > totalCount ? totalCount : rank);
+
+        uint64_t valueNs = maxNs;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            cumulative += counts[i];
+            if (cumulative >= rank) {
+                valueNs = bucketUpperBound(i);
+                break;
+            }
+        }
+        valueNs = valueNs < minNs ? minNs : (valueNs > maxNs ? maxNs : valueNs);
+
+        return std::chrono::duration_cast<durationType>(std::chrono::nanoseconds(valueNs));
+    }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t totalCount{0};
+    uint64_t minNs{std::numeric_limits<uint64_t>::max()};
+    uint64_t maxNs{0};
+    uint64_t sumNs{0};
+    double sumSquaresNs{0.0};
+};
+
+//------------------------------------------------------------
+// class HistogramTimer
+//
+// StatsTimer counterpart that keeps every start()/stop() interval in a
+// LatencyHistogram instead of a window of the last N samples.
+//------------------------------------------------------------
+template<Clock clockType, size_t precisionBits = 7>
+class HistogramTimer
+{
+public:
+    HistogramTimer() {}
+
+    void reset() { histogram.reset(); }
+
+    void start() { lastMeasuredTime = clockType::now(); }
+
+    void stop()
+    {
+        histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(clockType::now() - lastMeasuredTime));
+    }
+
+    const LatencyHistogram<precisionBits>& getHistogram() const { return histogram; }
+
+    template<ChronoDuration durationType = std::chrono::nanoseconds>
+    durationType getPercentile(double percentile) const
+    {
+        return histogram.template getPercentile<durationType>(percentile);
+    }
+
+private:
+    clockType::time_point lastMeasuredTime{};
+    LatencyHistogram<precisionBits> histogram;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_LATENCY_HISTOGRAM_H
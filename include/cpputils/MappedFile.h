@@ -0,0 +1,240 @@
+#ifndef CPPUTILS_MAPPED_FILE_H
+#define CPPUTILS_MAPPED_FILE_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace cpputils {
+
+enum class MappedFileMode
+{
+    CREATE,     // Create or truncate the file to sizeBytes of zeros, read-write
+    READ_WRITE, // Map an existing file, read-write
+    READ_ONLY,  // Map an existing file, read-only
+};
+
+//------------------------------------------------------------
+// class MappedFile
+//
+// File-backed counterpart of SharedMemory: maps a whole file into the
+// address space with a shared mapping. Stores land in the page cache, so
+// the kernel writes them back even if the process crashes afterwards;
+// flush() only matters for surviving an OS crash or power loss.
+//
+// CREATE reserves the file's disk blocks up front, so later stores into
+// the mapping cannot fail (SIGBUS) on a full disk; if the disk is already
+// too full, the open fails. Only on filesystems that cannot reserve
+// blocks is the file created sparse. For the existing-file modes the
+// mapping covers the file's current size.
+//------------------------------------------------------------
+class MappedFile
+{
+public:
+    MappedFile(const std::string& path, MappedFileMode mode, size_t sizeBytes = 0) :
+        path(path), mode(mode), sizeBytes(sizeBytes)
+    {
+        openMappedFile();
+    }
+
+    ~MappedFile() { closeMappedFile(); }
+
+    // No copy operations for now
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    // No move operations for now
+    MappedFile(MappedFile&& other) noexcept = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept = delete;
+
+    bool valid() const { return pData != nullptr; }
+
+    void* data() { return pData; }
+    const void* data() const { return pData; }
+    size_t size() const { return sizeBytes; }
+    const std::string& getPath() const { return path; }
+
+    // Writes dirty pages back to the file and waits for completion
+    bool flush()
+    {
+        if (pData == nullptr || mode == MappedFileMode::READ_ONLY)
+            return false;
+#if defined(_WIN32)
+        return FlushViewOfFile(pData, 0) && FlushFileBuffers(hFile);
+#elif defined(__linux__)
+        return msync(pData, sizeBytes, MS_SYNC) == 0;
+#else
+        return false;
+#endif
+    }
+
+private:
+    void* pData{nullptr};
+    std::string path;
+    MappedFileMode mode;
+    size_t sizeBytes{0};
+
+    // Platform-specific members
+#if defined(_WIN32)
+    HANDLE hFile{INVALID_HANDLE_VALUE};
+    HANDLE hFileMapping{NULL};
+#elif defined(__linux__)
+    int fd{-1};
+#endif
+
+    //------------------------------------------------------------
+    // openMappedFile()
+    //------------------------------------------------------------
+    void openMappedFile()
+    {
+        const bool writable = mode != MappedFileMode::READ_ONLY;
+#if defined(_WIN32)
+        hFile = CreateFileA(path.c_str(),
+                            writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            NULL,
+                            mode == MappedFileMode::CREATE ? CREATE_ALWAYS : OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            NULL);
+        if (hFile == INVALID_HANDLE_VALUE) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Windows) CreateFileA failed for " << path
+                      << std::endl;
+            return;
+        }
+
+        if (mode != MappedFileMode::CREATE) {
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(hFile, &fileSize)) {
+                std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Windows) GetFileSizeEx failed for " << path
+                          << std::endl;
+                closeMappedFile();
+                return;
+            }
+            sizeBytes = static_cast<size_t>(fileSize.QuadPart);
+        }
+        if (sizeBytes == 0) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() Cannot map an empty file " << path << std::endl;
+            closeMappedFile();
+            return;
+        }
+
+        // A mapping larger than the file extends it (with zeros)
+        uint32_t lower = static_cast<uint32_t>(sizeBytes & 0xFFFFFFFF);
+        uint32_t upper = static_cast<uint32_t>((static_cast<uint64_t>(sizeBytes) >> 32) & 0xFFFFFFFF);
+        hFileMapping = CreateFileMappingA(hFile, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, upper, lower, NULL);
+        if (hFileMapping == NULL) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Windows) CreateFileMappingA returned NULL for "
+                      << path << std::endl;
+            closeMappedFile();
+            return;
+        }
+
+        pData = MapViewOfFile(hFileMapping, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, sizeBytes);
+        if (pData == nullptr) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Windows) MapViewOfFile returned nullptr for "
+                      << path << std::endl;
+            closeMappedFile();
+            return;
+        }
+
+#elif defined(__linux__)
+        int flags = writable ? O_RDWR : O_RDONLY;
+        if (mode == MappedFileMode::CREATE)
+            flags |= O_CREAT | O_TRUNC;
+        fd = open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd == -1) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Linux) open failed for " << path << std::endl;
+            return;
+        }
+
+        if (mode == MappedFileMode::CREATE) {
+            // posix_fallocate returns the error instead of setting errno
+            const int error = sizeBytes == 0 ? 0 : posix_fallocate(fd, 0, static_cast<off_t>(sizeBytes));
+            if (error != 0 && error != EOPNOTSUPP && error != EINVAL) {
+                std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Linux) could not reserve " << sizeBytes
+                          << " bytes for " << path << ": " << std::strerror(error) << std::endl;
+                closeMappedFile();
+                return;
+            }
+            // The filesystem cannot reserve blocks: fall back to a sparse file
+            if (error != 0 && ftruncate(fd, static_cast<off_t>(sizeBytes)) != 0) {
+                std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Linux) could not size " << path << " to "
+                          << sizeBytes << " bytes" << std::endl;
+                closeMappedFile();
+                return;
+            }
+        } else {
+            struct stat status;
+            if (fstat(fd, &status) != 0) {
+                std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Linux) fstat failed for " << path
+                          << std::endl;
+                closeMappedFile();
+                return;
+            }
+            sizeBytes = static_cast<size_t>(status.st_size);
+        }
+        if (sizeBytes == 0) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() Cannot map an empty file " << path << std::endl;
+            closeMappedFile();
+            return;
+        }
+
+        void* mapping = mmap(nullptr, sizeBytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "ERROR cpputils MappedFile::openMappedFile() (Linux) mmap failed for " << path << std::endl;
+            closeMappedFile();
+            return;
+        }
+        pData = mapping;
+#endif
+    }
+
+    //------------------------------------------------------------
+    // closeMappedFile()
+    //------------------------------------------------------------
+    void closeMappedFile()
+    {
+#if defined(_WIN32)
+        if (pData != nullptr) {
+            UnmapViewOfFile(pData);
+            pData = nullptr;
+        }
+
+        if (hFileMapping != NULL) {
+            CloseHandle(hFileMapping);
+            hFileMapping = NULL;
+        }
+
+        if (hFile != INVALID_HANDLE_VALUE) {
+            CloseHandle(hFile);
+            hFile = INVALID_HANDLE_VALUE;
+        }
+
+#elif defined(__linux__)
+        if (pData != nullptr) {
+            munmap(pData, sizeBytes);
+            pData = nullptr;
+        }
+
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+#endif
+    }
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_MAPPED_FILE_H
@@ -0,0 +1,289 @@
+#ifndef CPPUTILS_MPMC_QUEUE_H
+#define CPPUTILS_MPMC_QUEUE_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/EventCount.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class MpmcQueue
+//
+// Bounded lock-free queue for any number of producers and consumers
+// (Dmitry Vyukov's design). Each cell carries a sequence number that
+// says whose turn it is: a producer claims position p by CAS on the
+// enqueue index once cell p % capacity shows sequence p, writes the
+// value, and publishes sequence p + 1; a consumer claims p once the
+// sequence is p + 1 and hands the cell back with p + capacity. Producers
+// and consumers contend only on their own index, each on its own cache
+// line, and never on a lock.
+//
+// All cells are allocated once, in one AlignedBuffer, at construction.
+//
+// tryPush()/tryPop() never block. push()/pop() spin briefly, then park
+// on an EventCount per side, so a side that never sleeps only pays a
+// plain load per operation for waking the other. pushBatch()/popBatch()
+// claim a run of cells with one CAS.
+//------------------------------------------------------------
+template<typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(size_t requestedCapacity) :
+        mask(std::bit_ceil(std::max<size_t>(requestedCapacity, 2)) - 1),
+        storage(cellBytes(mask + 1), CELL_ALIGNMENT),
+        cells(static_cast<Cell*>(storage.buf))
+    {
+        if (cells == nullptr) {
+            std::cerr << "ERROR cpputils MpmcQueue::MpmcQueue() could not allocate " << capacity() << " cells"
+                      << std::endl;
+            return;
+        }
+        for (size_t i = 0; i <= mask; i++) {
+            ::new (static_cast<void*>(&cells[i])) Cell(i);
+        }
+    }
+
+    // No other thread may be using the queue
+    ~MpmcQueue()
+    {
+        if (cells == nullptr)
+            return;
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t enqueued = enqueuePosition.value.load(std::memory_order_acquire);
+            for (uint64_t position = dequeuePosition.value.load(std::memory_order_acquire); position != enqueued;
+                 position++) {
+                std::launder(reinterpret_cast<T*>(cells[position & mask].storage))->~T();
+            }
+        }
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].~Cell();
+        }
+    }
+
+    MpmcQueue(const MpmcQueue& other) = delete;
+    MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+    bool valid() const { return cells != nullptr; }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate while other threads are pushing or popping
+    size_t size() const
+    {
+        const uint64_t enqueued = enqueuePosition.value.load(std::memory_order_relaxed);
+        const uint64_t dequeued = dequeuePosition.value.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? static_cast<size_t>(enqueued - dequeued) : 0;
+    }
+
+    //------------------------------------------------------------
+    // Non-blocking
+    //------------------------------------------------------------
+    template<typename... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        uint64_t position = enqueuePosition.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const int64_t difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0) {
+                if (enqueuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false; // Full: the cell still holds the value from one lap ago
+            } else {
+                position = enqueuePosition.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        Cell& cell = cells[position & mask];
+        ::new (static_cast<void*>(cell.storage)) T(std::forward<Args>(args)...);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        wakeConsumers(1);
+        return true;
+    }
+
+    bool tryPush(const T& value) { return tryEmplace(value); }
+    bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+    bool tryPop(T& out)
+    {
+        uint64_t position = dequeuePosition.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const int64_t difference = static_cast<int64_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (dequeuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false; // Empty: no producer has published this position yet
+            } else {
+                position = dequeuePosition.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        takeValue(position, out);
+        wakeProducers(1);
+        return true;
+    }
+
+    // Pushes a leading run of `values` into consecutive cells with one CAS;
+    // returns how many (0 if the queue is full)
+    size_t pushBatch(std::span<const T> values)
+    {
+        if (values.empty())
+            return 0;
+
+        uint64_t position = enqueuePosition.value.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for (;;) {
+            // A cell that shows its turn stays ready until someone claims its position,
+            // which needs the enqueue index we are about to move
+            count = 0;
+            while (count < values.size()
+                   && cells[(position + count) & mask].sequence.load(std::memory_order_acquire) == position + count) {
+                count++;
+            }
+            if (count == 0) {
+                const uint64_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<int64_t>(sequence - position) < 0)
+                    return 0;
+                position = enqueuePosition.value.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueuePosition.value.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            Cell& cell = cells[(position + i) & mask];
+            ::new (static_cast<void*>(cell.storage)) T(values[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        wakeConsumers(count);
+        return count;
+    }
+
+    // Pops a run of up to out.size() consecutive values with one CAS; returns how many
+    size_t popBatch(std::span<T> out)
+    {
+        if (out.empty())
+            return 0;
+
+        uint64_t position = dequeuePosition.value.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for (;;) {
+            count = 0;
+            while (count < out.size()
+                   && cells[(position + count) & mask].sequence.load(std::memory_order_acquire)
+                          == position + count + 1) {
+                count++;
+            }
+            if (count == 0) {
+                const uint64_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<int64_t>(sequence - (position + 1)) < 0)
+                    return 0;
+                position = dequeuePosition.value.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeuePosition.value.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            takeValue(position + i, out[i]);
+        }
+        wakeProducers(count);
+        return count;
+    }
+
+    //------------------------------------------------------------
+    // Blocking
+    //------------------------------------------------------------
+    void push(const T& value)
+    {
+        producersSide.await([&]() { return tryPush(value); });
+    }
+
+    void push(T&& value)
+    {
+        producersSide.await([&]() { return tryPush(std::move(value)); });
+    }
+
+    T pop()
+    {
+        T value;
+        consumersSide.await([&]() { return tryPop(value); });
+        return value;
+    }
+
+    // Blocks until at least one value is available, then pops up to out.size()
+    size_t popBatchAtLeastOne(std::span<T> out)
+    {
+        size_t count = 0;
+        consumersSide.await([&]() { return (count = popBatch(out)) != 0; });
+        return count;
+    }
+
+private:
+    struct Cell
+    {
+        explicit Cell(uint64_t sequence) : sequence(sequence) {}
+
+        std::atomic<uint64_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Position
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    static constexpr size_t CELL_ALIGNMENT = std::max(alignof(Cell), CACHE_LINE_SIZE);
+
+    // aligned_alloc wants a multiple of the alignment
+    static size_t cellBytes(size_t capacity)
+    {
+        return (capacity * sizeof(Cell) + CELL_ALIGNMENT - 1) / CELL_ALIGNMENT * CELL_ALIGNMENT;
+    }
+
+    void takeValue(uint64_t position, T& out)
+    {
+        Cell& cell = cells[position & mask];
+        T* value = std::launder(reinterpret_cast<T*>(cell.storage));
+        out = std::move(*value);
+        value->~T();
+        cell.sequence.store(position + mask + 1, std::memory_order_release);
+    }
+
+    static uint32_t wakeCount(size_t count) { return static_cast<uint32_t>(std::min<size_t>(count, UINT32_MAX)); }
+
+    void wakeConsumers(size_t count) { consumersSide.notify(wakeCount(count)); }
+    void wakeProducers(size_t count) { producersSide.notify(wakeCount(count)); }
+
+    const uint64_t mask;
+    AlignedBuffer storage;
+    Cell* const cells;
+    Position enqueuePosition;
+    Position dequeuePosition;
+    EventCount producersSide; // Producers waiting for room
+    EventCount consumersSide; // Consumers waiting for values
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_MPMC_QUEUE_H
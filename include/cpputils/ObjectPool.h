@@ -0,0 +1,374 @@
+#ifndef CPPUTILS_OBJECT_POOL_H
+#define CPPUTILS_OBJECT_POOL_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/PerThread.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpputils {
+
+enum class ObjectPoolAlignment
+{
+    NATURAL,    // alignof(T), and at least a pointer
+    CACHE_LINE, // Every object starts on its own cache line
+};
+
+//------------------------------------------------------------
+// class ObjectPool
+//
+// Fixed-size allocator for one type of high-churn object, such as
+// messages that one thread allocates and another frees. Objects are
+// carved from slabs (AlignedBuffer) that are only returned to the
+// system when the pool is destroyed; allocate and free are O(1).
+//
+// Each thread keeps two magazines of up to BATCH_SIZE free slots (a
+// loaded one and a full spare), so most allocations and frees touch
+// only thread-local state. A thread that runs dry takes a whole batch
+// from the shared free list, and a thread whose magazines overflow
+// gives one back, which is how objects freed on a consumer thread
+// return to the producer. The shared list is a lock-free stack of
+// batches whose head is a 32-bit slot index plus a 32-bit tag bumped on
+// every change, so a stale compare-and-swap cannot succeed (ABA). A
+// mutex is taken only to carve fresh slots or add a slab.
+//
+// Free slots cached by a thread that exits stay in its magazines (a
+// new thread with the same id picks them up) unless it calls
+// flushThreadCache() first. Objects still alive when the pool is
+// destroyed are not destroyed.
+//------------------------------------------------------------
+template<typename T>
+class ObjectPool
+{
+public:
+    static constexpr size_t DEFAULT_OBJECTS_PER_SLAB = 1024;
+    static constexpr uint32_t BATCH_SIZE = 32;
+    static constexpr size_t MAX_SLABS = 1024;
+
+    // Each slab is rounded up to a power of two and filled, so it can hold more than `objectsPerSlab`
+    explicit ObjectPool(size_t objectsPerSlab = DEFAULT_OBJECTS_PER_SLAB,
+                        ObjectPoolAlignment alignment = ObjectPoolAlignment::NATURAL) :
+        slotAlignment(slotAlignmentFor(alignment)),
+        slotStride(roundUp(std::max(sizeof(T), sizeof(Slot)), slotAlignment))
+    {
+        objectsPerSlab = std::clamp<size_t>(objectsPerSlab, 1, MAX_OBJECTS_PER_SLAB);
+        slabBytes = std::bit_ceil(headerBytes(objectsPerSlab) + objectsPerSlab * slotStride);
+        while (objectsPerSlab < MAX_OBJECTS_PER_SLAB
+               && headerBytes(objectsPerSlab + 1) + (objectsPerSlab + 1) * slotStride <= slabBytes) {
+            objectsPerSlab++;
+        }
+        slotsPerSlab = static_cast<uint32_t>(objectsPerSlab);
+        slotsOffset = headerBytes(slotsPerSlab);
+    }
+
+    ObjectPool(const ObjectPool& other) = delete;
+    ObjectPool& operator=(const ObjectPool& other) = delete;
+    ObjectPool(ObjectPool&& other) noexcept = delete;
+    ObjectPool& operator=(ObjectPool&& other) noexcept = delete;
+
+    // Uninitialised storage for one T. nullptr if the system (or MAX_SLABS) is exhausted.
+    void* allocate()
+    {
+        Magazine& magazine = magazines.local();
+        if (magazine.loaded == nullptr && !refill(magazine)) [[unlikely]]
+            return nullptr;
+        Slot* slot = magazine.loaded;
+        magazine.loaded = slot->next;
+        magazine.loadedCount--;
+        increment(magazine.allocations);
+        return slot;
+    }
+
+    // `memory` must come from this pool's allocate(); any thread may free it
+    void deallocate(void* memory)
+    {
+        if (memory == nullptr)
+            return;
+        Magazine& magazine = magazines.local();
+        if (magazine.loadedCount == BATCH_SIZE) [[unlikely]] {
+            if (magazine.spare != nullptr)
+                pushBatch(magazine.spare, BATCH_SIZE);
+            magazine.spare = std::exchange(magazine.loaded, nullptr);
+            magazine.loadedCount = 0;
+        }
+        Slot* slot = static_cast<Slot*>(memory);
+        slot->next = magazine.loaded;
+        magazine.loaded = slot;
+        magazine.loadedCount++;
+        increment(magazine.frees);
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate();
+        if (memory == nullptr)
+            return nullptr;
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            return ::new (memory) T(std::forward<Args>(args)...);
+        } else {
+            try {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(memory);
+                throw;
+            }
+        }
+    }
+
+    void destroy(T* object)
+    {
+        if (object == nullptr)
+            return;
+        object->~T();
+        deallocate(object);
+    }
+
+    // Gives the calling thread's cached free slots back to the shared list, e.g. before the thread exits
+    void flushThreadCache()
+    {
+        Magazine& magazine = magazines.local();
+        if (magazine.spare != nullptr)
+            pushBatch(std::exchange(magazine.spare, nullptr), BATCH_SIZE);
+        if (magazine.loaded != nullptr)
+            pushBatch(std::exchange(magazine.loaded, nullptr), magazine.loadedCount);
+        magazine.loadedCount = 0;
+    }
+
+    // Objects allocated and not yet freed. Exact once the threads using the pool are quiescent.
+    uint64_t getLiveCount()
+    {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        magazines.forEach([&](const Magazine& magazine) {
+            allocations += magazine.allocations.load(std::memory_order_relaxed);
+            frees += magazine.frees.load(std::memory_order_relaxed);
+        });
+        return allocations - frees;
+    }
+
+    // Peak number of slots out of the shared list: live objects plus the ones cached in
+    // magazines, so at most 2 * BATCH_SIZE per thread above the live peak
+    uint64_t getHighWaterCount() const { return highWater.load(std::memory_order_relaxed); }
+
+    size_t getSlabCount() const { return slabCount.load(std::memory_order_acquire); }
+    size_t getObjectsPerSlab() const { return slotsPerSlab; }
+    size_t getCapacity() const { return getSlabCount() * slotsPerSlab; }
+    size_t getObjectStride() const { return slotStride; }
+
+private:
+    static constexpr size_t MAX_OBJECTS_PER_SLAB = (size_t{1} << 32) / MAX_SLABS - 1;
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    // A free slot; the link lives in the object's own storage
+    struct Slot
+    {
+        Slot* next;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Magazine
+    {
+        Slot* loaded{nullptr};
+        uint32_t loadedCount{0};
+        Slot* spare{nullptr}; // nullptr or exactly BATCH_SIZE slots
+        // Written only by the owning thread; read by getLiveCount()
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+    };
+
+    // At the start of every slab. A slot's shared-list link lives here rather than in the
+    // slot, since a thread reading a stale head may read the link of a slot in use.
+    struct SlabHeader
+    {
+        uint32_t index;
+    };
+
+    // Shared-list link of a batch's first slot: the next batch's first slot and this batch's size
+    static uint64_t packLink(uint32_t next, uint32_t count) { return (uint64_t{count} << 32) | next; }
+    // Shared-list head: the first slot and a tag bumped on every change
+    static uint64_t packHead(uint32_t slot, uint32_t tag) { return (uint64_t{tag} << 32) | slot; }
+
+    static constexpr size_t roundUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // The shared-list links follow the slab header
+    static constexpr size_t LINKS_OFFSET = roundUp(sizeof(SlabHeader), alignof(std::atomic<uint64_t>));
+
+    static size_t slotAlignmentFor(ObjectPoolAlignment alignment)
+    {
+        const size_t minimum = alignment == ObjectPoolAlignment::CACHE_LINE ? CACHE_LINE_SIZE : alignof(Slot);
+        return std::max(alignof(T), minimum);
+    }
+
+    // Tag for the shared-list head that replaces `head`
+    static uint32_t nextTag(uint64_t head) { return static_cast<uint32_t>(head >> 32) + 1; }
+
+    static void increment(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    size_t headerBytes(size_t slots) const
+    {
+        return roundUp(LINKS_OFFSET + slots * sizeof(std::atomic<uint64_t>), slotAlignment);
+    }
+
+    std::atomic<uint64_t>* links(char* slab) const
+    {
+        return std::launder(reinterpret_cast<std::atomic<uint64_t>*>(slab + LINKS_OFFSET));
+    }
+
+    // Slabs are aligned to their own power-of-two size, so a slot finds its slab by masking
+    uint32_t indexOf(const Slot* slot) const
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(slot);
+        char* slab = reinterpret_cast<char*>(address & ~(slabBytes - 1));
+        const size_t offset = (address - reinterpret_cast<uintptr_t>(slab) - slotsOffset) / slotStride;
+        return static_cast<uint32_t>(reinterpret_cast<SlabHeader*>(slab)->index * slotsPerSlab + offset);
+    }
+
+    char* slabOf(uint32_t index) const { return slabs[index / slotsPerSlab].load(std::memory_order_acquire); }
+
+    Slot* slotAt(char* slab, uint32_t index) const
+    {
+        return reinterpret_cast<Slot*>(slab + slotsOffset + (index % slotsPerSlab) * slotStride);
+    }
+
+    void addOutstanding(int64_t count)
+    {
+        const uint64_t current = outstanding.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed) + count;
+        uint64_t peak = highWater.load(std::memory_order_relaxed);
+        while (current > peak && !highWater.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+    }
+
+    void pushBatch(Slot* first, uint32_t count)
+    {
+        const uint32_t index = indexOf(first);
+        std::atomic<uint64_t>& link = links(slabOf(index))[index % slotsPerSlab];
+        uint64_t head = freeBatches.load(std::memory_order_relaxed);
+        do {
+            link.store(packLink(static_cast<uint32_t>(head), count), std::memory_order_relaxed);
+        } while (!freeBatches.compare_exchange_weak(head, packHead(index, nextTag(head)), std::memory_order_release,
+                                                    std::memory_order_relaxed));
+        addOutstanding(-static_cast<int64_t>(count));
+    }
+
+    bool popBatch(Magazine& magazine)
+    {
+        uint64_t head = freeBatches.load(std::memory_order_acquire);
+        uint64_t link = 0;
+        do {
+            const uint32_t index = static_cast<uint32_t>(head);
+            if (index == NO_SLOT)
+                return false;
+            // May read the link of a batch popped meanwhile; the tag then fails the CAS
+            link = links(slabOf(index))[index % slotsPerSlab].load(std::memory_order_relaxed);
+        } while (!freeBatches.compare_exchange_weak(head, packHead(static_cast<uint32_t>(link), nextTag(head)),
+                                                    std::memory_order_acquire, std::memory_order_acquire));
+        const uint32_t index = static_cast<uint32_t>(head);
+        magazine.loaded = slotAt(slabOf(index), index);
+        magazine.loadedCount = static_cast<uint32_t>(link >> 32);
+        addOutstanding(magazine.loadedCount);
+        return true;
+    }
+
+    // Slow path: the loaded magazine is empty
+    bool refill(Magazine& magazine)
+    {
+        if (magazine.spare != nullptr) {
+            magazine.loaded = std::exchange(magazine.spare, nullptr);
+            magazine.loadedCount = BATCH_SIZE;
+            return true;
+        }
+        if (popBatch(magazine))
+            return true;
+
+        std::lock_guard<std::mutex> lock(growMutex);
+        if (popBatch(magazine)) // Freed by another thread while this one waited
+            return true;
+        if (slabCount.load(std::memory_order_relaxed) == 0 || carved == slotsPerSlab) {
+            if (!addSlab())
+                return false;
+        }
+
+        // Carve the next slots of the newest slab into a chain
+        char* slab = static_cast<char*>(slabBuffers.back().buf);
+        const uint32_t count = std::min(BATCH_SIZE, slotsPerSlab - carved);
+        Slot* first = nullptr;
+        for (uint32_t i = count; i-- > 0;) {
+            Slot* slot = reinterpret_cast<Slot*>(slab + slotsOffset + (carved + i) * slotStride);
+            slot->next = first;
+            first = slot;
+        }
+        carved += count;
+        magazine.loaded = first;
+        magazine.loadedCount = count;
+        addOutstanding(count);
+        return true;
+    }
+
+    // Called with growMutex held
+    bool addSlab()
+    {
+        const size_t index = slabBuffers.size();
+        if (index == MAX_SLABS) {
+            std::cerr << "ERROR cpputils ObjectPool::allocate() reached the limit of " << MAX_SLABS << " slabs"
+                      << std::endl;
+            return false;
+        }
+        AlignedBuffer slab(slabBytes, slabBytes);
+        if (slab.buf == nullptr) {
+            std::cerr << "ERROR cpputils ObjectPool::allocate() could not allocate a slab of " << slabBytes << " bytes"
+                      << std::endl;
+            return false;
+        }
+        char* base = static_cast<char*>(slab.buf);
+        ::new (base) SlabHeader{static_cast<uint32_t>(index)};
+        char* slabLinks = base + LINKS_OFFSET;
+        for (uint32_t i = 0; i < slotsPerSlab; i++) {
+            ::new (slabLinks + i * sizeof(std::atomic<uint64_t>)) std::atomic<uint64_t>(0);
+        }
+
+        slabBuffers.push_back(std::move(slab));
+        slabs[index].store(base, std::memory_order_release);
+        slabCount.store(index + 1, std::memory_order_release);
+        carved = 0;
+        return true;
+    }
+
+    const size_t slotAlignment;
+    const size_t slotStride;
+    size_t slabBytes{0};
+    size_t slotsOffset{0};
+    uint32_t slotsPerSlab{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> freeBatches{packHead(NO_SLOT, 0)};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> outstanding{0};
+    std::atomic<uint64_t> highWater{0};
+    std::atomic<size_t> slabCount{0};
+    std::array<std::atomic<char*>, MAX_SLABS> slabs{};
+
+    std::mutex growMutex;
+    std::vector<AlignedBuffer> slabBuffers;
+    uint32_t carved{0}; // Slots of the newest slab handed out so far
+
+    PerThread<Magazine> magazines;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_OBJECT_POOL_H
@@ -0,0 +1,120 @@
+#ifndef CPPUTILS_PER_THREAD_H
+#define CPPUTILS_PER_THREAD_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class PerThread
+//
+// One lazily created T per (PerThread object, thread) pair. local()
+// resolves the calling thread's instance through a small thread_local
+// cache, so the common path is a compare and a load with no locking.
+// The first call from a thread takes a mutex and registers a new
+// instance. forEach() visits every registered instance under that
+// same mutex, which is how readers aggregate the per-thread state.
+//
+// Instances live until the PerThread is destroyed, so data recorded by
+// threads that have since exited is still visited by forEach(). A new
+// thread that is handed a recycled std::thread::id inherits the
+// instance of the exited thread that held it.
+//------------------------------------------------------------
+template<typename T>
+class PerThread
+{
+public:
+    PerThread() : PerThread([]() { return std::make_unique<T>(); }) {}
+
+    explicit PerThread(std::function<std::unique_ptr<T>()> factory) : factory(std::move(factory)) {}
+
+    PerThread(const PerThread& other) = delete;
+    PerThread& operator=(const PerThread& other) = delete;
+    PerThread(PerThread&& other) noexcept = delete;
+    PerThread& operator=(PerThread&& other) noexcept = delete;
+
+    T& local()
+    {
+        CacheEntry& entry = threadCache()[id % CACHE_SIZE];
+        if (entry.ownerId == id) [[likely]]
+            return *static_cast<T*>(entry.instance);
+
+        T& instance = findOrRegister();
+        entry.ownerId = id;
+        entry.instance = &instance;
+        return instance;
+    }
+
+    template<typename Func>
+    void forEach(Func&& func)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Registration& registration : registrations) {
+            func(*registration.instance);
+        }
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return registrations.size();
+    }
+
+private:
+    static constexpr size_t CACHE_SIZE = 16;
+
+    struct CacheEntry
+    {
+        uint64_t ownerId{0};
+        void* instance{nullptr};
+    };
+
+    struct Registration
+    {
+        std::thread::id threadId;
+        std::unique_ptr<T> instance;
+    };
+
+    // Shared by every PerThread<T> with the same T. Owner ids are never reused,
+    // so a stale entry left by a destroyed owner can never match again.
+    static std::array<CacheEntry, CACHE_SIZE>& threadCache()
+    {
+        thread_local std::array<CacheEntry, CACHE_SIZE> cache{};
+        return cache;
+    }
+
+    static uint64_t nextOwnerId()
+    {
+        static std::atomic<uint64_t> nextId{1};
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    T& findOrRegister()
+    {
+        const std::thread::id threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Registration& registration : registrations) {
+            if (registration.threadId == threadId)
+                return *registration.instance;
+        }
+        registrations.push_back({threadId, factory()});
+        return *registrations.back().instance;
+    }
+
+    const uint64_t id{nextOwnerId()};
+    std::function<std::unique_ptr<T>()> factory;
+    std::mutex mutex;
+    std::vector<Registration> registrations;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_PER_THREAD_H
@@ -0,0 +1,359 @@
+#ifndef CPPUTILS_PERF_COUNTERS_H
+#define CPPUTILS_PERF_COUNTERS_H
+
+#include "cpputils/Timer.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// enum class PerfEvent
+//------------------------------------------------------------
+enum class PerfEvent : uint8_t
+{
+    CYCLES,
+    INSTRUCTIONS,
+    BRANCH_MISSES,
+    L1D_READ_MISSES,
+    LLC_MISSES,
+    PAGE_FAULTS,
+    CONTEXT_SWITCHES,
+    COUNT
+};
+
+constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+inline const char* perfEventName(PerfEvent event)
+{
+    switch (event) {
+        case PerfEvent::CYCLES: return "cycles";
+        case PerfEvent::INSTRUCTIONS: return "instructions";
+        case PerfEvent::BRANCH_MISSES: return "branch-misses";
+        case PerfEvent::L1D_READ_MISSES: return "L1d-misses";
+        case PerfEvent::LLC_MISSES: return "LLC-misses";
+        case PerfEvent::PAGE_FAULTS: return "page-faults";
+        case PerfEvent::CONTEXT_SWITCHES: return "context-switches";
+        default: return "unknown";
+    }
+}
+
+//------------------------------------------------------------
+// struct PerfCounterValues
+//
+// One reading (or the difference of two) of every event in a group.
+// Events the kernel or hardware refused are marked unavailable and
+// read as 0. Values are already scaled for multiplexing.
+//------------------------------------------------------------
+struct PerfCounterValues
+{
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+    std::array<bool, PERF_EVENT_COUNT> available{};
+
+    uint64_t get(PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+
+    bool isAvailable(PerfEvent event) const { return available[static_cast<size_t>(event)]; }
+
+    // Instructions per cycle, 0 when either counter is unavailable
+    double getIpc() const
+    {
+        if (!isAvailable(PerfEvent::CYCLES) || !isAvailable(PerfEvent::INSTRUCTIONS) || get(PerfEvent::CYCLES) == 0)
+            return 0.0;
+        return static_cast<double>(get(PerfEvent::INSTRUCTIONS)) / static_cast<double>(get(PerfEvent::CYCLES));
+    }
+
+    PerfCounterValues operator-(const PerfCounterValues& other) const
+    {
+        PerfCounterValues result;
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            result.available[i] = available[i] && other.available[i];
+            result.values[i] = result.available[i] && values[i] > other.values[i] ? values[i] - other.values[i] : 0;
+        }
+        return result;
+    }
+
+    PerfCounterValues& operator+=(const PerfCounterValues& other)
+    {
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            values[i] += other.values[i];
+            available[i] = available[i] || other.available[i];
+        }
+        return *this;
+    }
+
+    // "cycles=123 instructions=456 ipc=3.70 ..." with "n/a" for unavailable events
+    void print(std::ostream& ostream, uint64_t operations = 1) const
+    {
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            ostream << (i == 0 ? "" : " ") << perfEventName(static_cast<PerfEvent>(i)) << '=';
+            if (!available[i]) {
+                ostream << "n/a";
+            } else if (operations > 1) {
+                ostream << static_cast<double>(values[i]) / static_cast<double>(operations) << "/op";
+            } else {
+                ostream << values[i];
+            }
+        }
+        if (getIpc() > 0.0)
+            ostream << " ipc=" << getIpc();
+    }
+};
+
+//------------------------------------------------------------
+// class PerfCounterGroup
+//
+// Hardware PMU counters for the calling thread, opened with
+// perf_event_open as one group so a single read() returns every event
+// consistently. User-space only (kernel and hypervisor excluded).
+//
+// Each event is opened on its own, so one the CPU lacks (LLC misses
+// in many VMs) only marks that event unavailable. When nothing can be
+// opened (perf_event_paranoid > 2, seccomp in containers, no PMU, not
+// Linux) valid() is false, getUnavailableReason() says why, and reads
+// return all-unavailable values rather than failing.
+//
+// Counters follow the thread that created the group; read them from
+// that thread.
+//------------------------------------------------------------
+class PerfCounterGroup
+{
+public:
+    PerfCounterGroup()
+    {
+#if defined(__linux__)
+        struct EventConfig
+        {
+            uint32_t type;
+            uint64_t config;
+        };
+        constexpr uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                           | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        constexpr std::array<EventConfig, PERF_EVENT_COUNT> configs{{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, L1D_READ_MISS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+        }};
+
+        int firstErrno = 0;
+        for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = configs[i].type;
+            attr.config = configs[i].config;
+            attr.disabled = leaderFd == -1 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED
+                               | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leaderFd, 0));
+            if (fd == -1) {
+                firstErrno = firstErrno == 0 ? errno : firstErrno;
+                continue;
+            }
+
+            fds[i] = fd;
+            ioctl(fd, PERF_EVENT_IOC_ID, &ids[i]);
+            if (leaderFd == -1)
+                leaderFd = fd;
+        }
+
+        if (leaderFd == -1) {
+            unavailableReason = std::string("perf_event_open failed: ") + std::strerror(firstErrno)
+                                + " (check /proc/sys/kernel/perf_event_paranoid and container seccomp policy)";
+            return;
+        }
+
+        ioctl(leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+        unavailableReason = "hardware performance counters are only supported on Linux";
+#endif
+    }
+
+    ~PerfCounterGroup()
+    {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd != -1)
+                close(fd);
+        }
+#endif
+    }
+
+    PerfCounterGroup(const PerfCounterGroup& other) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup& other) = delete;
+    PerfCounterGroup(PerfCounterGroup&& other) noexcept = delete;
+    PerfCounterGroup& operator=(PerfCounterGroup&& other) noexcept = delete;
+
+    // Lazily opened group for the calling thread, shared by scoped helpers
+    static PerfCounterGroup& threadLocal()
+    {
+        thread_local PerfCounterGroup group;
+        return group;
+    }
+
+    bool valid() const { return leaderFd != -1; }
+
+    bool isAvailable(PerfEvent event) const { return fds[static_cast<size_t>(event)] != -1; }
+
+    const std::string& getUnavailableReason() const { return unavailableReason; }
+
+    // Running totals since the group was opened; subtract two reads for a region
+    PerfCounterValues read() const
+    {
+        PerfCounterValues result;
+#if defined(__linux__)
+        if (leaderFd == -1)
+            return result;
+
+        // { nr, time_enabled, time_running, { value, id }[nr] }
+        std::array<uint64_t, 3 + 2 * PERF_EVENT_COUNT> buffer{};
+        if (::read(leaderFd, buffer.data(), sizeof(buffer)) <= 0)
+            return result;
+
+        const uint64_t count = buffer[0] < PERF_EVENT_COUNT ? buffer[0] : PERF_EVENT_COUNT;
+        const uint64_t enabled = buffer[1];
+        const uint64_t running = buffer[2];
+        for (uint64_t n = 0; n < count; n++) {
+            const uint64_t value = buffer[3 + 2 * n];
+            const uint64_t id = buffer[4 + 2 * n];
+            for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+                if (fds[i] == -1 || ids[i] != id)
+                    continue;
+
+                // Scale up when the PMU was shared with other groups (multiplexing)
+                result.values[i] = running != 0 && running < enabled
+                                       ? static_cast<uint64_t>(static_cast<double>(value) * enabled / running)
+                                       : value;
+                result.available[i] = true;
+            }
+        }
+#endif
+        return result;
+    }
+
+private:
+    int leaderFd{-1};
+    std::array<int, PERF_EVENT_COUNT> fds{-1, -1, -1, -1, -1, -1, -1};
+    std::array<uint64_t, PERF_EVENT_COUNT> ids{};
+    std::string unavailableReason;
+};
+
+//------------------------------------------------------------
+// class ScopePrintPerfCounters
+//
+// ScopePrintTimer that also prints the counter deltas of its scope:
+// "<prefix><duration> cycles=... instructions=... ipc=...".
+//------------------------------------------------------------
+template<Clock clockType, ChronoDuration durationType>
+class ScopePrintPerfCounters
+{
+public:
+    ScopePrintPerfCounters(const std::string& printoutPrefix,
+                           std::ostream& ostream = std::cout,
+                           PerfCounterGroup& group = PerfCounterGroup::threadLocal()) :
+        _printoutPrefix(printoutPrefix), _ostream(ostream), _group(group), _startValues(group.read()),
+        _startTime(clockType::now())
+    {}
+
+    ~ScopePrintPerfCounters()
+    {
+        const typename clockType::time_point endTime = clockType::now();
+        const PerfCounterValues delta = _group.read() - _startValues;
+
+        _ostream << _printoutPrefix << std::chrono::duration_cast<durationType>(endTime - _startTime).count() << ' ';
+        delta.print(_ostream);
+        _ostream << std::endl;
+    }
+
+private:
+    const std::string _printoutPrefix;
+    std::ostream& _ostream;
+    PerfCounterGroup& _group;
+    const PerfCounterValues _startValues;
+    const typename clockType::time_point _startTime;
+};
+
+//------------------------------------------------------------
+// class PerfStats
+//
+// StatsTimer counterpart: accumulates wall time and counter deltas over
+// repeated start()/stop() pairs, for reporting per-operation costs
+// (instructions/op, misses/op) and IPC next to the average duration.
+//------------------------------------------------------------
+template<Clock clockType>
+class PerfStats
+{
+public:
+    PerfStats(PerfCounterGroup& group = PerfCounterGroup::threadLocal()) : group(group) {}
+
+    void reset()
+    {
+        totals = PerfCounterValues();
+        totalTime = std::chrono::nanoseconds(0);
+        operations = 0;
+    }
+
+    void start()
+    {
+        startValues = group.read();
+        lastMeasuredTime = clockType::now();
+    }
+
+    // `operationCount` is how many operations the measured region performed
+    void stop(uint64_t operationCount = 1)
+    {
+        totalTime += std::chrono::duration_cast<std::chrono::nanoseconds>(clockType::now() - lastMeasuredTime);
+        totals += group.read() - startValues;
+        operations += operationCount;
+    }
+
+    bool valid() const { return group.valid(); }
+
+    uint64_t getOperationCount() const { return operations; }
+
+    int64_t getAvgTimeNs() const { return operations == 0 ? 0 : totalTime.count() / static_cast<int64_t>(operations); }
+
+    // Average count of `event` per operation, 0 when unavailable
+    double getPerOp(PerfEvent event) const
+    {
+        if (operations == 0 || !totals.isAvailable(event))
+            return 0.0;
+        return static_cast<double>(totals.get(event)) / static_cast<double>(operations);
+    }
+
+    double getIpc() const { return totals.getIpc(); }
+
+    const PerfCounterValues& getTotals() const { return totals; }
+
+private:
+    PerfCounterGroup& group;
+    clockType::time_point lastMeasuredTime{};
+    PerfCounterValues startValues;
+    PerfCounterValues totals;
+    std::chrono::nanoseconds totalTime{0};
+    uint64_t operations{0};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_PERF_COUNTERS_H
@@ -1,10 +1,16 @@
 #ifndef CPPUTILS_RANGE_METER_H
 #define CPPUTILS_RANGE_METER_H
 
+#include "cpputils/Seqlock.h"
+
 #include <iostream>
 #include <thread>
+#include <atomic>
 #include <chrono>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <format>
 #include <algorithm>
@@ -42,14 +48,21 @@ namespace rangemeter {
     constexpr const char* ANSI_CLEAR_AND_CR = "\x1b[2K\r";
     constexpr size_t      ANSI_CLEAR_AND_CR_LEN = 6;
 
+// Written by the caller, read by the print thread as one snapshot
+struct RangeMeterValues
+{
+    double min                      { 0.0 };
+    double max                      { 0.0 };
+    double current                  { 0.0 };
+};
+
 struct RangeMeter
 {
     std::string string{};
 
     std::string title;
-    double min                      { 0.0 };
-    double max                      { 0.0 };
-    double current                  { 0.0 };
+    Seqlock<RangeMeterValues> values{};
+    RangeMeterValues drawn          {};     // Snapshot the string shows; print thread only
     double yellowPercent            { 0.4 };
     double redPercent               { 0.7 };
     double bluePercent              { 0.995 };
@@ -70,7 +83,7 @@ struct RangeMeter
 
     // Threading state
     size_t printThreadSleepMs       { 50 };
-    bool printThreadRunFlag         { false };
+    bool printThreadRunFlag         { false };  // Accessed through std::atomic_ref
     std::thread printThread         {};
 };
 
@@ -120,7 +133,7 @@ void buildString(RangeMeter& rangeMeter)
     size_t stringSize = 0;
     stringSize += rangeMeter.title.size();                  // Title
     stringSize += 1;                                        // ' '
-    stringSize += getRequiredCharCount(rangeMeter.min);     // Number of slots for min
+    stringSize += getRequiredCharCount(rangeMeter.drawn.min);     // Number of slots for min
     stringSize += 1;                                        // '['
     stringSize += ANSI_GREEN_LEN;                           // len(ANSI_GREEN)
     stringSize += rangeMeter.greenPipsCount;                // Green pips
@@ -132,9 +145,9 @@ void buildString(RangeMeter& rangeMeter)
     stringSize += rangeMeter.bluePipsCount;                 // Blue pips
     stringSize += ANSI_RESET_LEN;                           // len(ANSI_RESET)
     stringSize += 2;                                        // '] '
-    stringSize += getRequiredCharCount(rangeMeter.max);     // Number of slots for max
+    stringSize += getRequiredCharCount(rangeMeter.drawn.max);     // Number of slots for max
     stringSize += 1;                                        // ' '
-    stringSize += getRequiredCharCount(rangeMeter.max) + 6; // Assume (max+6) is a reasonable width for the current value.
+    stringSize += getRequiredCharCount(rangeMeter.drawn.max) + 6; // Assume (max+6) is a reasonable width for the current value.
                                                             // If you're exceeding by 6 orders of magnitude, we'll assume
                                                             // it's not our problem to display it correctly. (to_chars is safe)
 
@@ -153,8 +166,8 @@ void buildString(RangeMeter& rangeMeter)
     rangeMeter.string[offset] = ' ';
     offset++;
 
-    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.min);
-    offset += getRequiredCharCount(rangeMeter.min);
+    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.drawn.min);
+    offset += getRequiredCharCount(rangeMeter.drawn.min);
 
     rangeMeter.string[offset] = '[';
     offset++;
@@ -200,15 +213,15 @@ void buildString(RangeMeter& rangeMeter)
     rangeMeter.string[offset] = ']';
     offset++;
 
-    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.max);
-    offset += getRequiredCharCount(rangeMeter.max);
+    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.drawn.max);
+    offset += getRequiredCharCount(rangeMeter.drawn.max);
 
     rangeMeter.string[offset] = ' ';
     offset++;
 
     rangeMeter.currentValOffset = offset;
-    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.current);
-    offset += getRequiredCharCount(rangeMeter.current);
+    writeDoubleToStringWithOffset(rangeMeter.string, offset, rangeMeter.drawn.current);
+    offset += getRequiredCharCount(rangeMeter.drawn.current);
 }
 
 void updateString(RangeMeter& rangeMeter)
@@ -220,8 +233,9 @@ void updateString(RangeMeter& rangeMeter)
     memset(rangeMeter.string.data() + rangeMeter.bluePipsOffset,   ' ', rangeMeter.bluePipsCount);
     memset(rangeMeter.string.data() + rangeMeter.currentValOffset, ' ', rangeMeter.string.size() - rangeMeter.currentValOffset);
 
-    const double clamped = std::clamp(rangeMeter.current, rangeMeter.min, rangeMeter.max);
-    const double percent = (clamped - rangeMeter.min) / (rangeMeter.max - rangeMeter.min);
+    const RangeMeterValues& drawn = rangeMeter.drawn;
+    const double clamped = std::clamp(drawn.current, drawn.min, drawn.max);
+    const double percent = (clamped - drawn.min) / (drawn.max - drawn.min);
 
     auto getPercentInRange = [](const double percent, const double rangeMin, const double rangeMax)
         {
@@ -239,7 +253,7 @@ void updateString(RangeMeter& rangeMeter)
     memset(rangeMeter.string.data() + rangeMeter.redPipsOffset,    '=', filledRed);
     memset(rangeMeter.string.data() + rangeMeter.bluePipsOffset,   '=', filledBlue);
 
-    writeDoubleToStringWithOffset(rangeMeter.string, rangeMeter.currentValOffset, rangeMeter.current);
+    writeDoubleToStringWithOffset(rangeMeter.string, rangeMeter.currentValOffset, rangeMeter.drawn.current);
 }
 
 RangeMeter create(const std::string& title, const double min, const double max, const double yellowPercent = 0.4, const double redPercent = 0.7, const size_t pipsCount = 50)
@@ -268,8 +282,8 @@ RangeMeter create(const std::string& title, const double min, const double max,
     RangeMeter rangeMeter;
 
     rangeMeter.title = title;
-    rangeMeter.min = min;
-    rangeMeter.max = max;
+    rangeMeter.drawn = RangeMeterValues{ min, max, min };
+    rangeMeter.values.store(rangeMeter.drawn);
     rangeMeter.yellowPercent = yellowPercent;
     rangeMeter.redPercent = redPercent;
     rangeMeter.pipsCount = pipsCount;
@@ -279,15 +293,40 @@ RangeMeter create(const std::string& title, const double min, const double max,
     return rangeMeter;
 }
 
+// Safe to call while the print thread runs
+void setValue(RangeMeter& rangeMeter, const double current)
+{
+    rangeMeter.values.update([current](RangeMeterValues values) {
+        values.current = current;
+        return values;
+    });
+}
+
+// Safe to call while the print thread runs; the bar is re-laid out for the new range
+void setRange(RangeMeter& rangeMeter, const double min, const double max)
+{
+    rangeMeter.values.update([min, max](RangeMeterValues values) {
+        values.min = min;
+        values.max = max;
+        return values;
+    });
+}
+
 void startThread(RangeMeter& rangeMeter)
 {
     if (!rangeMeter.printThread.joinable()) {
-        rangeMeter.printThreadRunFlag = true;
+        std::atomic_ref<bool>(rangeMeter.printThreadRunFlag).store(true, std::memory_order_relaxed);
         rangeMeter.printThread = std::thread([&rangeMeter]() {
             std::cout << ANSI_HIDE_CURSOR;
-            while (rangeMeter.printThreadRunFlag) {
+            while (std::atomic_ref<bool>(rangeMeter.printThreadRunFlag).load(std::memory_order_relaxed)) {
                 // MULTIRANGE
-                // Update range meter
+                // Take a consistent snapshot and update range meter
+                const RangeMeterValues latest = rangeMeter.values.load();
+                const bool relayout = latest.min != rangeMeter.drawn.min || latest.max != rangeMeter.drawn.max;
+                rangeMeter.drawn = latest;
+                if (relayout) {
+                    buildString(rangeMeter);
+                }
                 updateString(rangeMeter);
 
 #ifdef _WIN32
@@ -323,7 +362,7 @@ void startThread(RangeMeter& rangeMeter)
 void stopThread(RangeMeter& rangeMeter)
 {
     if (rangeMeter.printThread.joinable()) {
-        rangeMeter.printThreadRunFlag = false;
+        std::atomic_ref<bool>(rangeMeter.printThreadRunFlag).store(false, std::memory_order_relaxed);
         rangeMeter.printThread.join();
     }
 }
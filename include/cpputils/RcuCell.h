@@ -0,0 +1,220 @@
+#ifndef CPPUTILS_RCU_CELL_H
+#define CPPUTILS_RCU_CELL_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/EpochReclamation.h"
+#include "cpputils/WaitFreeCounter.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace cpputils {
+
+// Domain shared by RcuCells that are not given one. Never destroyed, so an
+// RcuRef released during static destruction can still retire its version.
+inline EpochDomain& defaultRcuDomain()
+{
+    static EpochDomain* domain = new EpochDomain();
+    return *domain;
+}
+
+namespace detail {
+
+// One published value. The cell holds one reference while the version is
+// current and each RcuRef holds one; the Counter's sticky zero means a
+// version that has been dropped cannot be re-acquired, and is retired to
+// the epoch domain by whichever release reached zero.
+template<typename T>
+struct RcuVersion
+{
+    template<typename... Args>
+    explicit RcuVersion(EpochDomain& domain, Args&&... args) : value(std::forward<Args>(args)...), domain(domain)
+    {}
+
+    void release()
+    {
+        if (refs.decrement())
+            domain.retire(this);
+    }
+
+    T value;
+    Counter refs;
+    EpochDomain& domain;
+};
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class RcuSnapshot
+//
+// Short-lived read access to one version of an RcuCell. Holds an
+// EpochGuard, so the version stays valid until the snapshot is
+// destroyed, and costs the reader no shared write. Keep it as short as a
+// lock: an open snapshot delays reclamation of every retired version.
+//------------------------------------------------------------
+template<typename T>
+class RcuSnapshot
+{
+public:
+    RcuSnapshot(const RcuSnapshot& other) = delete;
+    RcuSnapshot& operator=(const RcuSnapshot& other) = delete;
+
+    const T& operator*() const { return version->value; }
+    const T* operator->() const { return &version->value; }
+    const T& get() const { return version->value; }
+
+private:
+    template<typename U>
+    friend class RcuCell;
+
+    RcuSnapshot(EpochDomain& domain, const std::atomic<detail::RcuVersion<T>*>& current) :
+        guard(domain), version(current.load(std::memory_order_acquire))
+    {}
+
+    EpochGuard guard;
+    const detail::RcuVersion<T>* version;
+};
+
+//------------------------------------------------------------
+// class RcuRef
+//
+// Counted reference to one version of an RcuCell, for holding a value
+// across blocking calls or handing it to another thread. Taking one
+// costs a single atomic increment on the version; it does not hold back
+// reclamation of other versions.
+//------------------------------------------------------------
+template<typename T>
+class RcuRef
+{
+public:
+    RcuRef() {}
+
+    RcuRef(const RcuRef& other) : version(other.version)
+    {
+        if (version != nullptr)
+            version->refs.increment_if_not_zero();
+    }
+
+    RcuRef(RcuRef&& other) noexcept : version(std::exchange(other.version, nullptr)) {}
+
+    ~RcuRef() { reset(); }
+
+    RcuRef& operator=(RcuRef other) noexcept
+    {
+        std::swap(version, other.version);
+        return *this;
+    }
+
+    void reset()
+    {
+        if (version != nullptr)
+            std::exchange(version, nullptr)->release();
+    }
+
+    const T& operator*() const { return version->value; }
+    const T* operator->() const { return &version->value; }
+    const T& get() const { return version->value; }
+    explicit operator bool() const { return version != nullptr; }
+
+private:
+    template<typename U>
+    friend class RcuCell;
+
+    // Adopts a reference the caller already took
+    explicit RcuRef(detail::RcuVersion<T>* version) : version(version) {}
+
+    detail::RcuVersion<T>* version{nullptr};
+};
+
+//------------------------------------------------------------
+// class RcuCell
+//
+// Read-mostly value (configuration, routing tables) with readers that
+// never block and never write shared memory. Writers build a complete
+// new version and publish it with one pointer swap; readers see either
+// the old or the new version, never a mix.
+//
+//   read()    - RcuSnapshot, an epoch guard plus one load
+//   acquire() - RcuRef, for values held for a long time
+//   store() / update() - publish a new version; writers are serialised
+//
+// A replaced version is retired to the EpochDomain once its last RcuRef
+// is gone, and freed after a grace period: when every snapshot that
+// could see it has closed. Each publish also runs one reclamation pass,
+// so rarely updated cells do not wait for a full retire batch.
+//
+// The domain must outlive the cell and every RcuRef taken from it.
+//------------------------------------------------------------
+template<typename T>
+class RcuCell
+{
+public:
+    template<typename... Args>
+    explicit RcuCell(EpochDomain& domain, std::in_place_t, Args&&... args) :
+        domain(domain), current(new detail::RcuVersion<T>(domain, std::forward<Args>(args)...))
+    {}
+
+    explicit RcuCell(T initial = T(), EpochDomain& domain = defaultRcuDomain()) :
+        RcuCell(domain, std::in_place, std::move(initial))
+    {}
+
+    RcuCell(const RcuCell& other) = delete;
+    RcuCell& operator=(const RcuCell& other) = delete;
+
+    // Readers must be done; outstanding RcuRefs keep their version alive
+    ~RcuCell() { current.load(std::memory_order_relaxed)->release(); }
+
+    RcuSnapshot<T> read() const { return RcuSnapshot<T>(domain, current); }
+
+    RcuRef<T> acquire() const
+    {
+        EpochGuard guard(domain);
+        for (;;) {
+            // The guard keeps the version's memory valid; the increment fails
+            // only if a writer dropped it meanwhile, and then there is a newer one
+            detail::RcuVersion<T>* version = current.load(std::memory_order_acquire);
+            if (version->refs.increment_if_not_zero())
+                return RcuRef<T>(version);
+        }
+    }
+
+    // Copy of the current value
+    T load() const { return read().get(); }
+
+    void store(T value)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        publish(new detail::RcuVersion<T>(domain, std::move(value)));
+    }
+
+    // Publishes func(copy of the current value); read-copy-update proper.
+    // Concurrent updates are serialised, so none is lost.
+    template<typename Func>
+    void update(Func&& func)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        T next = current.load(std::memory_order_relaxed)->value;
+        func(next);
+        publish(new detail::RcuVersion<T>(domain, std::move(next)));
+    }
+
+    // Waits until every version replaced so far, with no RcuRef left, is freed
+    void synchronize() { domain.synchronize(); }
+
+private:
+    void publish(detail::RcuVersion<T>* next)
+    {
+        detail::RcuVersion<T>* previous = current.exchange(next, std::memory_order_acq_rel);
+        previous->release();
+        domain.reclaim();
+    }
+
+    EpochDomain& domain;
+    alignas(CACHE_LINE_SIZE) std::atomic<detail::RcuVersion<T>*> current;
+    std::mutex writeMutex;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_RCU_CELL_H
@@ -0,0 +1,321 @@
+#ifndef CPPUTILS_REF_COUNTED_H
+#define CPPUTILS_REF_COUNTED_H
+
+#include "cpputils/WaitFreeCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cpputils {
+
+template<typename T>
+class RefPtr;
+
+template<typename T>
+class WeakRef;
+
+namespace detail {
+
+// Counts shared by an object's RefPtrs and WeakRefs. Lives in the same
+// allocation as the object, ahead of it, and outlives it while weak
+// references remain.
+struct RefHeader
+{
+    Counter strong;                // Sticky at zero: a dead object cannot be revived
+    std::atomic<uint32_t> weak{1}; // The strong references together hold one
+    void (*destroyObject)(RefHeader*);
+    void (*freeBlock)(RefHeader*);
+
+    void releaseStrong()
+    {
+        if (strong.decrement()) {
+            destroyObject(this);
+            releaseWeak();
+        }
+    }
+
+    void releaseWeak()
+    {
+        // Sole holder (the usual case, no WeakRefs): nobody can take a new weak
+        // reference, so skip the atomic decrement
+        if (weak.load(std::memory_order_acquire) == 1 || weak.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            freeBlock(this);
+    }
+};
+
+template<typename T>
+struct RefBlock
+{
+    RefHeader header;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    static void destroyObject(RefHeader* header) { reinterpret_cast<RefBlock*>(header)->object()->~T(); }
+
+    static void freeBlock(RefHeader* header) { delete reinterpret_cast<RefBlock*>(header); }
+};
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class RefCounted
+//
+// Base for objects owned through RefPtr. Derive from it and create
+// objects with makeRef<T>(), which puts the reference counts and the
+// object in one allocation (std::make_shared's layout, without a
+// control block pointer in every smart pointer).
+//
+// The strong count is the wait-free Counter, whose zero is sticky: once
+// the last RefPtr is gone no one can take a new one, so WeakRef::lock()
+// and tryRef() are a single fetch_add with no CAS retry loop, and an
+// object can be safely looked up through a concurrent registry.
+//------------------------------------------------------------
+class RefCounted
+{
+public:
+    RefCounted(const RefCounted& other) = delete;
+    RefCounted& operator=(const RefCounted& other) = delete;
+
+    // Strong references, 0 once the object is being destroyed
+    uint64_t getRefCount() const { return refHeader->strong.read(); }
+
+protected:
+    RefCounted() {}
+    ~RefCounted() {}
+
+    // shared_from_this() counterparts, for use in derived classes.
+    // refFromThis() is null once the object is being destroyed.
+    template<typename T>
+    RefPtr<T> refFromThis(T* self)
+    {
+        if (!refHeader->strong.increment_if_not_zero())
+            return RefPtr<T>();
+        return RefPtr<T>(self, refHeader);
+    }
+
+    template<typename T>
+    WeakRef<T> weakFromThis(T* self)
+    {
+        return WeakRef<T>(self, refHeader);
+    }
+
+private:
+    template<typename T, typename... Args>
+    friend RefPtr<T> makeRef(Args&&... args);
+
+    template<typename T>
+    friend RefPtr<T> tryRef(T* object);
+
+    template<typename U>
+    friend class RefPtr;
+
+    mutable detail::RefHeader* refHeader{nullptr};
+};
+
+//------------------------------------------------------------
+// class RefPtr
+//
+// Strong reference. Copying is one atomic increment on the object's
+// header; the last release destroys the object, and frees the memory
+// too unless WeakRefs remain. Converts to RefPtr<Base> like shared_ptr;
+// the object is always destroyed as the type makeRef() created.
+//------------------------------------------------------------
+template<typename T>
+class RefPtr
+{
+public:
+    RefPtr() {}
+    RefPtr(std::nullptr_t) {}
+
+    RefPtr(const RefPtr& other) : object(other.object), header(other.header)
+    {
+        if (header != nullptr)
+            header->strong.increment_if_not_zero();
+    }
+
+    RefPtr(RefPtr&& other) noexcept : object(other.object), header(other.header)
+    {
+        other.object = nullptr;
+        other.header = nullptr;
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    RefPtr(const RefPtr<U>& other) : object(other.object), header(other.header)
+    {
+        if (header != nullptr)
+            header->strong.increment_if_not_zero();
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    RefPtr(RefPtr<U>&& other) noexcept : object(other.object), header(other.header)
+    {
+        other.object = nullptr;
+        other.header = nullptr;
+    }
+
+    ~RefPtr() { reset(); }
+
+    RefPtr& operator=(RefPtr other) noexcept
+    {
+        std::swap(object, other.object);
+        std::swap(header, other.header);
+        return *this;
+    }
+
+    void reset()
+    {
+        if (header != nullptr) {
+            object = nullptr;
+            std::exchange(header, nullptr)->releaseStrong();
+        }
+    }
+
+    T* get() const { return object; }
+    T* operator->() const { return object; }
+    T& operator*() const { return *object; }
+    explicit operator bool() const { return object != nullptr; }
+
+    template<typename U>
+    bool operator==(const RefPtr<U>& other) const
+    {
+        return object == other.get();
+    }
+    bool operator==(std::nullptr_t) const { return object == nullptr; }
+
+private:
+    template<typename U>
+    friend class RefPtr;
+    template<typename U>
+    friend class WeakRef;
+    friend class RefCounted;
+    template<typename U, typename... Args>
+    friend RefPtr<U> makeRef(Args&&... args);
+    template<typename U>
+    friend RefPtr<U> tryRef(U* object);
+
+    // Adopts a strong reference the caller already took
+    RefPtr(T* object, detail::RefHeader* header) : object(object), header(header) {}
+
+    T* object{nullptr};
+    detail::RefHeader* header{nullptr};
+};
+
+//------------------------------------------------------------
+// class WeakRef
+//
+// Non-owning reference that keeps the memory (not the object) alive.
+// lock() returns the object if it still has a strong reference, wait-free.
+//------------------------------------------------------------
+template<typename T>
+class WeakRef
+{
+public:
+    WeakRef() {}
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    WeakRef(const RefPtr<U>& strong) : WeakRef(strong.object, strong.header)
+    {}
+
+    WeakRef(const WeakRef& other) : WeakRef(other.object, other.header) {}
+
+    WeakRef(WeakRef&& other) noexcept : object(other.object), header(other.header)
+    {
+        other.object = nullptr;
+        other.header = nullptr;
+    }
+
+    ~WeakRef() { reset(); }
+
+    WeakRef& operator=(WeakRef other) noexcept
+    {
+        std::swap(object, other.object);
+        std::swap(header, other.header);
+        return *this;
+    }
+
+    void reset()
+    {
+        if (header != nullptr) {
+            object = nullptr;
+            std::exchange(header, nullptr)->releaseWeak();
+        }
+    }
+
+    RefPtr<T> lock() const
+    {
+        if (header == nullptr || !header->strong.increment_if_not_zero())
+            return RefPtr<T>();
+        return RefPtr<T>(object, header);
+    }
+
+    bool expired() const { return header == nullptr || header->strong.read() == 0; }
+
+private:
+    friend class RefCounted;
+
+    WeakRef(T* object, detail::RefHeader* header) : object(object), header(header)
+    {
+        if (header != nullptr)
+            header->weak.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    T* object{nullptr};
+    detail::RefHeader* header{nullptr};
+};
+
+//------------------------------------------------------------
+// makeRef()
+//
+// Allocates the counts and a T in one block and returns the first reference.
+//------------------------------------------------------------
+template<typename T, typename... Args>
+RefPtr<T> makeRef(Args&&... args)
+{
+    static_assert(std::is_base_of_v<RefCounted, T>, "makeRef<T>() needs T to derive from cpputils::RefCounted");
+
+    detail::RefBlock<T>* block = new detail::RefBlock<T>;
+    block->header.destroyObject = &detail::RefBlock<T>::destroyObject;
+    block->header.freeBlock = &detail::RefBlock<T>::freeBlock;
+
+    T* object = nullptr;
+    try {
+        object = ::new (static_cast<void*>(block->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        delete block;
+        throw;
+    }
+    static_cast<RefCounted*>(object)->refHeader = &block->header;
+    return RefPtr<T>(object, &block->header);
+}
+
+//------------------------------------------------------------
+// tryRef()
+//
+// Takes a strong reference to an object known only by pointer, e.g. from
+// a registry that objects remove themselves from on destruction. Returns
+// null if the object's last reference is already gone; the memory must
+// still be valid, which holding a WeakRef (or the registry lock) ensures.
+//------------------------------------------------------------
+template<typename T>
+RefPtr<T> tryRef(T* object)
+{
+    if (object == nullptr)
+        return RefPtr<T>();
+
+    detail::RefHeader* header = static_cast<const RefCounted*>(object)->refHeader;
+    if (!header->strong.increment_if_not_zero())
+        return RefPtr<T>();
+    return RefPtr<T>(object, header);
+}
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_REF_COUNTED_H
@@ -0,0 +1,230 @@
+#ifndef CPPUTILS_RESOURCE_USAGE_H
+#define CPPUTILS_RESOURCE_USAGE_H
+
+#include "cpputils/Clocks.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__)
+    #include <fcntl.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// struct ResourceUsage
+//
+// Snapshot (or the difference of two) of what the calling thread has
+// consumed: wall and CPU time, page faults, context switches, plus the
+// process resident set size. Taking one costs a getrusage() and a read
+// of /proc/self/statm, a few microseconds, so wrap regions rather than
+// tight loops.
+//
+// On Windows, faults come from the process-wide PageFaultCount and are
+// all reported as minor; context switch counts are not available (0).
+//------------------------------------------------------------
+struct ResourceUsage
+{
+    std::chrono::nanoseconds wallTime{0};
+    std::chrono::nanoseconds userTime{0};
+    std::chrono::nanoseconds systemTime{0};
+    int64_t minorFaults{0};
+    int64_t majorFaults{0};
+    int64_t voluntarySwitches{0};   // Blocked: I/O, locks, sleeps
+    int64_t involuntarySwitches{0}; // Preempted: time slice expired or higher priority thread
+    int64_t residentBytes{0};       // For a difference: RSS growth over the region
+
+    static ResourceUsage captureThread()
+    {
+        ResourceUsage usage;
+        usage.wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+            usage.userTime = std::chrono::nanoseconds(ThreadCpuClock::fileTimeTicks(user) * 100);
+            usage.systemTime = std::chrono::nanoseconds(ThreadCpuClock::fileTimeTicks(kernel) * 100);
+        }
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            usage.minorFaults = static_cast<int64_t>(counters.PageFaultCount);
+            usage.residentBytes = static_cast<int64_t>(counters.WorkingSetSize);
+        }
+#elif defined(__linux__)
+        rusage ru;
+        if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+            usage.userTime = toNanoseconds(ru.ru_utime);
+            usage.systemTime = toNanoseconds(ru.ru_stime);
+            usage.minorFaults = ru.ru_minflt;
+            usage.majorFaults = ru.ru_majflt;
+            usage.voluntarySwitches = ru.ru_nvcsw;
+            usage.involuntarySwitches = ru.ru_nivcsw;
+        }
+        usage.residentBytes = readResidentBytes();
+#endif
+        return usage;
+    }
+
+    std::chrono::nanoseconds getCpuTime() const { return userTime + systemTime; }
+
+    // Wall time the thread was not running: blocked, sleeping or waiting for a CPU
+    std::chrono::nanoseconds getOffCpuTime() const
+    {
+        const std::chrono::nanoseconds offCpu = wallTime - getCpuTime();
+        return offCpu.count() > 0 ? offCpu : std::chrono::nanoseconds(0);
+    }
+
+    ResourceUsage operator-(const ResourceUsage& other) const
+    {
+        ResourceUsage result;
+        result.wallTime = wallTime - other.wallTime;
+        result.userTime = userTime - other.userTime;
+        result.systemTime = systemTime - other.systemTime;
+        result.minorFaults = minorFaults - other.minorFaults;
+        result.majorFaults = majorFaults - other.majorFaults;
+        result.voluntarySwitches = voluntarySwitches - other.voluntarySwitches;
+        result.involuntarySwitches = involuntarySwitches - other.involuntarySwitches;
+        result.residentBytes = residentBytes - other.residentBytes;
+        return result;
+    }
+
+    ResourceUsage& operator+=(const ResourceUsage& other)
+    {
+        wallTime += other.wallTime;
+        userTime += other.userTime;
+        systemTime += other.systemTime;
+        minorFaults += other.minorFaults;
+        majorFaults += other.majorFaults;
+        voluntarySwitches += other.voluntarySwitches;
+        involuntarySwitches += other.involuntarySwitches;
+        residentBytes += other.residentBytes;
+        return *this;
+    }
+
+    void print(std::ostream& ostream) const
+    {
+        ostream << "wall=" << wallTime.count() / 1e6 << "ms cpu=" << getCpuTime().count() / 1e6
+                << "ms offcpu=" << getOffCpuTime().count() / 1e6 << "ms minflt=" << minorFaults
+                << " majflt=" << majorFaults << " nvcsw=" << voluntarySwitches << " nivcsw=" << involuntarySwitches
+                << " rss=" << residentBytes / 1024 << "KiB";
+    }
+
+private:
+#if defined(__linux__)
+    static std::chrono::nanoseconds toNanoseconds(const timeval& tv)
+    {
+        return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+    }
+
+    static int64_t readResidentBytes()
+    {
+        // "size resident shared text lib data dt", in pages
+        const int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return 0;
+
+        char buffer[128];
+        const ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+        close(fd);
+        if (length <= 0)
+            return 0;
+        buffer[length] = '\0';
+
+        char* residentStart = nullptr;
+        std::strtoll(buffer, &residentStart, 10);
+        const long long residentPages = std::strtoll(residentStart, nullptr, 10);
+        return static_cast<int64_t>(residentPages) * sysconf(_SC_PAGESIZE);
+    }
+#endif
+};
+
+//------------------------------------------------------------
+// class ResourceStats
+//
+// StatsTimer counterpart for ResourceUsage: accumulates the deltas of
+// repeated start()/stop() pairs on one thread and reports totals and
+// per-region averages.
+//------------------------------------------------------------
+class ResourceStats
+{
+public:
+    ResourceStats() {}
+
+    void reset()
+    {
+        totals = ResourceUsage();
+        regionCount = 0;
+        peakResidentBytes = 0;
+    }
+
+    void start() { startUsage = ResourceUsage::captureThread(); }
+
+    void stop()
+    {
+        const ResourceUsage endUsage = ResourceUsage::captureThread();
+        totals += endUsage - startUsage;
+        regionCount++;
+        peakResidentBytes = std::max(peakResidentBytes, endUsage.residentBytes);
+    }
+
+    uint64_t getRegionCount() const { return regionCount; }
+
+    const ResourceUsage& getTotals() const { return totals; }
+
+    int64_t getPeakResidentBytes() const { return peakResidentBytes; }
+
+    int64_t getAvgWallTimeNs() const { return average(totals.wallTime.count()); }
+    int64_t getAvgCpuTimeNs() const { return average(totals.getCpuTime().count()); }
+    int64_t getAvgOffCpuTimeNs() const { return average(totals.getOffCpuTime().count()); }
+
+    // Fraction of the measured wall time spent on-CPU, in [0, 1]
+    double getCpuUtilization() const
+    {
+        if (totals.wallTime.count() <= 0)
+            return 0.0;
+        const double utilization
+            = static_cast<double>(totals.getCpuTime().count()) / static_cast<double>(totals.wallTime.count());
+        return std::min(utilization, 1.0);
+    }
+
+private:
+    int64_t average(int64_t total) const { return regionCount == 0 ? 0 : total / static_cast<int64_t>(regionCount); }
+
+    ResourceUsage startUsage;
+    ResourceUsage totals;
+    uint64_t regionCount{0};
+    int64_t peakResidentBytes{0};
+};
+
+//------------------------------------------------------------
+// class ResourceScope
+//
+// RAII start()/stop() of a ResourceStats around a scope.
+//------------------------------------------------------------
+class ResourceScope
+{
+public:
+    ResourceScope(ResourceStats& stats) : stats(stats) { stats.start(); }
+
+    ~ResourceScope() { stats.stop(); }
+
+    ResourceScope(const ResourceScope& other) = delete;
+    ResourceScope& operator=(const ResourceScope& other) = delete;
+
+private:
+    ResourceStats& stats;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_RESOURCE_USAGE_H
@@ -0,0 +1,222 @@
+#ifndef CPPUTILS_SEQLOCK_H
+#define CPPUTILS_SEQLOCK_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/CpuRelax.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace cpputils {
+
+namespace detail {
+
+//------------------------------------------------------------
+// class SeqlockPayload
+//
+// The read side shared by Seqlock and MultiWriterSeqlock: a sequence
+// word that is odd while a writer is updating, and the payload copied in
+// and out as relaxed atomic words, so a reader that overlaps a write
+// reads stale words rather than racing on them. Readers only load;
+// they never write to the lock's cache lines.
+//------------------------------------------------------------
+template<typename T>
+class SeqlockPayload
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock copies its payload byte-wise");
+    static_assert(std::is_default_constructible_v<T>, "Seqlock readers return a T by value");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock must work in shared memory");
+
+public:
+    // Consistent copy; retries while it overlaps a write
+    T load() const
+    {
+        T value;
+        while (!tryLoad(value)) {
+            cpuRelax();
+        }
+        return value;
+    }
+
+    // One attempt; false (and `out` untouched) if it overlapped a write
+    bool tryLoad(T& out) const
+    {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+            return false;
+
+        const Words copy = loadWords();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before)
+            return false;
+
+        std::memcpy(static_cast<void*>(&out), copy.data(), sizeof(T));
+        return true;
+    }
+
+    // Even and larger after every completed write; lets a reader skip unchanged state
+    uint64_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+protected:
+    SeqlockPayload() = default;
+
+    explicit SeqlockPayload(const T& initial) { storeWords(initial); }
+
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, WORD_COUNT>;
+
+    Words loadWords() const
+    {
+        Words copy;
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            copy[i] = words[i].load(std::memory_order_relaxed);
+        }
+        return copy;
+    }
+
+    // Only while holding the write side
+    T loadLocked() const
+    {
+        const Words copy = loadWords();
+        T value;
+        std::memcpy(static_cast<void*>(&value), copy.data(), sizeof(T));
+        return value;
+    }
+
+    void storeWords(const T& value)
+    {
+        Words copy{};
+        std::memcpy(copy.data(), &value, sizeof(T));
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            words[i].store(copy[i], std::memory_order_relaxed);
+        }
+    }
+
+    // `locked` is the odd sequence the writer holds
+    void publish(const T& value, uint64_t locked)
+    {
+        storeWords(value);
+        sequence.store(locked + 1, std::memory_order_release);
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[WORD_COUNT]{};
+};
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class Seqlock
+//
+// Single-writer seqlock for a small trivially-copyable snapshot, such as
+// a set of related counters or a calibration record. The writer never
+// waits: store() bumps the sequence to odd, writes, bumps it to even.
+// Readers never block the writer and never write shared memory; a read
+// that overlaps a store retries, so load() is only delayed while a store
+// is in flight.
+//
+// Only one thread may store() at a time. Use MultiWriterSeqlock when
+// several threads or processes publish.
+//------------------------------------------------------------
+template<typename T>
+class Seqlock : public detail::SeqlockPayload<T>
+{
+    using Base = detail::SeqlockPayload<T>;
+
+public:
+    Seqlock() : Base(T()) {}
+    explicit Seqlock(const T& initial) : Base(initial) {}
+
+    // Copies a snapshot of `other`. Assignment is a store(): only the writer may assign.
+    Seqlock(const Seqlock& other) : Base(other.load()) {}
+    Seqlock& operator=(const Seqlock& other)
+    {
+        if (this != &other)
+            store(other.load());
+        return *this;
+    }
+
+    void store(const T& value)
+    {
+        const uint64_t current = this->sequence.load(std::memory_order_relaxed);
+        this->sequence.store(current + 1, std::memory_order_relaxed);
+        // Keeps the payload stores from becoming visible before the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        this->publish(value, current + 1);
+    }
+
+    // Stores update(current); the writer reads its own state without retrying
+    template<typename UpdateFunc>
+    void update(UpdateFunc&& update)
+    {
+        store(update(this->loadLocked()));
+    }
+};
+
+//------------------------------------------------------------
+// class MultiWriterSeqlock
+//
+// Seqlock whose writers serialise on the sequence word itself: a writer
+// takes the write side by CAS from even to odd, so it needs no separate
+// mutex and works across processes. A zero-filled SharedMemory segment
+// is a valid MultiWriterSeqlock holding an all-zero T, so processes can
+// use the segment's data() directly.
+//
+// A writer that dies while holding the write side leaves readers and
+// other writers spinning; do slow work (measuring, allocating) before
+// calling store() or update().
+//------------------------------------------------------------
+template<typename T>
+class MultiWriterSeqlock : public detail::SeqlockPayload<T>
+{
+    using Base = detail::SeqlockPayload<T>;
+
+public:
+    MultiWriterSeqlock() = default;
+    explicit MultiWriterSeqlock(const T& initial) : Base(initial) {}
+
+    MultiWriterSeqlock(const MultiWriterSeqlock& other) = delete;
+    MultiWriterSeqlock& operator=(const MultiWriterSeqlock& other) = delete;
+
+    void store(const T& value) { this->publish(value, lockWriteSide()); }
+
+    // Stores update(current) with no other writer in between
+    template<typename UpdateFunc>
+    void update(UpdateFunc&& update)
+    {
+        const uint64_t locked = lockWriteSide();
+        this->publish(update(this->loadLocked()), locked);
+    }
+
+private:
+    static constexpr int SPIN_LIMIT = 64;
+
+    // Returns the odd sequence now held
+    uint64_t lockWriteSide()
+    {
+        uint64_t current = this->sequence.load(std::memory_order_relaxed);
+        for (int spin = 0;; spin++) {
+            if ((current & 1) == 0
+                && this->sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+                break;
+            }
+            if (spin < SPIN_LIMIT)
+                cpuRelax();
+            else
+                std::this_thread::yield();
+            current = this->sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return current + 1;
+    }
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_SEQLOCK_H
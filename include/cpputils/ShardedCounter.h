@@ -0,0 +1,228 @@
+#ifndef CPPUTILS_SHARDED_COUNTER_H
+#define CPPUTILS_SHARDED_COUNTER_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/WaitFreeCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cpputils {
+
+namespace detail {
+
+// Stable per-thread shard index. Threads are numbered round-robin as they
+// first touch any sharded structure, so up to shardCount threads never share a cell.
+inline uint32_t threadShardIndex()
+{
+    static std::atomic<uint32_t> nextIndex{0};
+    thread_local const uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+inline size_t defaultShardCount()
+{
+    return std::bit_ceil(std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 256));
+}
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class ShardedCounter
+//
+// Striped counter for very frequent add()s from many threads. Each
+// thread adds to its own cache-line padded cell, so increments do not
+// bounce one line between cores the way a shared fetch_add does.
+//
+// A cell whose value drifts `batch` away from zero folds it into the
+// global count, so readApproximate() is a single load that is off by at
+// most shardCount * batch. read() takes the fold lock and sums every
+// cell: exact once writers are quiet, and never missing an add that
+// finished before it started.
+//------------------------------------------------------------
+class ShardedCounter
+{
+public:
+    explicit ShardedCounter(int64_t batch = 64, size_t shardCount = detail::defaultShardCount()) :
+        batch(std::max<int64_t>(batch, 1)),
+        mask(std::bit_ceil(std::max<size_t>(shardCount, 1)) - 1),
+        cells(std::make_unique<Cell[]>(mask + 1))
+    {}
+
+    ShardedCounter(const ShardedCounter& other) = delete;
+    ShardedCounter& operator=(const ShardedCounter& other) = delete;
+
+    void add(int64_t n = 1)
+    {
+        std::atomic<int64_t>& cell = cells[detail::threadShardIndex() & mask].value;
+        const int64_t value = cell.fetch_add(n, std::memory_order_relaxed) + n;
+        if (value >= batch || value <= -batch) [[unlikely]]
+            fold(cell);
+    }
+
+    void subtract(int64_t n = 1) { add(-n); }
+
+    // One load; within shardCount * batch of the true value
+    int64_t readApproximate() const { return global.load(std::memory_order_relaxed); }
+
+    int64_t read() const
+    {
+        std::lock_guard<std::mutex> lock(foldMutex);
+        int64_t total = global.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= mask; i++) {
+            total += cells[i].value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Not atomic with respect to concurrent add()s
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(foldMutex);
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].value.store(0, std::memory_order_relaxed);
+        }
+        global.store(0, std::memory_order_relaxed);
+    }
+
+    size_t getShardCount() const { return mask + 1; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell
+    {
+        std::atomic<int64_t> value{0};
+    };
+
+    void fold(std::atomic<int64_t>& cell)
+    {
+        std::lock_guard<std::mutex> lock(foldMutex);
+        global.fetch_add(cell.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    const int64_t batch;
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> global{0};
+    mutable std::mutex foldMutex;
+};
+
+//------------------------------------------------------------
+// class ShardedRefCount
+//
+// Reference count for objects that are shared widely and only rarely
+// close to zero (percpu_ref in the Linux kernel). It starts with one
+// reference owned by the creator. While live, get() and put() are a
+// single relaxed add on the thread's own cell; no zero check is
+// possible, or needed, because the owner still holds its reference.
+//
+// kill() drops the owner's reference and switches to a shared Counter:
+//  1. the shared count takes a large BIAS so it cannot reach zero while
+//     the cells are being collected;
+//  2. every cell is marked POISON with one fetch_or, which also returns
+//     its final contribution, and those are summed into the shared count;
+//  3. the BIAS and the owner's reference are dropped together.
+// A get()/put() that finds its cell poisoned goes to the shared Counter,
+// which detects zero wait-free. Exactly one call, kill() or a put(),
+// returns true: the one that released the last reference.
+//------------------------------------------------------------
+class ShardedRefCount
+{
+public:
+    explicit ShardedRefCount(size_t shardCount = detail::defaultShardCount()) :
+        mask(std::bit_ceil(std::max<size_t>(shardCount, 1)) - 1), cells(std::make_unique<Cell[]>(mask + 1))
+    {}
+
+    ShardedRefCount(const ShardedRefCount& other) = delete;
+    ShardedRefCount& operator=(const ShardedRefCount& other) = delete;
+
+    // Caller must already hold a reference (or the object must not be killed yet)
+    void get()
+    {
+        const uint64_t old = localCell().fetch_add(1, std::memory_order_relaxed);
+        if (old & POISON) [[unlikely]]
+            shared.increment_if_not_zero(1);
+    }
+
+    // Fails only once the last reference is gone
+    bool tryGet()
+    {
+        const uint64_t old = localCell().fetch_add(1, std::memory_order_relaxed);
+        if (old & POISON) [[unlikely]]
+            return shared.increment_if_not_zero(1);
+        return true;
+    }
+
+    // Returns true if this dropped the last reference
+    bool put()
+    {
+        const uint64_t old = localCell().fetch_sub(1, std::memory_order_release);
+        if (old & POISON) [[unlikely]]
+            return shared.decrement(1);
+        return false;
+    }
+
+    // Drops the creator's reference and starts zero detection. Call once.
+    bool kill()
+    {
+        shared.increment_if_not_zero(BIAS);
+
+        int64_t collected = 0;
+        for (size_t i = 0; i <= mask; i++) {
+            const uint64_t old = cells[i].value.fetch_or(POISON, std::memory_order_acq_rel);
+            collected += static_cast<int64_t>(old & ~POISON) - static_cast<int64_t>(BIAS);
+        }
+
+        if (collected > 0)
+            shared.increment_if_not_zero(static_cast<uint64_t>(collected));
+        else if (collected < 0)
+            shared.decrement(static_cast<uint64_t>(-collected));
+
+        // The creator's reference goes with the bias
+        const bool released = shared.decrement(BIAS + 1);
+        killed.store(true, std::memory_order_release);
+        return released;
+    }
+
+    bool isKilled() const { return killed.load(std::memory_order_acquire); }
+
+    // Exact once killed; while live, a sum of cells that concurrent get()/put() may be changing
+    uint64_t read()
+    {
+        if (isKilled())
+            return shared.read();
+
+        int64_t total = 1;
+        for (size_t i = 0; i <= mask; i++) {
+            total += static_cast<int64_t>(cells[i].value.load(std::memory_order_relaxed) & ~POISON)
+                     - static_cast<int64_t>(BIAS);
+        }
+        return total > 0 ? static_cast<uint64_t>(total) : 0;
+    }
+
+private:
+    // Cells count from BIAS so a cell that sees more puts than gets never
+    // borrows into the POISON bit.
+    static constexpr uint64_t POISON = uint64_t{1} << 63;
+    static constexpr uint64_t BIAS = uint64_t{1} << 61;
+
+    struct alignas(CACHE_LINE_SIZE) Cell
+    {
+        std::atomic<uint64_t> value{BIAS};
+    };
+
+    std::atomic<uint64_t>& localCell() { return cells[detail::threadShardIndex() & mask].value; }
+
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(CACHE_LINE_SIZE) Counter shared;
+    std::atomic<bool> killed{false};
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_SHARDED_COUNTER_H
@@ -8,13 +8,24 @@
 #if defined(_WIN32)
     #include <windows.h>
 #elif defined(__linux__)
-    // TODO:: Linux Implementation
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
 #endif
 
 namespace cpputils {
 
 //------------------------------------------------------------
 // class SharedMemory
+//
+// Named memory segment shared between processes. Every process that
+// opens the same key sees the same bytes; the segment is created
+// zero-filled by whoever opens it first.
+//
+// On Windows the segment lives until the last handle is closed. On Linux
+// it is a POSIX shared memory object (/dev/shm) that outlives its users
+// until remove() is called.
 //------------------------------------------------------------
 class SharedMemory
 {
@@ -31,9 +42,25 @@ public:
     SharedMemory(SharedMemory&& other) noexcept = delete;
     SharedMemory& operator=(SharedMemory&& other) noexcept = delete;
 
+    bool valid() const { return pData != nullptr; }
+
     void* data() { return pData; }
     size_t size() const { return sizeBytes; }
 
+    // Deletes the named segment. Processes that have it open keep their mapping.
+    static bool remove(const std::string& key)
+    {
+#if defined(_WIN32)
+        (void)key;
+        return true;
+#elif defined(__linux__)
+        return shm_unlink(posixName(key).c_str()) == 0;
+#else
+        (void)key;
+        return false;
+#endif
+    }
+
 private:
     void* pData{nullptr};
     std::string key;
@@ -43,7 +70,18 @@ private:
 #if defined(_WIN32)
     HANDLE hFileMapping{NULL};
 #elif defined(__linux__)
-        // TODO:: Linux Implementation
+    int fd{-1};
+
+    // POSIX names are one path component with a leading slash
+    static std::string posixName(const std::string& key)
+    {
+        std::string name = "/" + key;
+        for (size_t i = 1; i < name.size(); i++) {
+            if (name[i] == '/' || name[i] == '\\')
+                name[i] = '_';
+        }
+        return name;
+    }
 #endif
 
     //------------------------------------------------------------
@@ -89,7 +127,32 @@ private:
         }
 
 #elif defined(__linux__)
-            // TODO:: Linux Implementation
+        fd = shm_open(posixName(key).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd == -1) {
+            std::cerr << "ERROR SharedMemory::openSharedMemory() (Linux) shm_open failed, could not open " << key
+                      << "!" << std::endl;
+            return;
+        }
+
+        // Grow a new (empty) or smaller segment; the added bytes read as zero
+        struct stat status;
+        if (fstat(fd, &status) != 0
+            || (static_cast<size_t>(status.st_size) < sizeBytes && ftruncate(fd, static_cast<off_t>(sizeBytes)) != 0)) {
+            std::cerr << "ERROR SharedMemory::openSharedMemory() (Linux) could not size " << key << " to "
+                      << sizeBytes << " bytes!" << std::endl;
+            closeSharedMemory();
+            return;
+        }
+
+        void* mapping = mmap(nullptr, sizeBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "ERROR SharedMemory::openSharedMemory() (Linux) mmap failed. Could not get pointer to shared "
+                         "memory!"
+                      << std::endl;
+            closeSharedMemory();
+            return;
+        }
+        pData = mapping;
 #endif
     }
 
@@ -110,7 +173,15 @@ private:
         }
 
 #elif defined(__linux__)
-            // TODO:: Linux Implementation
+        if (pData != nullptr) {
+            munmap(pData, sizeBytes);
+            pData = nullptr;
+        }
+
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
 #endif
     }
 };
@@ -0,0 +1,236 @@
+#ifndef CPPUTILS_SPSC_RING_H
+#define CPPUTILS_SPSC_RING_H
+
+#include "cpputils/Alignment.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class SpscRing
+//
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread. Capacity is rounded up to a power of two and the
+// slots live in one cache-line aligned AlignedBuffer.
+//
+// The producer's tail and the consumer's head sit on separate cache
+// lines, and each side keeps a private copy of the other side's index.
+// It only reloads the shared one when the copy says the ring is full
+// (or empty), so in steady state a push or pop touches no line the other
+// thread writes, apart from the slot itself.
+//
+// Besides single push/pop there are batch push/pop of spans and, for
+// trivially copyable T, zero-copy access to the slots themselves:
+//   producer: reserve(n) -> fill the span -> commit(k)
+//   consumer: peek()     -> read the span -> consume(k)
+// A reserved or peeked span stops at the end of the buffer, so it can be
+// shorter than what is available; call again after commit/consume.
+//
+// If the slots cannot be allocated, valid() is false and the ring stays
+// both full and empty: every push and pop fails.
+//------------------------------------------------------------
+template<typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t requestedCapacity) :
+        mask(std::bit_ceil(std::max<size_t>(requestedCapacity, 1)) - 1),
+        storage(slotBytes(mask + 1), std::max(alignof(T), CACHE_LINE_SIZE)),
+        slots(static_cast<T*>(storage.buf))
+    {
+        if (slots == nullptr)
+            std::cerr << "ERROR cpputils SpscRing::SpscRing() could not allocate "
+                      << capacity() << " slots" << std::endl;
+    }
+
+    ~SpscRing()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t tail = producer.tail.load(std::memory_order_acquire);
+            for (uint64_t head = consumer.head.load(std::memory_order_relaxed); head != tail; head++) {
+                slots[head & mask].~T();
+            }
+        }
+    }
+
+    SpscRing(const SpscRing& other) = delete;
+    SpscRing& operator=(const SpscRing& other) = delete;
+
+    bool valid() const { return slots != nullptr; }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate unless called from the producer or consumer while the other is idle
+    size_t size() const
+    {
+        return static_cast<size_t>(producer.tail.load(std::memory_order_acquire)
+                                   - consumer.head.load(std::memory_order_acquire));
+    }
+
+    bool empty() const { return size() == 0; }
+
+    //------------------------------------------------------------
+    // Producer side
+    //------------------------------------------------------------
+    template<typename... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        const uint64_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (freeSlots(tail) == 0) [[unlikely]]
+            return false;
+
+        ::new (static_cast<void*>(&slots[tail & mask])) T(std::forward<Args>(args)...);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) { return tryEmplace(value); }
+    bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+    // Pushes as many leading elements of `values` as fit; returns how many
+    size_t pushBatch(std::span<const T> values)
+    {
+        const uint64_t tail = producer.tail.load(std::memory_order_relaxed);
+        const size_t count = std::min(values.size(), freeSlots(tail, values.size()));
+        for (size_t i = 0; i < count; i++) {
+            ::new (static_cast<void*>(&slots[(tail + i) & mask])) T(values[i]);
+        }
+        if (count != 0)
+            producer.tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Contiguous free slots, at most `count`; fill them, then commit()
+    std::span<T> reserve(size_t count)
+        requires std::is_trivially_copyable_v<T>
+    {
+        const uint64_t tail = producer.tail.load(std::memory_order_relaxed);
+        const size_t offset = static_cast<size_t>(tail & mask);
+        const size_t wanted = std::min(count, capacity() - offset);
+        const size_t available = std::min(wanted, freeSlots(tail, wanted));
+        return std::span<T>(slots + offset, available);
+    }
+
+    // Publishes the first `count` slots of the last reserve()
+    void commit(size_t count)
+        requires std::is_trivially_copyable_v<T>
+    {
+        producer.tail.store(producer.tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    //------------------------------------------------------------
+    // Consumer side
+    //------------------------------------------------------------
+    bool tryPop(T& out)
+    {
+        const uint64_t head = consumer.head.load(std::memory_order_relaxed);
+        if (readySlots(head) == 0) [[unlikely]]
+            return false;
+
+        T& slot = slots[head & mask];
+        out = std::move(slot);
+        slot.~T();
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pops up to out.size() elements into `out`; returns how many
+    size_t popBatch(std::span<T> out)
+    {
+        const uint64_t head = consumer.head.load(std::memory_order_relaxed);
+        const size_t count = std::min(out.size(), readySlots(head, out.size()));
+        for (size_t i = 0; i < count; i++) {
+            T& slot = slots[(head + i) & mask];
+            out[i] = std::move(slot);
+            slot.~T();
+        }
+        if (count != 0)
+            consumer.head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Contiguous queued elements, oldest first; read them, then consume()
+    std::span<const T> peek()
+        requires std::is_trivially_copyable_v<T>
+    {
+        const uint64_t head = consumer.head.load(std::memory_order_relaxed);
+        const size_t offset = static_cast<size_t>(head & mask);
+        const size_t contiguous = capacity() - offset;
+        const size_t available = std::min(contiguous, readySlots(head, contiguous));
+        return std::span<const T>(slots + offset, available);
+    }
+
+    // Releases the first `count` elements of the last peek() to the producer
+    void consume(size_t count)
+        requires std::is_trivially_copyable_v<T>
+    {
+        consumer.head.store(consumer.head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    static size_t slotBytes(size_t capacity)
+    {
+        // aligned_alloc wants a multiple of the alignment
+        const size_t alignment = std::max(alignof(T), CACHE_LINE_SIZE);
+        return (capacity * sizeof(T) + alignment - 1) / alignment * alignment;
+    }
+
+    // Free slots seen by the producer. Reloads the consumer's head only
+    // when the cached copy shows fewer than `wanted`.
+    size_t freeSlots(uint64_t tail, size_t wanted = 1)
+    {
+        if (!valid()) [[unlikely]]
+            return 0;
+        size_t space = capacity() - static_cast<size_t>(tail - producer.cachedHead);
+        if (space < wanted) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            space = capacity() - static_cast<size_t>(tail - producer.cachedHead);
+        }
+        return space;
+    }
+
+    // Queued elements seen by the consumer, with the same caching
+    size_t readySlots(uint64_t head, size_t wanted = 1)
+    {
+        if (!valid()) [[unlikely]]
+            return 0;
+        size_t ready = static_cast<size_t>(consumer.cachedTail - head);
+        if (ready < wanted) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            ready = static_cast<size_t>(consumer.cachedTail - head);
+        }
+        return ready;
+    }
+
+    struct alignas(CACHE_LINE_SIZE) ProducerSide
+    {
+        std::atomic<uint64_t> tail{0};
+        uint64_t cachedHead{0};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ConsumerSide
+    {
+        std::atomic<uint64_t> head{0};
+        uint64_t cachedTail{0};
+    };
+
+    const uint64_t mask;
+    AlignedBuffer storage;
+    T* const slots;
+    ProducerSide producer;
+    ConsumerSide consumer;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_SPSC_RING_H
@@ -0,0 +1,637 @@
+#ifndef CPPUTILS_THREAD_POOL_H
+#define CPPUTILS_THREAD_POOL_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/EventCount.h"
+#include "cpputils/MpmcQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpputils {
+
+class ThreadPool;
+class TaskGroup;
+
+//------------------------------------------------------------
+// class Task
+//
+// Move-only type-erased void() callable. Callables of up to 48 bytes
+// that are nothrow-movable live inside the Task itself, so submitting a
+// lambda with a few captures allocates nothing; larger ones go to the heap.
+//------------------------------------------------------------
+class Task
+{
+public:
+    static constexpr size_t INLINE_BYTES = 48;
+
+    Task() {}
+
+    template<typename Func>
+        requires(!std::is_same_v<std::decay_t<Func>, Task> && std::is_invocable_v<std::decay_t<Func>&>)
+    Task(Func&& func)
+    {
+        using Callable = std::decay_t<Func>;
+        if constexpr (fitsInline<Callable>()) {
+            ::new (static_cast<void*>(storage)) Callable(std::forward<Func>(func));
+            operations = &inlineOperations<Callable>;
+        } else {
+            *reinterpret_cast<Callable**>(storage) = new Callable(std::forward<Func>(func));
+            operations = &heapOperations<Callable>;
+        }
+    }
+
+    Task(Task&& other) noexcept : operations(other.operations)
+    {
+        if (operations != nullptr) {
+            operations->move(storage, other.storage);
+            other.operations = nullptr;
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            operations = other.operations;
+            if (operations != nullptr) {
+                operations->move(storage, other.storage);
+                other.operations = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task& other) = delete;
+    Task& operator=(const Task& other) = delete;
+
+    ~Task() { reset(); }
+
+    void operator()() { operations->invoke(storage); }
+
+    explicit operator bool() const { return operations != nullptr; }
+
+    void reset()
+    {
+        if (operations != nullptr) {
+            operations->destroy(storage);
+            operations = nullptr;
+        }
+    }
+
+private:
+    struct Operations
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* to, void* from); // Leaves `from` destroyed
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Callable>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(Callable) <= INLINE_BYTES && alignof(Callable) <= alignof(std::max_align_t)
+               && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    template<typename Callable>
+    static constexpr Operations inlineOperations{
+        [](void* storage) { (*std::launder(static_cast<Callable*>(storage)))(); },
+        [](void* to, void* from) {
+            Callable* source = std::launder(static_cast<Callable*>(from));
+            ::new (to) Callable(std::move(*source));
+            source->~Callable();
+        },
+        [](void* storage) { std::launder(static_cast<Callable*>(storage))->~Callable(); }};
+
+    template<typename Callable>
+    static constexpr Operations heapOperations{
+        [](void* storage) { (**static_cast<Callable**>(storage))(); },
+        [](void* to, void* from) { *static_cast<Callable**>(to) = *static_cast<Callable**>(from); },
+        [](void* storage) { delete *static_cast<Callable**>(storage); }};
+
+    alignas(std::max_align_t) unsigned char storage[INLINE_BYTES];
+    const Operations* operations{nullptr};
+};
+
+namespace detail {
+
+// A task and the group it counts against, as queued in the pool
+struct PoolTask
+{
+    Task task;
+    TaskGroup* group{nullptr};
+};
+
+// Work-stealing deque nodes. Recycled through a per-thread cache, so fork-join
+// code that spawns and runs its own tasks does not touch the allocator.
+struct TaskNode
+{
+    PoolTask work;
+    TaskNode* next{nullptr};
+};
+
+class TaskNodeCache
+{
+public:
+    ~TaskNodeCache()
+    {
+        while (head != nullptr) {
+            delete std::exchange(head, head->next);
+        }
+    }
+
+    static TaskNodeCache& local()
+    {
+        thread_local TaskNodeCache cache;
+        return cache;
+    }
+
+    TaskNode* acquire(PoolTask&& work)
+    {
+        TaskNode* node = head;
+        if (node == nullptr)
+            return new TaskNode{std::move(work)};
+        head = node->next;
+        count--;
+        node->work = std::move(work);
+        return node;
+    }
+
+    void release(TaskNode* node)
+    {
+        node->work.task.reset();
+        if (count >= CAPACITY) {
+            delete node;
+            return;
+        }
+        node->next = head;
+        head = node;
+        count++;
+    }
+
+private:
+    static constexpr size_t CAPACITY = 1024;
+
+    TaskNode* head{nullptr};
+    size_t count{0};
+};
+
+//------------------------------------------------------------
+// class ChaseLevDeque
+//
+// Work-stealing deque (Chase & Lev, with the C11 orderings of Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models"). The
+// owning worker pushes and takes at the bottom without atomic RMW except
+// when racing thieves for the last element; thieves CAS the top. The
+// ring grows by doubling; old rings stay alive until the deque is
+// destroyed, since a thief may still be reading one.
+//------------------------------------------------------------
+template<typename T>
+class ChaseLevDeque
+{
+    static_assert(std::is_pointer_v<T>, "ChaseLevDeque holds pointers; a failed take/steal returns nullptr");
+
+public:
+    explicit ChaseLevDeque(size_t capacity = 256) : ring(new Ring(std::bit_ceil(std::max<size_t>(capacity, 2)))) {}
+
+    ~ChaseLevDeque() { delete ring.load(std::memory_order_relaxed); }
+
+    ChaseLevDeque(const ChaseLevDeque& other) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque& other) = delete;
+
+    // Owner only
+    void push(T item)
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Ring* current = ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(current->mask)) [[unlikely]]
+            current = grow(current, t, b);
+        current->put(b, item);
+        bottom.store(b + 1, std::memory_order_release); // Publishes the item to thieves
+    }
+
+    // Owner only; newest first
+    T take()
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* current = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T item = current->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread; oldest first. nullptr if empty or another thief won.
+    T steal()
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+
+        T item = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    size_t sizeApprox() const
+    {
+        const int64_t size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+private:
+    struct Ring
+    {
+        explicit Ring(size_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        T get(int64_t index) const { return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed); }
+        void put(int64_t index, T item)
+        {
+            slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        const size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+        std::unique_ptr<Ring> previous; // Kept for thieves still reading it
+    };
+
+    Ring* grow(Ring* current, int64_t t, int64_t b)
+    {
+        Ring* bigger = new Ring((current->mask + 1) * 2);
+        for (int64_t i = t; i < b; i++) {
+            bigger->put(i, current->get(i));
+        }
+        bigger->previous.reset(current);
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom{0};
+    std::atomic<Ring*> ring;
+};
+
+} // namespace detail
+
+//------------------------------------------------------------
+// class ThreadPool
+//
+// Work-stealing executor. Each worker owns a ChaseLevDeque: tasks spawned
+// from a worker go to the bottom of its own deque and it runs them
+// newest first, which keeps fork-join recursion cache-warm; idle workers
+// steal the oldest (largest) tasks from a random victim. Tasks submitted
+// from outside the pool go through a bounded MpmcQueue, by value, so
+// small tasks are never heap-allocated.
+//
+// Idle workers spin briefly, then park on an EventCount; submitting a
+// task costs a plain load to check for sleepers when everyone is busy.
+//
+// TaskGroup is the fork-join handle: run() spawns, wait() helps execute
+// pending work (from any group) until the group's tasks are done, so a
+// worker can wait without starving the pool. parallelFor() and
+// parallelReduce() split ranges recursively on top of it.
+//
+// Tasks must not throw. The destructor runs every task already queued.
+//------------------------------------------------------------
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threadCount = std::max(1u, std::thread::hardware_concurrency()),
+                        size_t injectionCapacity = 4096) :
+        injected(injectionCapacity)
+    {
+        threadCount = std::max<size_t>(threadCount, 1);
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < threadCount; i++) {
+            workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        stopping.store(true, std::memory_order_release);
+        idle.notifyAll();
+        for (std::unique_ptr<Worker>& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    size_t getThreadCount() const { return workers.size(); }
+
+    // Fire and forget
+    template<typename Func>
+    void submit(Func&& func)
+    {
+        spawn(detail::PoolTask{Task(std::forward<Func>(func)), nullptr});
+    }
+
+    // Runs func(i) for every i in [begin, end). Ranges are split in halves
+    // down to `grain` (default: about 8 chunks per worker), but a worker only
+    // splits off a stealable half while its own deque is nearly empty;
+    // when nobody is stealing it works through grain-sized chunks instead.
+    template<typename Func>
+    void parallelFor(size_t begin, size_t end, Func&& func, size_t grain = 0);
+
+    // Combines body(chunkBegin, chunkEnd, identity) over [begin, end) with
+    // combine(left, right), in index order; both must be thread-safe.
+    template<typename T, typename Body, typename Combine>
+    T parallelReduce(size_t begin, size_t end, T identity, Body&& body, Combine&& combine, size_t grain = 0);
+
+private:
+    friend class TaskGroup;
+
+    struct Worker
+    {
+        detail::ChaseLevDeque<detail::TaskNode*> deque;
+        std::thread thread;
+    };
+
+    struct WorkerContext
+    {
+        ThreadPool* pool{nullptr};
+        size_t index{0};
+        uint64_t random{0x9E3779B97F4A7C15ull};
+    };
+
+    static WorkerContext& context()
+    {
+        thread_local WorkerContext current;
+        return current;
+    }
+
+    Worker* currentWorker()
+    {
+        WorkerContext& current = context();
+        return current.pool == this ? workers[current.index].get() : nullptr;
+    }
+
+    // Workers push onto their own deque; other threads use the injection queue
+    void spawn(detail::PoolTask&& work)
+    {
+        if (Worker* worker = currentWorker())
+            worker->deque.push(detail::TaskNodeCache::local().acquire(std::move(work)));
+        else
+            injected.push(std::move(work));
+        idle.notify();
+    }
+
+    // Own deque, then the injection queue, then other workers' deques from a random start
+    bool findWork(detail::PoolTask& out)
+    {
+        WorkerContext& current = context();
+        Worker* self = current.pool == this ? workers[current.index].get() : nullptr;
+        if (self != nullptr) {
+            if (detail::TaskNode* node = self->deque.take()) {
+                adopt(node, out);
+                return true;
+            }
+        }
+        if (injected.tryPop(out))
+            return true;
+
+        current.random ^= current.random << 13;
+        current.random ^= current.random >> 7;
+        current.random ^= current.random << 17;
+        const size_t start = static_cast<size_t>(current.random % workers.size());
+        for (size_t i = 0; i < workers.size(); i++) {
+            Worker& victim = *workers[(start + i) % workers.size()];
+            if (&victim == self)
+                continue;
+            if (detail::TaskNode* node = victim.deque.steal()) {
+                adopt(node, out);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void adopt(detail::TaskNode* node, detail::PoolTask& out)
+    {
+        out = std::move(node->work);
+        detail::TaskNodeCache::local().release(node);
+    }
+
+    void execute(detail::PoolTask& work);
+
+    void workerLoop(size_t index)
+    {
+        WorkerContext& current = context();
+        current.pool = this;
+        current.index = index;
+        current.random += index * 0x2545F4914F6CDD1Dull;
+
+        detail::PoolTask work;
+        for (;;) {
+            bool stop = false;
+            idle.await([&]() {
+                if (findWork(work))
+                    return true;
+                stop = stopping.load(std::memory_order_acquire);
+                return stop;
+            });
+            if (stop)
+                break;
+            execute(work);
+        }
+        current.pool = nullptr;
+    }
+
+    template<typename Func>
+    void splitFor(TaskGroup& group, size_t begin, size_t end, size_t grain, Func& func);
+
+    template<typename T, typename Body, typename Combine>
+    struct Reduction
+    {
+        size_t grain;
+        const T& identity;
+        Body& body;
+        Combine& combine;
+    };
+
+    // Takes the reduction by reference so the spawned half fits in a Task inline
+    template<typename T, typename Body, typename Combine>
+    T splitReduce(size_t begin, size_t end, const Reduction<T, Body, Combine>& reduction);
+
+    size_t defaultGrain(size_t count) const { return std::max<size_t>(1, count / (workers.size() * 8)); }
+
+    // Own deque has a task a thief could still take
+    bool hasStealableWork()
+    {
+        Worker* worker = currentWorker();
+        return worker != nullptr && worker->deque.sizeApprox() > 1;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    MpmcQueue<detail::PoolTask> injected;
+    EventCount idle;
+    std::atomic<bool> stopping{false};
+};
+
+//------------------------------------------------------------
+// class TaskGroup
+//
+// Fork-join scope on a ThreadPool. run() spawns a task counted against
+// the group; wait() returns once all of them have finished, executing
+// queued work meanwhile instead of blocking. The destructor waits.
+//------------------------------------------------------------
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool(pool) {}
+
+    TaskGroup(const TaskGroup& other) = delete;
+    TaskGroup& operator=(const TaskGroup& other) = delete;
+
+    ~TaskGroup() { wait(); }
+
+    template<typename Func>
+    void run(Func&& func)
+    {
+        state.fetch_add(ONE_TASK, std::memory_order_relaxed);
+        pool.spawn(detail::PoolTask{Task(std::forward<Func>(func)), this});
+    }
+
+    // Called by one thread at a time
+    void wait()
+    {
+        detail::PoolTask work;
+        while (!done(state.load(std::memory_order_acquire))) {
+            if (pool.findWork(work)) {
+                pool.execute(work);
+                continue;
+            }
+            bool found = false;
+            if (done(state.fetch_or(WAITING, std::memory_order_acq_rel)))
+                break;
+            pool.idle.await([&]() {
+                found = pool.findWork(work);
+                return found || done(state.load(std::memory_order_acquire));
+            });
+            state.fetch_and(~WAITING, std::memory_order_relaxed);
+            if (found)
+                pool.execute(work);
+        }
+    }
+
+private:
+    friend class ThreadPool;
+
+    // Task count and the waiting flag share one word, so the last task sees
+    // the flag in the same RMW that lets wait() return
+    static constexpr uint32_t WAITING = 1;
+    static constexpr uint32_t ONE_TASK = 2;
+
+    static bool done(uint32_t value) { return value < ONE_TASK; }
+
+    void finish()
+    {
+        // wait() may return, and the group go away, as soon as the count drops
+        ThreadPool& owner = pool;
+        if (state.fetch_sub(ONE_TASK, std::memory_order_acq_rel) == (ONE_TASK | WAITING))
+            owner.idle.notifyAll();
+    }
+
+    ThreadPool& pool;
+    std::atomic<uint32_t> state{0}; // Pending tasks * ONE_TASK | WAITING
+};
+
+inline void ThreadPool::execute(detail::PoolTask& work)
+{
+    TaskGroup* group = work.group;
+    work.task();
+    work.task.reset();
+    if (group != nullptr)
+        group->finish();
+}
+
+template<typename Func>
+void ThreadPool::splitFor(TaskGroup& group, size_t begin, size_t end, size_t grain, Func& func)
+{
+    while (end - begin > grain) {
+        if (hasStealableWork()) {
+            // Nobody is taking our queued halves: no point queuing more
+            const size_t chunkEnd = begin + grain;
+            for (size_t i = begin; i < chunkEnd; i++) {
+                func(i);
+            }
+            begin = chunkEnd;
+            continue;
+        }
+        const size_t middle = begin + (end - begin) / 2;
+        group.run([this, &group, middle, end, grain, &func]() { splitFor(group, middle, end, grain, func); });
+        end = middle;
+    }
+    for (size_t i = begin; i < end; i++) {
+        func(i);
+    }
+}
+
+template<typename Func>
+void ThreadPool::parallelFor(size_t begin, size_t end, Func&& func, size_t grain)
+{
+    if (begin >= end)
+        return;
+    TaskGroup group(*this);
+    splitFor(group, begin, end, grain != 0 ? grain : defaultGrain(end - begin), func);
+    group.wait();
+}
+
+template<typename T, typename Body, typename Combine>
+T ThreadPool::splitReduce(size_t begin, size_t end, const Reduction<T, Body, Combine>& reduction)
+{
+    if (end - begin <= reduction.grain)
+        return reduction.body(begin, end, reduction.identity);
+
+    const size_t middle = begin + (end - begin) / 2;
+    T right = reduction.identity;
+    TaskGroup group(*this);
+    group.run([this, &right, middle, end, &reduction]() { right = splitReduce(middle, end, reduction); });
+    T left = splitReduce(begin, middle, reduction);
+    group.wait();
+    return reduction.combine(std::move(left), std::move(right));
+}
+
+template<typename T, typename Body, typename Combine>
+T ThreadPool::parallelReduce(size_t begin, size_t end, T identity, Body&& body, Combine&& combine, size_t grain)
+{
+    if (begin >= end)
+        return identity;
+    const Reduction<T, std::remove_reference_t<Body>, std::remove_reference_t<Combine>> reduction{
+        grain != 0 ? grain : defaultGrain(end - begin), identity, body, combine};
+    return splitReduce(begin, end, reduction);
+}
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_THREAD_POOL_H
@@ -113,12 +113,14 @@ public:
         index = (index + 1) % retainedTimingsSize;
     }
 
-    int64_t getAvgTimeMs()
+    int64_t getAvgTimeMs() { return getAvgTimeNs() / 1'000'000; }
+
+    int64_t getAvgTimeNs()
     {
+        // Sum in nanoseconds so sub-millisecond samples are not truncated away
         int64_t totalTime = 0;
         for (const std::chrono::nanoseconds& timingNs : timings) {
-            const std::chrono::milliseconds timingMs = std::chrono::duration_cast<std::chrono::milliseconds>(timingNs);
-            totalTime += timingMs.count();
+            totalTime += timingNs.count();
         }
         totalTime /= retainedTimingsSize;
         return totalTime;
@@ -126,7 +128,7 @@ public:
 
 private:
     clockType::time_point lastMeasuredTime{};
-    std::array<std::chrono::nanoseconds, retainedTimingsSize> timings;
+    std::array<std::chrono::nanoseconds, retainedTimingsSize> timings{};
     size_t index{0};
 };
 
@@ -0,0 +1,231 @@
+#ifndef CPPUTILS_TIMER_LOG_SINK_H
+#define CPPUTILS_TIMER_LOG_SINK_H
+
+#include "cpputils/PerThread.h"
+#include "cpputils/SpscRing.h"
+#include "cpputils/Timer.h"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// struct TimerLogRecord
+//
+// Fixed-size record pushed by AsyncScopePrintTimer. `prefix` is not
+// copied, so it must outlive the sink (string literals are ideal).
+//------------------------------------------------------------
+struct TimerLogRecord
+{
+    const char* prefix{nullptr};
+    long long count{0};
+    uint64_t threadId{0};
+};
+
+//------------------------------------------------------------
+// class TimerLogSink
+//
+// Moves formatting and stream writes off the measured thread. Each
+// producing thread gets its own SpscRing, so push() is a copy and a
+// store on lines no other producer touches. A background thread wakes
+// every flushInterval, formats everything queued into one buffer and
+// writes it with a single write + flush.
+//
+// When a thread's ring is full the new record is dropped and counted;
+// the background thread reports drops in the output and
+// getDroppedCount() returns the running total.
+//------------------------------------------------------------
+class TimerLogSink
+{
+public:
+    TimerLogSink(std::ostream& ostream = std::cout,
+                 size_t ringCapacity = 1024,
+                 std::chrono::milliseconds flushInterval = std::chrono::milliseconds(10)) :
+        _ostream(ostream),
+        flushInterval(flushInterval),
+        rings([ringCapacity]() { return std::make_unique<Ring>(ringCapacity); })
+    {
+        writerThread = std::thread([this]() { writerLoop(); });
+    }
+
+    ~TimerLogSink()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopRequested = true;
+        }
+        wakeCondition.notify_one();
+        writerThread.join();
+        flush();
+    }
+
+    TimerLogSink(const TimerLogSink& other) = delete;
+    TimerLogSink& operator=(const TimerLogSink& other) = delete;
+    TimerLogSink(TimerLogSink&& other) noexcept = delete;
+    TimerLogSink& operator=(TimerLogSink&& other) noexcept = delete;
+
+    // Process-wide sink writing to std::cout. Records pushed after static
+    // destruction has begun are undefined, as for std::cout itself.
+    static TimerLogSink& global()
+    {
+        static TimerLogSink sink;
+        return sink;
+    }
+
+    bool push(const TimerLogRecord& record)
+    {
+        Ring& ring = rings.local();
+        if (!ring.records.tryPush(record)) [[unlikely]] {
+            ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Synchronously formats and writes everything queued so far
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(consumerMutex);
+
+        buffer.clear();
+        uint64_t dropped = 0;
+        rings.forEach([this, &dropped](Ring& ring) {
+            // Two peeks cover a ring that wraps; a busy producer cannot keep us here
+            for (int part = 0; part < 2; part++) {
+                const std::span<const TimerLogRecord> queued = ring.records.peek();
+                for (const TimerLogRecord& record : queued) {
+                    appendRecord(record);
+                }
+                writtenCount += queued.size();
+                ring.records.consume(queued.size());
+            }
+            dropped += ring.dropped.load(std::memory_order_relaxed);
+        });
+
+        if (dropped != reportedDroppedCount) {
+            buffer += "TimerLogSink dropped ";
+            appendNumber(dropped - reportedDroppedCount);
+            buffer += " records (ring full)\n";
+            reportedDroppedCount = dropped;
+        }
+
+        if (!buffer.empty()) {
+            _ostream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            _ostream.flush();
+        }
+    }
+
+    uint64_t getDroppedCount()
+    {
+        uint64_t dropped = 0;
+        rings.forEach([&dropped](Ring& ring) { dropped += ring.dropped.load(std::memory_order_relaxed); });
+        return dropped;
+    }
+
+    uint64_t getWrittenCount()
+    {
+        std::lock_guard<std::mutex> lock(consumerMutex);
+        return writtenCount;
+    }
+
+    // Small sequential id of the calling thread, used to tag records
+    static uint64_t currentThreadId()
+    {
+        static std::atomic<uint64_t> nextThreadId{1};
+        thread_local const uint64_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return threadId;
+    }
+
+private:
+    struct Ring
+    {
+        explicit Ring(size_t capacity) : records(capacity) {}
+
+        SpscRing<TimerLogRecord> records;
+        std::atomic<uint64_t> dropped{0}; // Written by the producer only
+    };
+
+    void writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stopRequested) {
+            wakeCondition.wait_for(lock, flushInterval, [this]() { return stopRequested; });
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    void appendNumber(long long value)
+    {
+        char digits[24];
+        const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, result.ptr);
+    }
+
+    void appendRecord(const TimerLogRecord& record)
+    {
+        if (record.prefix != nullptr)
+            buffer.append(record.prefix);
+        appendNumber(record.count);
+        buffer += " (thread ";
+        appendNumber(static_cast<long long>(record.threadId));
+        buffer += ")\n";
+    }
+
+    std::ostream& _ostream;
+    std::chrono::milliseconds flushInterval;
+    PerThread<Ring> rings;
+
+    std::mutex consumerMutex;
+    std::string buffer;
+    uint64_t writtenCount{0};
+    uint64_t reportedDroppedCount{0};
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool stopRequested{false};
+    std::thread writerThread;
+};
+
+//------------------------------------------------------------
+// class AsyncScopePrintTimer
+//
+// ScopePrintTimer that hands its result to a TimerLogSink instead of
+// writing the stream itself. The prefix is stored by pointer, not copied.
+//------------------------------------------------------------
+template<Clock clockType, ChronoDuration durationType>
+class AsyncScopePrintTimer
+{
+public:
+    AsyncScopePrintTimer(const char* printoutPrefix, TimerLogSink& sink = TimerLogSink::global()) :
+        _printoutPrefix(printoutPrefix), _sink(sink)
+    {
+        startTime = clockType::now();
+    }
+
+    ~AsyncScopePrintTimer()
+    {
+        const long long count = std::chrono::duration_cast<durationType>(clockType::now() - startTime).count();
+        _sink.push({_printoutPrefix, count, TimerLogSink::currentThreadId()});
+    }
+
+private:
+    clockType::time_point startTime;
+    const char* _printoutPrefix;
+    TimerLogSink& _sink;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_TIMER_LOG_SINK_H
@@ -0,0 +1,136 @@
+#ifndef CPPUTILS_TIMING_COLLECTOR_H
+#define CPPUTILS_TIMING_COLLECTOR_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/AsymmetricBarrier.h"
+#include "cpputils/CpuRelax.h"
+#include "cpputils/LatencyHistogram.h"
+#include "cpputils/PerThread.h"
+#include "cpputils/Timer.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class ShardedTimingCollector
+//
+// Timing sink shared by any number of threads. Each thread records into
+// its own cache-line aligned shard through plain loads and stores; the
+// hot path has no atomic read-modify-write and touches no shared line.
+//
+// Every shard holds two histograms. Writers only ever record into the
+// one selected by the shard's `active` index. snapshot() flips `active`
+// on all shards, issues one asymmetric heavy barrier, waits for any
+// record that was already in flight, then drains the now idle halves
+// into a reader-side total. Writers never block, and each snapshot is
+// an exact cut: count, sum and histogram always describe the same
+// samples.
+//------------------------------------------------------------
+template<Clock clockType, size_t precisionBits = 7>
+class ShardedTimingCollector
+{
+public:
+    using Histogram = LatencyHistogram<precisionBits>;
+
+    //------------------------------------------------------------
+    // class ShardedTimingCollector::Scope
+    //------------------------------------------------------------
+    class Scope
+    {
+    public:
+        Scope(ShardedTimingCollector& collector) : collector(collector) { startTime = clockType::now(); }
+
+        ~Scope()
+        {
+            collector.record(std::chrono::duration_cast<std::chrono::nanoseconds>(clockType::now() - startTime));
+        }
+
+    private:
+        ShardedTimingCollector& collector;
+        clockType::time_point startTime;
+    };
+
+    ShardedTimingCollector() {}
+
+    void record(std::chrono::nanoseconds duration)
+    {
+        Shard& shard = shards.local();
+
+        // Odd sequence marks a record in flight. The barrier orders that store
+        // before the load of `active` (paired with the heavy barrier in drain()).
+        const uint64_t sequence = shard.sequence.load(std::memory_order_relaxed);
+        shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+        asymmetricLightBarrier();
+
+        const uint32_t active = shard.active.load(std::memory_order_acquire);
+        shard.halves[active].record(duration);
+
+        shard.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    Histogram snapshot()
+    {
+        std::lock_guard<std::mutex> lock(readerMutex);
+        drain();
+        return total;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(readerMutex);
+        drain();
+        total.reset();
+    }
+
+    size_t getShardCount() { return shards.size(); }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint32_t> active{0};
+        std::array<Histogram, 2> halves;
+    };
+
+    // Called with readerMutex held
+    void drain()
+    {
+        shards.forEach([](Shard& shard) {
+            shard.active.store(1 - shard.active.load(std::memory_order_relaxed), std::memory_order_release);
+        });
+
+        asymmetricHeavyBarrier();
+
+        shards.forEach([this](Shard& shard) {
+            // Any record that started after the barrier sees the new `active`. One that
+            // was already running is finished as soon as the sequence moves on.
+            const uint64_t sequence = shard.sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                for (int spins = 0; shard.sequence.load(std::memory_order_acquire) == sequence; spins++) {
+                    if (spins < 64)
+                        cpuRelax();
+                    else
+                        std::this_thread::yield();
+                }
+            }
+
+            Histogram& idle = shard.halves[1 - shard.active.load(std::memory_order_relaxed)];
+            total.merge(idle);
+            idle.reset();
+        });
+    }
+
+    PerThread<Shard> shards;
+    std::mutex readerMutex;
+    Histogram total;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_TIMING_COLLECTOR_H
@@ -0,0 +1,268 @@
+#ifndef CPPUTILS_TIMING_WHEEL_H
+#define CPPUTILS_TIMING_WHEEL_H
+
+#include "cpputils/Timer.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// class TimerNode
+//
+// Intrusive link for TimingWheel. Embed (or derive from) one per timeout
+// owner; the wheel never allocates. A node can be in at most one wheel
+// and must be cancelled before it is destroyed.
+//------------------------------------------------------------
+class TimerNode
+{
+public:
+    TimerNode() {}
+
+    TimerNode(const TimerNode& other) = delete;
+    TimerNode& operator=(const TimerNode& other) = delete;
+
+    bool isScheduled() const { return next != nullptr; }
+
+    // Tick at which the node expires, in the owning wheel's resolution
+    uint64_t getExpiryTick() const { return expiryTick; }
+
+private:
+    template<Clock clockType, size_t slotBits, size_t levelCount>
+    friend class TimingWheel;
+
+    void unlink()
+    {
+        prev->next = next;
+        next->prev = prev;
+        prev = nullptr;
+        next = nullptr;
+    }
+
+    TimerNode* prev{nullptr};
+    TimerNode* next{nullptr};
+    uint64_t expiryTick{0};
+};
+
+//------------------------------------------------------------
+// class TimingWheel
+//
+// Hierarchical timing wheel (Varghese & Lauck). Time is counted in ticks
+// of a configurable resolution. Level 0 has one slot per tick; every
+// further level has slots 2^slotBits times wider, so levelCount levels
+// cover 2^(slotBits * levelCount) ticks (~49 days at 1ms with the
+// defaults). Timers further out wait in the last level and are re-filed
+// when their slot comes around.
+//
+// schedule(), cancel() and re-arming are O(1) list operations. advance()
+// moves the wheel to the current time; when a level-0 slot wraps, the
+// matching slot of the next level is cascaded down. Each expiring slot
+// is detached as one batch before callbacks run, so a callback may
+// re-arm its own node or schedule others. Timers never fire early: an
+// expiry is rounded up to the next tick.
+//
+// Not thread-safe; one wheel per event loop. Destroying the wheel
+// unlinks any timers still scheduled.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock, size_t slotBits = 8, size_t levelCount = 4>
+class TimingWheel
+{
+    static_assert(slotBits >= 1 && levelCount >= 1 && slotBits * levelCount < 64);
+
+public:
+    static constexpr size_t SLOT_COUNT = size_t{1} << slotBits;
+    static constexpr uint64_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr uint64_t MAX_DELTA_TICKS = (uint64_t{1} << (slotBits * levelCount)) - 1;
+
+    explicit TimingWheel(std::chrono::nanoseconds resolution = std::chrono::milliseconds(1),
+                         clockType::time_point startTime = clockType::now()) :
+        resolution(resolution.count() > 0 ? resolution : std::chrono::nanoseconds(1)), startTime(startTime)
+    {
+        for (std::array<TimerNode, SLOT_COUNT>& level : slots) {
+            for (TimerNode& head : level) {
+                head.prev = &head;
+                head.next = &head;
+            }
+        }
+    }
+
+    ~TimingWheel() { clear(); }
+
+    TimingWheel(const TimingWheel& other) = delete;
+    TimingWheel& operator=(const TimingWheel& other) = delete;
+
+    // Schedules (or re-arms) `node` to expire at `expiry`
+    void schedule(TimerNode& node, clockType::time_point expiry)
+    {
+        const std::chrono::nanoseconds offset
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(expiry - startTime);
+        const int64_t offsetNs = offset.count() > 0 ? offset.count() : 0;
+        scheduleTick(node, static_cast<uint64_t>((offsetNs + resolution.count() - 1) / resolution.count()));
+    }
+
+    void scheduleAfter(TimerNode& node, std::chrono::nanoseconds delay)
+    {
+        scheduleTick(node, currentTick + static_cast<uint64_t>((delay.count() + resolution.count() - 1)
+                                                               / resolution.count()));
+    }
+
+    // Schedules (or re-arms) `node` at an absolute tick
+    void scheduleTick(TimerNode& node, uint64_t expiryTick)
+    {
+        if (node.isScheduled())
+            cancel(node);
+
+        node.expiryTick = expiryTick > currentTick ? expiryTick : currentTick + 1;
+        insert(node);
+        scheduledCount++;
+    }
+
+    // No-op for a node that is not scheduled
+    void cancel(TimerNode& node)
+    {
+        if (!node.isScheduled())
+            return;
+
+        node.unlink();
+        scheduledCount--;
+    }
+
+    // Expires every timer due at or before `now`, calling onExpired(TimerNode&)
+    // once per timer. Returns the number of expired timers.
+    template<typename ExpiredFunc>
+    size_t advance(clockType::time_point now, ExpiredFunc&& onExpired)
+    {
+        const std::chrono::nanoseconds offset = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime);
+        if (offset.count() <= 0)
+            return 0;
+        return advanceToTick(static_cast<uint64_t>(offset.count() / resolution.count()), onExpired);
+    }
+
+    template<typename ExpiredFunc>
+    size_t advanceToTick(uint64_t targetTick, ExpiredFunc&& onExpired)
+    {
+        size_t expiredCount = 0;
+        while (currentTick < targetTick) {
+            if (scheduledCount == 0) {
+                currentTick = targetTick;
+                break;
+            }
+
+            currentTick++;
+            for (size_t level = 1; level < levelCount; level++) {
+                if (((currentTick >> (slotBits * (level - 1))) & SLOT_MASK) != 0)
+                    break;
+                cascade(level);
+            }
+
+            // Detach the whole slot first so callbacks can safely re-arm
+            TimerNode& head = slots[0][currentTick & SLOT_MASK];
+            if (head.next == &head)
+                continue;
+
+            TimerNode batch;
+            batch.next = head.next;
+            batch.prev = head.prev;
+            batch.next->prev = &batch;
+            batch.prev->next = &batch;
+            head.next = &head;
+            head.prev = &head;
+
+            while (batch.next != &batch) {
+                TimerNode& node = *batch.next;
+                node.unlink();
+                scheduledCount--;
+                expiredCount++;
+                onExpired(node);
+            }
+        }
+        return expiredCount;
+    }
+
+    // Unschedules every timer without calling anything
+    void clear()
+    {
+        for (std::array<TimerNode, SLOT_COUNT>& level : slots) {
+            for (TimerNode& head : level) {
+                while (head.next != &head) {
+                    head.next->unlink();
+                }
+            }
+        }
+        scheduledCount = 0;
+    }
+
+    size_t size() const { return scheduledCount; }
+
+    uint64_t getCurrentTick() const { return currentTick; }
+
+    std::chrono::nanoseconds getResolution() const { return resolution; }
+
+    clockType::time_point tickToTime(uint64_t tick) const
+    {
+        return startTime
+               + std::chrono::duration_cast<typename clockType::duration>(resolution * static_cast<int64_t>(tick));
+    }
+
+private:
+    void insert(TimerNode& node)
+    {
+        uint64_t expiryTick = node.expiryTick;
+        uint64_t delta = expiryTick - currentTick;
+        if (delta > MAX_DELTA_TICKS) {
+            // Parked in the last level and re-filed when its slot comes around
+            delta = MAX_DELTA_TICKS;
+            expiryTick = currentTick + MAX_DELTA_TICKS;
+        }
+
+        size_t level = 0;
+        while (level + 1 < levelCount && delta >= (uint64_t{1} << (slotBits * (level + 1)))) {
+            level++;
+        }
+
+        TimerNode& head = slots[level][(expiryTick >> (slotBits * level)) & SLOT_MASK];
+        node.prev = head.prev;
+        node.next = &head;
+        head.prev->next = &node;
+        head.prev = &node;
+    }
+
+    void cascade(size_t level)
+    {
+        TimerNode& head = slots[level][(currentTick >> (slotBits * level)) & SLOT_MASK];
+        while (head.next != &head) {
+            TimerNode& node = *head.next;
+            node.unlink();
+            if (node.expiryTick <= currentTick)
+                node.expiryTick = currentTick;
+            insertOrDue(node);
+        }
+    }
+
+    // Cascaded nodes that are due on the current tick go to its level-0 slot,
+    // which advanceToTick() drains right after cascading.
+    void insertOrDue(TimerNode& node)
+    {
+        if (node.expiryTick == currentTick) {
+            TimerNode& head = slots[0][currentTick & SLOT_MASK];
+            node.prev = head.prev;
+            node.next = &head;
+            head.prev->next = &node;
+            head.prev = &node;
+            return;
+        }
+        insert(node);
+    }
+
+    std::chrono::nanoseconds resolution;
+    clockType::time_point startTime;
+    uint64_t currentTick{0};
+    size_t scheduledCount{0};
+    std::array<std::array<TimerNode, SLOT_COUNT>, levelCount> slots;
+};
+
+} // namespace cpputils
+
+#endif // End CPPUTILS_TIMING_WHEEL_H
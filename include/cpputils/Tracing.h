@@ -0,0 +1,375 @@
+#ifndef CPPUTILS_TRACING_H
+#define CPPUTILS_TRACING_H
+
+#include "cpputils/Alignment.h"
+#include "cpputils/PerThread.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace cpputils {
+
+enum class TraceEventType : uint8_t
+{
+    COMPLETE,
+    INSTANT,
+    COUNTER,
+};
+
+//------------------------------------------------------------
+// class Tracer
+//
+// Timeline recorder that exports Chrome Trace Event JSON, loadable in
+// Perfetto (ui.perfetto.dev) or chrome://tracing.
+//
+// Each thread writes into its own fixed-size ring of events, so
+// recording is a thread-local lookup plus a few relaxed stores (with
+// TscClock, a TraceScope costs well under 50ns). Rings overwrite their
+// oldest events when full, so the export always holds at least the last
+// eventsPerThread events of every thread. Recording is switched on and off at runtime with setEnabled();
+// while disabled a TraceScope does not even read the clock.
+//
+// Event names and categories are stored by pointer and must outlive the
+// Tracer (string literals).
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class Tracer
+{
+public:
+    explicit Tracer(size_t eventsPerThread = 65536) :
+        buffers([eventsPerThread]() { return std::make_unique<ThreadBuffer>(eventsPerThread); })
+    {}
+
+    Tracer(const Tracer& other) = delete;
+    Tracer& operator=(const Tracer& other) = delete;
+
+    static Tracer& instance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void setThreadName(const std::string& name)
+    {
+        ThreadBuffer& buffer = buffers.local();
+        std::lock_guard<std::mutex> lock(namesMutex);
+        buffer.name = name;
+    }
+
+    void complete(const char* name, const char* category, clockType::time_point start, clockType::time_point end)
+    {
+        write(TraceEventType::COMPLETE, name, category, toNs(start), toNs(end) - toNs(start), 0);
+    }
+
+    void instant(const char* name, const char* category = "")
+    {
+        if (isEnabled())
+            write(TraceEventType::INSTANT, name, category, toNs(clockType::now()), 0, 0);
+    }
+
+    void counter(const char* name, double value)
+    {
+        if (isEnabled())
+            write(TraceEventType::COUNTER, name, "", toNs(clockType::now()), 0, std::bit_cast<uint64_t>(value));
+    }
+
+    void clear()
+    {
+        buffers.forEach([](ThreadBuffer& buffer) {
+            buffer.exportedFrom = buffer.head.load(std::memory_order_acquire);
+        });
+    }
+
+    void exportJson(std::ostream& ostream)
+    {
+        std::vector<ExportedEvent> events;
+        std::vector<std::pair<uint64_t, std::string>> threadNames;
+        buffers.forEach([&events, &threadNames, this](ThreadBuffer& buffer) {
+            copyEvents(buffer, events);
+            std::lock_guard<std::mutex> lock(namesMutex);
+            if (!buffer.name.empty())
+                threadNames.emplace_back(buffer.threadId, buffer.name);
+        });
+
+        std::sort(events.begin(), events.end(), [](const ExportedEvent& a, const ExportedEvent& b) {
+            return a.timestampNs < b.timestampNs;
+        });
+        const int64_t originNs = events.empty() ? 0 : events.front().timestampNs;
+        const uint64_t pid = processId();
+
+        ostream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const std::pair<uint64_t, std::string>& threadName : threadNames) {
+            ostream << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                    << ",\"tid\":" << threadName.first << ",\"args\":{\"name\":";
+            writeString(ostream, threadName.second.c_str());
+            ostream << "}}";
+            first = false;
+        }
+
+        for (const ExportedEvent& event : events) {
+            ostream << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(ostream, event.name);
+            ostream << ",\"cat\":";
+            writeString(ostream, event.category);
+            ostream << ",\"pid\":" << pid << ",\"tid\":" << event.threadId << ",\"ts\":";
+            writeMicroseconds(ostream, event.timestampNs - originNs);
+
+            switch (event.type) {
+                case TraceEventType::COMPLETE: {
+                    ostream << ",\"ph\":\"X\",\"dur\":";
+                    writeMicroseconds(ostream, event.durationNs);
+                    break;
+                }
+                case TraceEventType::INSTANT: {
+                    ostream << ",\"ph\":\"i\",\"s\":\"t\"";
+                    break;
+                }
+                case TraceEventType::COUNTER: {
+                    char value[32];
+                    const double counterValue = std::bit_cast<double>(event.value);
+                    const int length = std::snprintf(value, sizeof(value), "%.17g", counterValue);
+                    ostream << ",\"ph\":\"C\",\"args\":{\"value\":";
+                    ostream.write(value, length);
+                    ostream << "}";
+                    break;
+                }
+            }
+            ostream << "}";
+            first = false;
+        }
+        ostream << "\n]}\n";
+        ostream.flush();
+    }
+
+    bool exportJsonFile(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "ERROR cpputils Tracer::exportJsonFile() Could not open " << path << std::endl;
+            return false;
+        }
+        exportJson(file);
+        return file.good();
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<int64_t> timestampNs{0};
+        std::atomic<int64_t> durationNs{0};
+        std::atomic<uint64_t> value{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const char*> category{nullptr};
+        std::atomic<TraceEventType> type{TraceEventType::INSTANT};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ThreadBuffer
+    {
+        explicit ThreadBuffer(size_t requestedCapacity) : threadId(currentThreadId())
+        {
+            // One spare slot: the oldest slot may be mid-overwrite during an export
+            size_t capacity = 1;
+            while (capacity < requestedCapacity + 1) {
+                capacity <<= 1;
+            }
+            mask = capacity - 1;
+            slots = std::make_unique<Slot[]>(capacity);
+        }
+
+        std::atomic<uint64_t> head{0};
+        uint64_t mask{0};
+        std::unique_ptr<Slot[]> slots;
+        uint64_t threadId;
+
+        // Exporter side, guarded by the PerThread registration lock
+        uint64_t exportedFrom{0};
+        std::string name;
+    };
+
+    struct ExportedEvent
+    {
+        int64_t timestampNs;
+        int64_t durationNs;
+        uint64_t value;
+        const char* name;
+        const char* category;
+        TraceEventType type;
+        uint64_t threadId;
+    };
+
+    void write(TraceEventType type,
+               const char* name,
+               const char* category,
+               int64_t timestampNs,
+               int64_t durationNs,
+               uint64_t value)
+    {
+        ThreadBuffer& buffer = buffers.local();
+        const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+
+        // Pairs with the acquire fence in copyEvents(): an exporter that sees any of
+        // these stores also sees head >= this index and discards the overwritten slot.
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Slot& slot = buffer.slots[head & buffer.mask];
+        slot.timestampNs.store(timestampNs, std::memory_order_relaxed);
+        slot.durationNs.store(durationNs, std::memory_order_relaxed);
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.type.store(type, std::memory_order_relaxed);
+
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    static void copyEvents(ThreadBuffer& buffer, std::vector<ExportedEvent>& events)
+    {
+        const uint64_t capacity = buffer.mask + 1;
+        const uint64_t end = buffer.head.load(std::memory_order_acquire);
+        const uint64_t begin = std::max(buffer.exportedFrom, end > capacity ? end - capacity : 0);
+
+        const size_t firstCopied = events.size();
+        for (uint64_t i = begin; i < end; i++) {
+            const Slot& slot = buffer.slots[i & buffer.mask];
+            events.push_back({slot.timestampNs.load(std::memory_order_relaxed),
+                              slot.durationNs.load(std::memory_order_relaxed),
+                              slot.value.load(std::memory_order_relaxed),
+                              slot.name.load(std::memory_order_relaxed),
+                              slot.category.load(std::memory_order_relaxed),
+                              slot.type.load(std::memory_order_relaxed),
+                              buffer.threadId});
+        }
+
+        // Slots the writer may have reused while we were copying are dropped
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t headAfterCopy = buffer.head.load(std::memory_order_relaxed);
+        const uint64_t firstValid = headAfterCopy + 1 > capacity ? headAfterCopy + 1 - capacity : 0;
+        if (firstValid > begin) {
+            const size_t overwritten = static_cast<size_t>(std::min(firstValid, end) - begin);
+            events.erase(events.begin() + firstCopied, events.begin() + firstCopied + overwritten);
+        }
+    }
+
+    static int64_t toNs(clockType::time_point timePoint)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+    }
+
+    static void writeMicroseconds(std::ostream& ostream, int64_t ns)
+    {
+        char text[32];
+        const int length = std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                                         static_cast<long long>(ns < 0 ? -(ns % 1000) : ns % 1000));
+        ostream.write(text, length);
+    }
+
+    static void writeString(std::ostream& ostream, const char* text)
+    {
+        ostream << '"';
+        for (const char* c = text != nullptr ? text : ""; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                ostream << '\\' << *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+                ostream << escaped;
+            }
+            else {
+                ostream << *c;
+            }
+        }
+        ostream << '"';
+    }
+
+    static uint64_t currentThreadId()
+    {
+#if defined(_WIN32)
+        return GetCurrentThreadId();
+#elif defined(__linux__)
+        return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+        return std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+    }
+
+    static uint64_t processId()
+    {
+#if defined(_WIN32)
+        return GetCurrentProcessId();
+#else
+        return static_cast<uint64_t>(getpid());
+#endif
+    }
+
+    std::atomic<bool> enabled{false};
+    PerThread<ThreadBuffer> buffers;
+    std::mutex namesMutex;
+};
+
+//------------------------------------------------------------
+// class TraceScope
+//
+// Records one complete ("X") event covering its lifetime.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category = "", Tracer<clockType>& tracer = Tracer<clockType>::instance()) :
+        tracer(tracer), name(name), category(category), active(tracer.isEnabled())
+    {
+        if (active)
+            startTime = clockType::now();
+    }
+
+    ~TraceScope()
+    {
+        if (active)
+            tracer.complete(name, category, startTime, clockType::now());
+    }
+
+    TraceScope(const TraceScope& other) = delete;
+    TraceScope& operator=(const TraceScope& other) = delete;
+
+private:
+    Tracer<clockType>& tracer;
+    const char* name;
+    const char* category;
+    bool active;
+    clockType::time_point startTime{};
+};
+
+} // namespace cpputils
+
+#define CPPUTILS_TRACE_CONCAT_INNER(a, b) a##b
+#define CPPUTILS_TRACE_CONCAT(a, b) CPPUTILS_TRACE_CONCAT_INNER(a, b)
+
+// Traces the rest of the enclosing scope in the global Tracer<>
+#define CPPUTILS_TRACE_SCOPE(name) ::cpputils::TraceScope<> CPPUTILS_TRACE_CONCAT(cpputilsTraceScope, __LINE__)(name)
+
+#endif // End CPPUTILS_TRACING_H
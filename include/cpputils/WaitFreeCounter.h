@@ -2,6 +2,7 @@
 #define CPPUTILS_WAIT_FREE_COUNTER_H
 
 #include <atomic>
+#include <cstdint>
 
 /*
 class: Counter
@@ -17,11 +18,17 @@ class Counter
     static constexpr uint64_t helped = 1ull << 62;
 
 public:
-    bool increment_if_not_zero() { return (counter.fetch_add(1) & is_zero) == 0; }
+    bool increment_if_not_zero() { return increment_if_not_zero(1); }
 
-    bool decrement()
+    bool decrement() { return decrement(1); }
+
+    // Bulk variants: add or drop n references in one atomic step. decrement(n)
+    // returns true if it took the counter to zero; n must not exceed the count.
+    bool increment_if_not_zero(uint64_t n) { return (counter.fetch_add(n) & is_zero) == 0; }
+
+    bool decrement(uint64_t n)
     {
-        if (counter.fetch_sub(1) == 1) {
+        if (counter.fetch_sub(n) == n) {
             uint64_t e = 0;
             if (counter.compare_exchange_strong(e, is_zero))
                 return true;
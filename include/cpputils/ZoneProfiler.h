@@ -0,0 +1,279 @@
+#ifndef CPPUTILS_ZONE_PROFILER_H
+#define CPPUTILS_ZONE_PROFILER_H
+
+#include "cpputils/LatencyHistogram.h"
+#include "cpputils/PerThread.h"
+#include "cpputils/Timer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace cpputils {
+
+//------------------------------------------------------------
+// struct ZoneSite
+//
+// Compile-time identity of a profiled zone. Declared as a function-local
+// static by CPPUTILS_PROFILE_ZONE, so the zone is identified by the
+// address of its site and entering it never hashes or copies strings.
+//------------------------------------------------------------
+struct ZoneSite
+{
+    const char* name;
+    std::source_location location;
+};
+
+//------------------------------------------------------------
+// class ZoneProfiler
+//
+// Hierarchical scoped profiler. Every thread keeps its own call tree and
+// a pointer to the zone it is currently inside; entering a zone looks up
+// (or on first visit, allocates) the matching child of that node, so
+// nesting falls out of the per-thread stack automatically.
+//
+// Each node accumulates call count, inclusive time, time spent in child
+// zones (exclusive = inclusive - children) and a coarse LatencyHistogram.
+// Node counters are only written by the owning thread with relaxed
+// load/store pairs, so collect()/dump() can run at any time while other
+// threads keep profiling. collect() merges all thread trees by call path.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class ZoneProfiler
+{
+public:
+    using Histogram = LatencyHistogram<4>;
+
+    struct Node
+    {
+        Node(const ZoneSite* site, Node* parent) : site(site), parent(parent)
+        {
+            for (std::atomic<uint64_t>& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        Node* child(const ZoneSite& childSite, std::vector<std::unique_ptr<Node>>& owner)
+        {
+            for (Node* node = firstChild.load(std::memory_order_relaxed); node != nullptr; node = node->nextSibling) {
+                if (node->site == &childSite)
+                    return node;
+            }
+
+            owner.push_back(std::make_unique<Node>(&childSite, this));
+            Node* node = owner.back().get();
+            node->nextSibling = firstChild.load(std::memory_order_relaxed);
+            firstChild.store(node, std::memory_order_release);
+            return node;
+        }
+
+        void record(uint64_t elapsedNs)
+        {
+            add(calls, 1);
+            add(inclusiveNs, elapsedNs);
+            add(buckets[Histogram::bucketIndex(elapsedNs)], 1);
+        }
+
+        static void add(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            // Single writer: a plain load/store pair, no locked instruction
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        const ZoneSite* site;
+        Node* parent;
+        std::atomic<Node*> firstChild{nullptr};
+        Node* nextSibling{nullptr};
+
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> inclusiveNs{0};
+        std::atomic<uint64_t> childrenNs{0};
+        std::array<std::atomic<uint64_t>, Histogram::BUCKET_COUNT> buckets;
+    };
+
+    struct ThreadTree
+    {
+        ThreadTree() : root(nullptr, nullptr), current(&root) {}
+
+        Node root;
+        Node* current;
+        std::vector<std::unique_ptr<Node>> nodes;
+    };
+
+    //------------------------------------------------------------
+    // struct ZoneProfiler::ReportNode
+    //
+    // Merged, detached copy of one call path across every thread.
+    //------------------------------------------------------------
+    struct ReportNode
+    {
+        const ZoneSite* site{nullptr};
+        uint64_t calls{0};
+        uint64_t inclusiveNs{0};
+        uint64_t childrenNs{0};
+        Histogram histogram;
+        std::vector<std::unique_ptr<ReportNode>> children;
+
+        uint64_t getExclusiveNs() const { return inclusiveNs > childrenNs ? inclusiveNs - childrenNs : 0; }
+
+        const ReportNode* find(const char* name) const
+        {
+            for (const std::unique_ptr<ReportNode>& child : children) {
+                if (std::string(child->site->name) == name)
+                    return child.get();
+            }
+            return nullptr;
+        }
+    };
+
+    ZoneProfiler() {}
+
+    static ZoneProfiler& instance()
+    {
+        static ZoneProfiler profiler;
+        return profiler;
+    }
+
+    ThreadTree& threadTree() { return threads.local(); }
+
+    std::unique_ptr<ReportNode> collect()
+    {
+        std::unique_ptr<ReportNode> report = std::make_unique<ReportNode>();
+        threads.forEach([&report](ThreadTree& tree) { mergeChildren(*report, tree.root); });
+        return report;
+    }
+
+    void dump(std::ostream& ostream = std::cout)
+    {
+        std::unique_ptr<ReportNode> report = collect();
+
+        // Leave the caller's stream formatting as it was
+        const std::ios_base::fmtflags flags = ostream.flags();
+        const std::streamsize precision = ostream.precision();
+        ostream << std::left << std::setw(48) << "zone" << std::right << std::setw(12) << "calls" << std::setw(14)
+                << "incl ms" << std::setw(14) << "excl ms" << std::setw(12) << "mean us" << std::setw(12) << "p50 us"
+                << std::setw(12) << "p99 us" << '\n';
+        for (const std::unique_ptr<ReportNode>& child : report->children) {
+            dumpNode(ostream, *child, 0);
+        }
+        ostream.flags(flags);
+        ostream.precision(precision);
+        ostream.flush();
+    }
+
+private:
+    static void mergeChildren(ReportNode& target, const Node& source)
+    {
+        for (const Node* node = source.firstChild.load(std::memory_order_acquire); node != nullptr;
+             node = node->nextSibling) {
+            ReportNode* merged = nullptr;
+            for (std::unique_ptr<ReportNode>& child : target.children) {
+                if (child->site == node->site) {
+                    merged = child.get();
+                    break;
+                }
+            }
+            if (merged == nullptr) {
+                target.children.push_back(std::make_unique<ReportNode>());
+                merged = target.children.back().get();
+                merged->site = node->site;
+            }
+
+            merged->calls += node->calls.load(std::memory_order_relaxed);
+            merged->inclusiveNs += node->inclusiveNs.load(std::memory_order_relaxed);
+            merged->childrenNs += node->childrenNs.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+                const uint64_t count = node->buckets[i].load(std::memory_order_relaxed);
+                if (count != 0)
+                    merged->histogram.record(std::chrono::nanoseconds(Histogram::bucketLowerBound(i)), count);
+            }
+
+            mergeChildren(*merged, *node);
+        }
+    }
+
+    static void dumpNode(std::ostream& ostream, ReportNode& node, size_t depth)
+    {
+        std::sort(node.children.begin(), node.children.end(), [](const auto& a, const auto& b) {
+            return a->inclusiveNs > b->inclusiveNs;
+        });
+
+        const std::string label = std::string(depth * 2, ' ') + node.site->name;
+        const double meanUs = node.calls == 0 ? 0.0 : static_cast<double>(node.inclusiveNs) / node.calls / 1e3;
+        ostream << std::left << std::setw(48) << label << std::right << std::fixed << std::setprecision(3)
+                << std::setw(12) << node.calls << std::setw(14) << node.inclusiveNs / 1e6 << std::setw(14)
+                << node.getExclusiveNs() / 1e6 << std::setw(12) << meanUs << std::setw(12)
+                << node.histogram.getPercentile(50.0).count() / 1e3 << std::setw(12)
+                << node.histogram.getPercentile(99.0).count() / 1e3 << '\n';
+
+        for (const std::unique_ptr<ReportNode>& child : node.children) {
+            dumpNode(ostream, *child, depth + 1);
+        }
+    }
+
+    PerThread<ThreadTree> threads;
+};
+
+//------------------------------------------------------------
+// class ZoneScope
+//
+// RAII zone. Entering costs a per-thread lookup, a walk of the parent's
+// child list (pointer compares) and one clock read; leaving costs one
+// clock read and a handful of thread-owned counter updates.
+//------------------------------------------------------------
+template<Clock clockType = std::chrono::steady_clock>
+class ZoneScope
+{
+public:
+    ZoneScope(const ZoneSite& site, ZoneProfiler<clockType>& profiler = ZoneProfiler<clockType>::instance()) :
+        tree(profiler.threadTree())
+    {
+        parent = tree.current;
+        node = parent->child(site, tree.nodes);
+        tree.current = node;
+        startTime = clockType::now();
+    }
+
+    ~ZoneScope()
+    {
+        const std::chrono::nanoseconds elapsed
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(clockType::now() - startTime);
+        const uint64_t elapsedNs = elapsed.count() > 0 ? static_cast<uint64_t>(elapsed.count()) : 0;
+
+        node->record(elapsedNs);
+        ZoneProfiler<clockType>::Node::add(parent->childrenNs, elapsedNs);
+        tree.current = parent;
+    }
+
+    ZoneScope(const ZoneScope& other) = delete;
+    ZoneScope& operator=(const ZoneScope& other) = delete;
+
+private:
+    typename ZoneProfiler<clockType>::ThreadTree& tree;
+    typename ZoneProfiler<clockType>::Node* parent;
+    typename ZoneProfiler<clockType>::Node* node;
+    clockType::time_point startTime;
+};
+
+} // namespace cpputils
+
+#define CPPUTILS_ZONE_CONCAT_INNER(a, b) a##b
+#define CPPUTILS_ZONE_CONCAT(a, b) CPPUTILS_ZONE_CONCAT_INNER(a, b)
+
+// Profiles the rest of the enclosing scope as a zone called `name` in the
+// global ZoneProfiler<>. `name` must be a string literal.
+#define CPPUTILS_PROFILE_ZONE(name)                                                                                    \
+    static constexpr ::cpputils::ZoneSite CPPUTILS_ZONE_CONCAT(cpputilsZoneSite, __LINE__){                           \
+        name, std::source_location::current()};                                                                        \
+    ::cpputils::ZoneScope<> CPPUTILS_ZONE_CONCAT(cpputilsZoneScope, __LINE__)(                                         \
+        CPPUTILS_ZONE_CONCAT(cpputilsZoneSite, __LINE__))
+
+#endif // End CPPUTILS_ZONE_PROFILER_H
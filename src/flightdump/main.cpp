@@ -0,0 +1,88 @@
+#include "cpputils/FlightRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Prints the events of a FlightRecorder file, oldest first.
+// Usage: cpputils_flightdump FILE [--last-seconds=S]
+
+static void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " FILE [--last-seconds=S]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    double lastSeconds = 0.0;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument.rfind("--last-seconds=", 0) == 0) {
+            lastSeconds = std::atof(argument.c_str() + sizeof("--last-seconds=") - 1);
+        } else if (argument == "--help" || argument == "-h" || !path.empty()) {
+            printUsage(argv[0]);
+            return argument == "--help" || argument == "-h" ? EXIT_SUCCESS : EXIT_FAILURE;
+        } else {
+            path = argument;
+        }
+    }
+    if (path.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cpputils::FlightRecordReader reader(path);
+    if (!reader.valid())
+        return EXIT_FAILURE;
+
+    const std::vector<cpputils::FlightRecordReader::ThreadInfo> threads = reader.getThreads();
+    const std::vector<cpputils::FlightRecordReader::Record> records
+        = lastSeconds > 0.0 ? reader.readLastEvents(std::chrono::nanoseconds(static_cast<int64_t>(lastSeconds * 1e9)))
+                            : reader.readEvents();
+
+    std::cout << "# pid " << reader.getProcessId() << ", " << threads.size() << "/" << reader.getThreadCapacity()
+              << " threads, " << reader.getEventsPerThread() << " events per thread, " << reader.getDroppedEvents()
+              << " dropped\n";
+    for (size_t i = 0; i < threads.size(); i++) {
+        std::cout << "# thread " << i << ": tid " << threads[i].threadId << " \"" << threads[i].name << "\" "
+                  << threads[i].eventsWritten << " events written\n";
+    }
+
+    // wall time (unix seconds)  offset to the last event  thread  type  name  value
+    const int64_t lastNs = records.empty() ? 0 : records.back().timestampNs;
+    for (const cpputils::FlightRecordReader::Record& record : records) {
+        char line[64];
+        std::snprintf(line, sizeof(line), "%lld.%09lld %+.6f %3u ",
+                      static_cast<long long>(record.wallTimeNs / 1'000'000'000),
+                      static_cast<long long>(record.wallTimeNs % 1'000'000'000),
+                      static_cast<double>(record.timestampNs - lastNs) / 1e9, record.threadIndex);
+        std::cout << line;
+
+        switch (record.type) {
+            case cpputils::FlightEventType::SCOPE: {
+                std::cout << "SCOPE   " << reader.getName(record.nameId) << " " << record.getDurationNs() << "ns";
+                break;
+            }
+            case cpputils::FlightEventType::COUNTER: {
+                std::cout << "COUNTER " << reader.getName(record.nameId) << " " << record.getCounterValue();
+                break;
+            }
+            case cpputils::FlightEventType::MARKER: {
+                std::cout << "MARKER  " << reader.getName(record.nameId) << " " << record.getPayload();
+                break;
+            }
+            default: {
+                std::cout << "UNKNOWN " << reader.getName(record.nameId) << " " << record.value;
+                break;
+            }
+        }
+        std::cout << '\n';
+    }
+    std::cout.flush();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/AllocationTracker.h"
+#include "cpputils/Benchmark.h"
+
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+CPPUTILS_DEFINE_ALLOCATION_HOOKS();
+
+namespace {
+
+class AllocationTrackerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { cpputils::AllocationTracker::setEnabled(true); }
+    void TearDown() override { cpputils::AllocationTracker::setEnabled(false); }
+};
+
+struct alignas(128) OverAligned
+{
+    char data[128];
+};
+
+// Keeps the compiler from eliding a new/delete pair it can see both ends of
+template<typename T>
+T* escape(T* ptr)
+{
+    cpputils::doNotOptimize(ptr);
+    return ptr;
+}
+
+} // namespace
+
+TEST_F(AllocationTrackerTest, HooksAreInstalled)
+{
+    EXPECT_TRUE(cpputils::AllocationTracker::hooksInstalled());
+}
+
+TEST_F(AllocationTrackerTest, ScopeCountsAllocationsAndBytes)
+{
+    cpputils::AllocationScope<> scope;
+    {
+        std::unique_ptr<int> single(escape(new int(1)));
+        std::unique_ptr<char[]> array(escape(new char[1000]));
+        std::unique_ptr<OverAligned> aligned(escape(new OverAligned()));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 128, 0u);
+        EXPECT_EQ(scope.getAllocations(), 3u);
+        EXPECT_GE(scope.getBytesAllocated(), 1000u + sizeof(int) + sizeof(OverAligned));
+    }
+    EXPECT_EQ(scope.getDeallocations(), 3u);
+    EXPECT_EQ(scope.getNetBytes(), 0);
+    EXPECT_GE(scope.getPeakBytes(), 1000 + static_cast<int64_t>(sizeof(OverAligned)));
+}
+
+TEST_F(AllocationTrackerTest, HotPathWithoutAllocations)
+{
+    std::vector<int> values;
+    values.reserve(64);
+
+    cpputils::AllocationScope<> scope;
+    for (int i = 0; i < 64; i++) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(scope.getAllocations(), 0u);
+
+    values.push_back(64); // Grows past capacity
+    EXPECT_EQ(scope.getAllocations(), 1u);
+    EXPECT_DOUBLE_EQ(scope.getAllocationsPerOp(65), 1.0 / 65);
+}
+
+TEST_F(AllocationTrackerTest, NestedScopePeakIsRelative)
+{
+    std::unique_ptr<char[]> outerBlock(escape(new char[4096]));
+    cpputils::AllocationScope<> outer;
+    std::unique_ptr<char[]> first(escape(new char[2048]));
+    {
+        cpputils::AllocationScope<> inner;
+        std::unique_ptr<char[]> second(escape(new char[512]));
+        second.reset();
+        EXPECT_GE(inner.getPeakBytes(), 512);
+        EXPECT_LT(inner.getPeakBytes(), 2048);
+    }
+    EXPECT_GE(outer.getPeakBytes(), 2048 + 512);
+}
+
+TEST_F(AllocationTrackerTest, DisabledTrackerCountsNothing)
+{
+    cpputils::AllocationTracker::setEnabled(false);
+    cpputils::AllocationScope<> scope;
+    std::unique_ptr<int> value(escape(new int(7)));
+    EXPECT_EQ(scope.getAllocations(), 0u);
+}
+
+TEST_F(AllocationTrackerTest, ScopePrintAllocationsReports)
+{
+    std::ostringstream output;
+    {
+        cpputils::ScopePrintAllocations<std::chrono::steady_clock, std::chrono::microseconds> scope("region us: ",
+                                                                                                    output);
+        std::unique_ptr<int> value(escape(new int(7)));
+    }
+    EXPECT_NE(output.str().find("region us: "), std::string::npos);
+    EXPECT_NE(output.str().find(" allocs=1 "), std::string::npos);
+}
+
+TEST(TrackingMemoryResource, CountsExactPmrRequests)
+{
+    cpputils::TrackingMemoryResource resource;
+    {
+        std::pmr::vector<int> values(&resource);
+        values.reserve(100);
+        EXPECT_EQ(resource.getAllocations(), 1u);
+        EXPECT_EQ(resource.getBytesAllocated(), 100 * sizeof(int));
+        EXPECT_EQ(resource.getCurrentBytes(), static_cast<int64_t>(100 * sizeof(int)));
+    }
+    EXPECT_EQ(resource.getDeallocations(), 1u);
+    EXPECT_EQ(resource.getCurrentBytes(), 0);
+    EXPECT_EQ(resource.getPeakBytes(), static_cast<int64_t>(100 * sizeof(int)));
+}
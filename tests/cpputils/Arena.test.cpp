@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/Arena.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool isAligned(const void* pointer, size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+struct Point
+{
+    int x{0};
+    int y{0};
+};
+
+} // namespace
+
+TEST(Arena, AllocationsAreAlignedAndDisjoint)
+{
+    cpputils::Arena arena(1024);
+    char* previous = nullptr;
+    for (size_t alignment : {size_t{1}, size_t{8}, size_t{16}, size_t{64}, size_t{256}, size_t{4096}}) {
+        char* memory = static_cast<char*>(arena.allocate(24, alignment));
+        ASSERT_NE(memory, nullptr);
+        EXPECT_TRUE(isAligned(memory, alignment)) << alignment;
+        if (previous != nullptr && memory > previous) {
+            EXPECT_GE(memory, previous + 24);
+        }
+        previous = memory;
+    }
+
+    Point* point = arena.create<Point>(Point{3, 4});
+    EXPECT_EQ(point->y, 4);
+    uint64_t* values = arena.allocateArray<uint64_t>(100);
+    ASSERT_NE(values, nullptr);
+    EXPECT_TRUE(isAligned(values, alignof(uint64_t)));
+}
+
+TEST(Arena, ResetReusesBlocks)
+{
+    cpputils::Arena arena(4096);
+    std::vector<void*> first;
+    for (int i = 0; i < 100; i++) {
+        first.push_back(arena.allocate(100));
+    }
+    const size_t blocks = arena.getBlockCount();
+    EXPECT_GT(blocks, 1u);
+
+    arena.reset();
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(arena.allocate(100), first[i]);
+    }
+    EXPECT_EQ(arena.getBlockCount(), blocks);
+
+    arena.release();
+    EXPECT_EQ(arena.getBlockCount(), 0u);
+    EXPECT_NE(arena.allocate(8), nullptr);
+}
+
+TEST(Arena, OversizedAllocationGetsItsOwnBlock)
+{
+    cpputils::Arena arena(1024);
+    arena.allocate(16);
+    void* big = arena.allocate(10'000, 512);
+    ASSERT_NE(big, nullptr);
+    EXPECT_TRUE(isAligned(big, 512));
+    EXPECT_EQ(arena.getBlockCount(), 2u);
+    EXPECT_GE(arena.getBytesReserved(), 1024u + 10'000u);
+
+    // The big block stays for the next request of the same shape
+    arena.reset();
+    arena.allocate(16);
+    EXPECT_EQ(arena.allocate(10'000, 512), big);
+    EXPECT_EQ(arena.getBlockCount(), 2u);
+}
+
+TEST(Arena, MarkAndScopeRewind)
+{
+    cpputils::Arena arena(256);
+    arena.allocate(32);
+    const cpputils::Arena::Mark mark = arena.mark();
+    void* scratch = arena.allocate(64);
+    for (int i = 0; i < 20; i++) {
+        arena.allocate(64); // Spills into more blocks
+    }
+    arena.rewind(mark);
+    EXPECT_EQ(arena.allocate(64), scratch);
+
+    void* outer = nullptr;
+    {
+        cpputils::Arena::Scope scope(arena);
+        outer = arena.allocate(16);
+        {
+            cpputils::Arena::Scope inner(arena);
+            arena.allocate(200);
+        }
+        EXPECT_NE(arena.allocate(16), outer);
+    }
+    EXPECT_EQ(arena.allocate(16), outer);
+}
+
+TEST(Arena, BacksPmrContainers)
+{
+    cpputils::Arena arena(512);
+    cpputils::ArenaResource resource(arena);
+    {
+        std::pmr::vector<int> values(&resource);
+        for (int i = 0; i < 1000; i++) {
+            values.push_back(i);
+        }
+        const std::string original = "a string too long for the small string buffer";
+        std::pmr::string text(original, &resource);
+        text += text;
+        EXPECT_EQ(values[999], 999);
+        EXPECT_EQ(std::string(text), original + original);
+        EXPECT_GT(arena.getBytesReserved(), 1000 * sizeof(int));
+    }
+    EXPECT_TRUE(resource.is_equal(resource));
+    cpputils::ArenaResource other(arena);
+    EXPECT_FALSE(resource.is_equal(other));
+    arena.reset();
+}
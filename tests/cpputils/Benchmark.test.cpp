@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/AllocationTracker.h"
+#include "cpputils/Benchmark.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST(BenchmarkStatistics, MedianAndMadOfOddAndEvenSamples)
+{
+    EXPECT_DOUBLE_EQ(cpputils::BenchmarkStatistics::medianOf({5.0, 1.0, 3.0}), 3.0);
+    EXPECT_DOUBLE_EQ(cpputils::BenchmarkStatistics::medianOf({4.0, 1.0, 3.0, 2.0}), 2.5);
+
+    const cpputils::BenchmarkStatistics statistics = cpputils::BenchmarkStatistics::compute({1.0, 2.0, 3.0, 4.0, 5.0});
+    EXPECT_DOUBLE_EQ(statistics.median, 3.0);
+    EXPECT_DOUBLE_EQ(statistics.mad, 1.4826);
+    EXPECT_DOUBLE_EQ(statistics.mean, 3.0);
+    EXPECT_EQ(statistics.rejected, 0u);
+}
+
+TEST(BenchmarkStatistics, RejectsOutliers)
+{
+    const cpputils::BenchmarkStatistics statistics
+        = cpputils::BenchmarkStatistics::compute({10.0, 10.5, 9.5, 10.0, 10.2, 9.8, 250.0});
+    EXPECT_DOUBLE_EQ(statistics.median, 10.0);
+    EXPECT_EQ(statistics.rejected, 1u);
+    EXPECT_DOUBLE_EQ(statistics.max, 10.5);
+    EXPECT_NEAR(statistics.mean, 10.0, 1e-9);
+}
+
+namespace {
+
+std::atomic<uint64_t> harnessTestIterations{0};
+
+void harnessTestLoop(cpputils::BenchmarkState& state)
+{
+    uint64_t value = 0;
+    while (state.keepRunning()) {
+        value += state.getArg();
+        cpputils::doNotOptimize(value);
+    }
+    harnessTestIterations += state.getIterations();
+    state.setItemsProcessed(state.getIterations());
+    state.setCounter("threadIndexSum", state.getThreadIndex());
+}
+
+CPPUTILS_BENCHMARK(harnessTestLoop).setArgs({1, 7}).setThreads({1, 2}).setIterations(1000).setRepetitions(3);
+
+} // namespace
+
+TEST(BenchmarkRunner, RunsEveryArgAndThreadCountMatchingFilter)
+{
+    cpputils::BenchmarkRunner::Options options;
+    options.filter = "^harnessTestLoop/7/";
+    options.warmupTime = std::chrono::milliseconds(0);
+
+    harnessTestIterations = 0;
+    std::ostringstream console;
+    const std::ios_base::fmtflags flags = console.flags();
+    const std::streamsize precision = console.precision();
+    const std::vector<cpputils::BenchmarkResult> results = cpputils::BenchmarkRunner(options).run(console);
+    EXPECT_EQ(console.flags(), flags);
+    EXPECT_EQ(console.precision(), precision);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].name, "harnessTestLoop/7/threads:1");
+    EXPECT_EQ(results[1].name, "harnessTestLoop/7/threads:2");
+    EXPECT_EQ(results[1].threads, 2);
+    EXPECT_EQ(results[1].iterations, 1000u);
+    EXPECT_EQ(results[1].repetitions, 3u);
+    EXPECT_DOUBLE_EQ(results[1].counters.at("threadIndexSum"), 1.0);
+    EXPECT_GT(results[1].itemsPerSecond, 0.0);
+
+    // One warm-up run plus three repetitions for each thread of each benchmark
+    EXPECT_EQ(harnessTestIterations.load(), (1 + 2) * 4 * 1000u);
+    EXPECT_NE(console.str().find("harnessTestLoop/7/threads:2"), std::string::npos);
+
+    std::ostringstream json;
+    cpputils::BenchmarkRunner::writeJson(json, results);
+    EXPECT_NE(json.str().find("\"name\": \"harnessTestLoop/7/threads:1\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"counters\": {\"threadIndexSum\": 1}"), std::string::npos);
+}
+
+TEST(BenchmarkRunner, WritesNonFiniteValuesAsJsonNull)
+{
+    cpputils::BenchmarkResult result;
+    result.name = "nonFinite";
+    result.nsPerIteration.median = std::numeric_limits<double>::quiet_NaN();
+    result.nsPerIteration.mad = std::numeric_limits<double>::infinity();
+    result.counters["ratio"] = std::numeric_limits<double>::quiet_NaN();
+
+    std::ostringstream json;
+    cpputils::BenchmarkRunner::writeJson(json, {result});
+    EXPECT_NE(json.str().find("\"median_ns\": null, \"mad_ns\": null, \"mean_ns\": 0"), std::string::npos);
+    EXPECT_NE(json.str().find("\"counters\": {\"ratio\": null}"), std::string::npos);
+    EXPECT_EQ(json.str().find("nan"), std::string::npos);
+    EXPECT_EQ(json.str().find("inf"), std::string::npos);
+}
+
+TEST(BenchmarkRunner, ParsesArguments)
+{
+    const char* argv[] = {"bench", "--filter=Clock", "--json=out.json", "--repetitions=5", "--min-time-ms=20"};
+    cpputils::BenchmarkRunner::Options options;
+    ASSERT_TRUE(cpputils::BenchmarkRunner::parseArguments(5, const_cast<char**>(argv), options));
+    EXPECT_EQ(options.filter, "Clock");
+    EXPECT_EQ(options.jsonPath, "out.json");
+    EXPECT_EQ(options.repetitions, 5u);
+    EXPECT_EQ(options.minTime, std::chrono::milliseconds(20));
+
+    const char* badArgv[] = {"bench", "--bogus"};
+    EXPECT_FALSE(cpputils::BenchmarkRunner::parseArguments(2, const_cast<char**>(badArgv), options));
+}
+
+namespace {
+
+void harnessTestAllocatingLoop(cpputils::BenchmarkState& state)
+{
+    while (state.keepRunning()) {
+        std::unique_ptr<int> value(new int(1));
+        cpputils::doNotOptimize(value);
+    }
+}
+
+CPPUTILS_BENCHMARK(harnessTestAllocatingLoop).setIterations(100).setRepetitions(1);
+
+} // namespace
+
+// Needs CPPUTILS_DEFINE_ALLOCATION_HOOKS() somewhere in the test executable
+TEST(BenchmarkRunner, ReportsAllocationsPerIteration)
+{
+    if (!cpputils::AllocationTracker::hooksInstalled())
+        GTEST_SKIP() << "CPPUTILS_DEFINE_ALLOCATION_HOOKS() is not linked into this executable";
+
+    cpputils::BenchmarkRunner::Options options;
+    options.filter = "^harnessTestAllocatingLoop$";
+    options.warmupTime = std::chrono::milliseconds(0);
+    options.trackAllocations = true;
+
+    std::ostringstream console;
+    const std::vector<cpputils::BenchmarkResult> results = cpputils::BenchmarkRunner(options).run(console);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_DOUBLE_EQ(results[0].counters.at("allocsPerIter"), 1.0);
+    EXPECT_FALSE(cpputils::AllocationTracker::isEnabled());
+}
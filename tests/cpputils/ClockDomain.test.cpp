@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ClockDomain.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class ClockDomainTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { cpputils::SharedMemory::remove(key); }
+    void TearDown() override { cpputils::SharedMemory::remove(key); }
+
+    const std::string key = "cpputils_clock_domain_test";
+};
+
+} // namespace
+
+TEST_F(ClockDomainTest, FirstAttachPublishesCalibration)
+{
+    cpputils::ClockDomain domain(key, 5ms);
+    ASSERT_TRUE(domain.valid());
+
+    const cpputils::ClockCalibration calibration = domain.read();
+    EXPECT_EQ(calibration.generation, 1u);
+    EXPECT_EQ(calibration.useTsc, cpputils::TscClock::isTscInvariant());
+    if (calibration.useTsc) {
+        EXPECT_GT(calibration.ticksPerSecond, 1e8);
+    }
+}
+
+TEST_F(ClockDomainTest, TracksSteadyClock)
+{
+    cpputils::ClockDomain domain(key, 5ms);
+    const int64_t steadyNs
+        = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+              .count();
+    EXPECT_LT(std::abs(domain.nowNs() - steadyNs), 1'000'000);
+
+    const uint64_t ticks = domain.readTicks();
+    const std::chrono::system_clock::time_point wall = domain.toSystemTime(ticks);
+    EXPECT_LT(std::abs(std::chrono::duration_cast<std::chrono::milliseconds>(wall - std::chrono::system_clock::now())
+                           .count()),
+              100);
+}
+
+TEST_F(ClockDomainTest, AttachedDomainsAgreeOnRawStamps)
+{
+    cpputils::ClockDomain first(key, 5ms);
+    // A second attach (in another process, normally) adopts the published record
+    cpputils::ClockDomain second(key, 5ms);
+    EXPECT_EQ(second.read().generation, 1u);
+
+    const uint64_t ticks = first.readTicks();
+    EXPECT_EQ(first.toNs(ticks), second.toNs(ticks));
+}
+
+TEST_F(ClockDomainTest, RecalibrationIsContinuous)
+{
+    cpputils::ClockDomain domain(key, 5ms);
+    cpputils::ClockDomain other(key);
+    const uint64_t before = domain.readTicks();
+    const int64_t beforeNs = domain.toNs(before);
+
+    other.recalibrate(5ms);
+    EXPECT_EQ(domain.read().generation, 2u);
+
+    // Same stamp converts to (nearly) the same time under the new record
+    EXPECT_LT(std::abs(domain.toNs(before) - beforeNs), 100'000);
+    EXPECT_GE(domain.nowNs(), beforeNs);
+}
+
+TEST_F(ClockDomainTest, ReadersSeeConsistentRecordsDuringRecalibration)
+{
+    cpputils::ClockDomain domain(key, 1ms);
+    std::atomic<bool> done{false};
+    std::thread recalibrator([this, &done]() {
+        cpputils::ClockDomain writer(key);
+        for (int i = 0; i < 20; i++) {
+            writer.recalibrate(100us);
+        }
+        done = true;
+    });
+
+    int64_t previousNs = domain.nowNs();
+    while (!done) {
+        const cpputils::ClockCalibration calibration = domain.read();
+        if (calibration.useTsc) {
+            ASSERT_GT(calibration.nsPerTickFixed, 0u);
+        }
+        const int64_t nowNs = domain.nowNs();
+        // Recalibration keeps domain time continuous, allow for rate estimate noise
+        ASSERT_GE(nowNs, previousNs - 100'000);
+        previousNs = nowNs;
+    }
+    recalibrator.join();
+    EXPECT_EQ(domain.read().generation, 21u);
+}
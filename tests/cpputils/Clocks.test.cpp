@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/Clocks.h"
+#include "cpputils/Timer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static_assert(cpputils::Clock<cpputils::TscClock>);
+static_assert(cpputils::Clock<cpputils::CoarseClock>);
+static_assert(cpputils::Clock<cpputils::ThreadCpuClock>);
+static_assert(cpputils::Clock<cpputils::ProcessCpuClock>);
+
+TEST(TscClock, IsMonotonic)
+{
+    cpputils::TscClock::time_point previous = cpputils::TscClock::now();
+    for (int i = 0; i < 100'000; i++) {
+        const cpputils::TscClock::time_point current = cpputils::TscClock::now();
+        ASSERT_GE(current, previous);
+        previous = current;
+    }
+}
+
+TEST(TscClock, TracksSteadyClock)
+{
+    const auto steadyStart = std::chrono::steady_clock::now();
+    const auto tscStart = cpputils::TscClock::now();
+    std::this_thread::sleep_for(50ms);
+    const auto tscElapsed = cpputils::TscClock::now() - tscStart;
+    const auto steadyElapsed = std::chrono::steady_clock::now() - steadyStart;
+
+    // Calibration error over 50ms should be far below a millisecond
+    const auto difference = std::chrono::duration_cast<std::chrono::microseconds>(tscElapsed - steadyElapsed);
+    EXPECT_LT(std::abs(difference.count()), 1000);
+
+    if (cpputils::TscClock::isTscInvariant()) {
+        EXPECT_GT(cpputils::TscClock::getTicksPerSecond(), 1e8);
+    }
+}
+
+TEST(TscClock, WorksWithTimers)
+{
+    cpputils::ImmutableTimer<cpputils::TscClock> timer;
+    std::this_thread::sleep_for(5ms);
+    EXPECT_GE(timer.getElapsedTimeMs(), 4);
+}
+
+TEST(CoarseClock, AdvancesAtItsResolution)
+{
+    EXPECT_GT(cpputils::CoarseClock::getResolution().count(), 0);
+
+    const auto start = cpputils::CoarseClock::now();
+    std::this_thread::sleep_for(cpputils::CoarseClock::getResolution() * 2 + 5ms);
+    EXPECT_GT(cpputils::CoarseClock::now(), start);
+}
+
+TEST(ThreadCpuClock, AdvancesWhileRunningNotWhileSleeping)
+{
+    const auto sleepStart = cpputils::ThreadCpuClock::now();
+    std::this_thread::sleep_for(50ms);
+    const auto sleepCpu = cpputils::ThreadCpuClock::now() - sleepStart;
+    EXPECT_LT(sleepCpu, 10ms);
+
+    const auto spinStart = cpputils::ThreadCpuClock::now();
+    const auto processStart = cpputils::ProcessCpuClock::now();
+    const auto wallStart = std::chrono::steady_clock::now();
+    // Spin until the thread has run 10ms; a busy machine may deschedule it for a while
+    while (cpputils::ThreadCpuClock::now() - spinStart < 10ms && std::chrono::steady_clock::now() - wallStart < 5s) {
+    }
+    EXPECT_GE(cpputils::ThreadCpuClock::now() - spinStart, 10ms);
+    EXPECT_GE(cpputils::ProcessCpuClock::now() - processStart, cpputils::ThreadCpuClock::now() - spinStart - 1ms);
+}
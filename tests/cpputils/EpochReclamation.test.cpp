@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/EpochReclamation.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::atomic<int> liveNodes{0};
+
+struct Node
+{
+    explicit Node(int value) : value(value) { liveNodes++; }
+    ~Node()
+    {
+        value = -1;
+        liveNodes--;
+    }
+
+    int value;
+    Node* next{nullptr};
+};
+
+// Treiber stack: pop() dereferences the head it loaded, so without safe
+// reclamation a concurrent pop() of the same node is a use-after-free and
+// a recycled address is an ABA corruption.
+class Stack
+{
+public:
+    explicit Stack(cpputils::EpochDomain& domain) : domain(domain) {}
+
+    ~Stack()
+    {
+        for (Node* node = head.load(); node != nullptr;) {
+            delete std::exchange(node, node->next);
+        }
+    }
+
+    void push(int value)
+    {
+        Node* node = new Node(value);
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    bool pop(int& value)
+    {
+        Node* node = nullptr;
+        {
+            cpputils::EpochGuard guard(domain);
+            node = head.load(std::memory_order_acquire);
+            while (node != nullptr
+                   && !head.compare_exchange_weak(node, node->next, std::memory_order_acquire,
+                                                  std::memory_order_acquire)) {}
+            if (node == nullptr)
+                return false;
+            value = node->value;
+        }
+        domain.retire(node);
+        return true;
+    }
+
+private:
+    cpputils::EpochDomain& domain;
+    std::atomic<Node*> head{nullptr};
+};
+
+} // namespace
+
+TEST(EpochDomain, RetiredNodeWaitsForOpenGuard)
+{
+    cpputils::EpochDomain domain;
+    std::atomic<Node*> shared{new Node(1)};
+
+    std::atomic<bool> reading{false};
+    std::atomic<bool> release{false};
+    std::atomic<int> seen{0};
+    std::thread reader([&]() {
+        cpputils::EpochGuard guard(domain);
+        Node* node = shared.load(std::memory_order_acquire);
+        reading = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+        seen = node->value;
+    });
+    while (!reading) {
+        std::this_thread::yield();
+    }
+
+    Node* old = shared.exchange(new Node(2));
+    domain.retire(old);
+    for (int i = 0; i < 10; i++) {
+        domain.reclaim();
+    }
+    EXPECT_EQ(domain.getPendingCount(), 1u);
+    EXPECT_EQ(liveNodes.load(), 2);
+
+    release = true;
+    reader.join();
+    EXPECT_EQ(seen.load(), 1);
+
+    domain.synchronize();
+    EXPECT_EQ(domain.getPendingCount(), 0u);
+    EXPECT_EQ(liveNodes.load(), 1);
+    delete shared.load();
+}
+
+TEST(EpochDomain, EpochAdvancesWithoutReaders)
+{
+    cpputils::EpochDomain domain(4);
+    const uint64_t start = domain.getEpoch();
+    for (int i = 0; i < 16; i++) {
+        cpputils::EpochGuard guard(domain);
+        cpputils::EpochGuard nested(domain);
+        domain.retire(new Node(i));
+    }
+    domain.synchronize();
+    EXPECT_GE(domain.getEpoch(), start + 2);
+    EXPECT_EQ(domain.getPendingCount(), 0u);
+    EXPECT_EQ(liveNodes.load(), 0);
+}
+
+TEST(EpochDomain, DestructorFreesPending)
+{
+    {
+        cpputils::EpochDomain domain(1000);
+        for (int i = 0; i < 10; i++) {
+            domain.retire(new Node(i));
+        }
+        EXPECT_EQ(liveNodes.load(), 10);
+    }
+    EXPECT_EQ(liveNodes.load(), 0);
+}
+
+TEST(HazardPointer, ProtectedNodeOutlivesEpochs)
+{
+    cpputils::EpochDomain domain;
+    std::atomic<Node*> shared{new Node(1)};
+
+    cpputils::HazardPointer hazard(domain);
+    Node* held = hazard.protect(shared);
+    ASSERT_EQ(held->value, 1);
+
+    domain.retire(shared.exchange(new Node(2)));
+    domain.retire(new Node(3));
+    domain.synchronize();
+    // The hazard pins only its own node, not the epoch
+    EXPECT_EQ(domain.getPendingCount(), 1u);
+    EXPECT_EQ(held->value, 1);
+
+    hazard.reset();
+    domain.synchronize();
+    EXPECT_EQ(domain.getPendingCount(), 0u);
+    delete shared.load();
+    EXPECT_EQ(liveNodes.load(), 0);
+}
+
+TEST(HazardPointer, ExtraPointersFallBackToGuard)
+{
+    cpputils::EpochDomain domain;
+    std::atomic<Node*> shared{new Node(1)};
+    {
+        std::vector<std::unique_ptr<cpputils::HazardPointer>> hazards;
+        for (int i = 0; i < 10; i++) {
+            hazards.push_back(std::make_unique<cpputils::HazardPointer>(domain));
+            EXPECT_EQ(hazards.back()->protect(shared)->value, 1);
+        }
+    }
+    domain.retire(shared.exchange(nullptr));
+    domain.synchronize();
+    EXPECT_EQ(liveNodes.load(), 0);
+}
+
+TEST(EpochDomain, TreiberStackStress)
+{
+    constexpr int THREAD_COUNT = 8;
+    constexpr int OPERATIONS_PER_THREAD = 50'000;
+
+    std::atomic<long long> pushedSum{0};
+    std::atomic<long long> poppedSum{0};
+    {
+        cpputils::EpochDomain domain(32);
+        Stack stack(domain);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([&, t]() {
+                long long pushed = 0;
+                long long popped = 0;
+                for (int i = 0; i < OPERATIONS_PER_THREAD; i++) {
+                    const int value = t * OPERATIONS_PER_THREAD + i;
+                    stack.push(value);
+                    pushed += value;
+                    int out = 0;
+                    if (stack.pop(out)) {
+                        ASSERT_GE(out, 0);
+                        popped += out;
+                    }
+                }
+                pushedSum += pushed;
+                poppedSum += popped;
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        int out = 0;
+        long long rest = 0;
+        while (stack.pop(out)) {
+            rest += out;
+        }
+        poppedSum += rest;
+        EXPECT_EQ(pushedSum.load(), poppedSum.load());
+    }
+    EXPECT_EQ(liveNodes.load(), 0);
+}
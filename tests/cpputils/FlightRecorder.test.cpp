@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/FlightRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using FlightRecorder = cpputils::FlightRecorder<std::chrono::steady_clock>;
+using FlightScope = cpputils::FlightScope<std::chrono::steady_clock>;
+using FlightRecordReader = cpputils::FlightRecordReader;
+
+static std::string tempPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(FlightRecorder, RecordsScopesCountersAndMarkers)
+{
+    const std::string path = tempPath("cpputils_flight_basic.test");
+    {
+        FlightRecorder recorder(path, 64, 4, 16);
+        ASSERT_TRUE(recorder.valid());
+        const uint32_t frame = recorder.registerName("frame");
+        const uint32_t depth = recorder.registerName("queue depth");
+        const uint32_t marker = recorder.registerName("checkpoint");
+        EXPECT_EQ(recorder.registerName("frame"), frame);
+        recorder.setThreadName("main");
+
+        {
+            FlightScope scope(recorder, frame);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        recorder.counter(depth, 3.5);
+        recorder.marker(marker, -42);
+    }
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ(reader.getDroppedEvents(), 0u);
+    EXPECT_EQ(reader.getEventsPerThread(), 64u);
+
+    const std::vector<FlightRecordReader::ThreadInfo> threads = reader.getThreads();
+    ASSERT_EQ(threads.size(), 1u);
+    EXPECT_EQ(threads[0].name, "main");
+    EXPECT_EQ(threads[0].eventsWritten, 3u);
+
+    const std::vector<FlightRecordReader::Record> records = reader.readEvents();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].type, cpputils::FlightEventType::SCOPE);
+    EXPECT_EQ(reader.getName(records[0].nameId), "frame");
+    EXPECT_GE(records[0].getDurationNs(), 1'000'000);
+    EXPECT_EQ(records[1].type, cpputils::FlightEventType::COUNTER);
+    EXPECT_EQ(reader.getName(records[1].nameId), "queue depth");
+    EXPECT_DOUBLE_EQ(records[1].getCounterValue(), 3.5);
+    EXPECT_EQ(records[2].type, cpputils::FlightEventType::MARKER);
+    EXPECT_EQ(records[2].getPayload(), -42);
+
+    // Wall time is anchored to system_clock at open
+    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+    EXPECT_LE(records[2].wallTimeNs, nowNs);
+    EXPECT_GT(records[2].wallTimeNs, nowNs - 60'000'000'000);
+    std::remove(path.c_str());
+}
+
+TEST(FlightRecorder, RingKeepsNewestEvents)
+{
+    const std::string path = tempPath("cpputils_flight_ring.test");
+    {
+        FlightRecorder recorder(path, 8, 1, 4);
+        const uint32_t name = recorder.registerName("tick");
+        for (int i = 0; i < 20; i++) {
+            recorder.marker(name, i);
+        }
+    }
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    const std::vector<FlightRecordReader::Record> records = reader.readEvents();
+    ASSERT_EQ(records.size(), 8u);
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(records[i].getPayload(), static_cast<int64_t>(12 + i));
+        EXPECT_EQ(records[i].sequence, 13 + i);
+    }
+    EXPECT_EQ(reader.getThreads()[0].eventsWritten, 20u);
+    std::remove(path.c_str());
+}
+
+TEST(FlightRecorder, ReadLastEventsKeepsTimeWindow)
+{
+    const std::string path = tempPath("cpputils_flight_window.test");
+    {
+        FlightRecorder recorder(path, 16, 1, 4);
+        const uint32_t name = recorder.registerName("tick");
+        recorder.marker(name, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        recorder.marker(name, 1);
+        recorder.marker(name, 2);
+    }
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    const std::vector<FlightRecordReader::Record> records = reader.readLastEvents(std::chrono::milliseconds(25));
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].getPayload(), 1);
+    EXPECT_EQ(records[1].getPayload(), 2);
+    std::remove(path.c_str());
+}
+
+TEST(FlightRecorder, ThreadsGetSeparateRingsUpToCapacity)
+{
+    const std::string path = tempPath("cpputils_flight_threads.test");
+    constexpr int THREAD_COUNT = 4;
+    constexpr int EVENT_COUNT = 100;
+    {
+        FlightRecorder recorder(path, 128, 3, 4);
+        const uint32_t name = recorder.registerName("work");
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([&recorder, name, t]() {
+                for (int i = 0; i < EVENT_COUNT; i++) {
+                    recorder.marker(name, t);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ(reader.getThreads().size(), 3u);
+    EXPECT_EQ(reader.getDroppedEvents(), static_cast<uint64_t>(EVENT_COUNT));
+
+    std::map<uint32_t, std::map<int64_t, int>> payloadsByRing;
+    for (const FlightRecordReader::Record& record : reader.readEvents()) {
+        payloadsByRing[record.threadIndex][record.getPayload()]++;
+    }
+    ASSERT_EQ(payloadsByRing.size(), 3u);
+    for (const auto& [ring, payloads] : payloadsByRing) {
+        // Each ring holds one thread's events only
+        ASSERT_EQ(payloads.size(), 1u);
+        EXPECT_EQ(payloads.begin()->second, EVENT_COUNT);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(FlightRecorder, NamesBeyondCapacityDecodeById)
+{
+    const std::string path = tempPath("cpputils_flight_names.test");
+    uint32_t overflow = 0;
+    {
+        FlightRecorder recorder(path, 8, 1, 1);
+        recorder.registerName("first");
+        overflow = recorder.registerName("second");
+        recorder.marker(overflow);
+    }
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ(reader.getName(0), "first");
+    EXPECT_EQ(reader.getName(overflow), "#1");
+    std::remove(path.c_str());
+}
+
+TEST(FlightRecordReader, RejectsFilesThatAreNotRecordings)
+{
+    const std::string path = tempPath("cpputils_flight_garbage.test");
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << std::string(4096, 'x');
+    }
+    EXPECT_FALSE(FlightRecordReader(path).valid());
+    EXPECT_FALSE(FlightRecordReader(tempPath("cpputils_flight_missing.test")).valid());
+    std::remove(path.c_str());
+}
+
+#if GTEST_HAS_DEATH_TEST && defined(__linux__)
+TEST(FlightRecorderDeathTest, EventsSurviveAbort)
+{
+    const std::string path = tempPath("cpputils_flight_crash.test");
+    GTEST_FLAG_SET(death_test_style, "fast");
+    EXPECT_DEATH(
+        {
+            FlightRecorder recorder(path, 64, 2, 4);
+            recorder.setThreadName("doomed");
+            recorder.marker(recorder.registerName("last words"), 7);
+            std::abort();
+        },
+        "");
+
+    FlightRecordReader reader(path);
+    ASSERT_TRUE(reader.valid());
+    const std::vector<FlightRecordReader::Record> records = reader.readEvents();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(reader.getName(records[0].nameId), "last words");
+    EXPECT_EQ(records[0].getPayload(), 7);
+    EXPECT_EQ(reader.getThreads()[0].name, "doomed");
+    std::remove(path.c_str());
+}
+#endif
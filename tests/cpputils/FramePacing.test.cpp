@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/FramePacing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Manually advanced clock so frametimes are exact
+struct ManualClock
+{
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() { return time_point(duration(nowNs)); }
+
+    static inline int64_t nowNs = 0;
+};
+
+} // namespace
+
+TEST(FramePacingTimer, MeanAndStdDevOfWindow)
+{
+    ManualClock::nowNs = 0;
+    cpputils::FramePacingTimer<ManualClock, 4> timer;
+
+    // 10ms, 20ms, 10ms, 20ms
+    for (int i = 0; i < 4; i++) {
+        ManualClock::nowNs += (i % 2 == 0 ? 10 : 20) * 1'000'000;
+        timer.markFrame();
+    }
+    EXPECT_EQ(timer.getSampleCount(), 4u);
+    EXPECT_DOUBLE_EQ(timer.getFrametimeMs(), 15.0);
+    EXPECT_NEAR(timer.getFrametimeStdDevMs(), 5.0, 1e-6);
+
+    // Window slides: the old 10/20ms frames leave, four 16ms frames remain
+    for (int i = 0; i < 4; i++) {
+        ManualClock::nowNs += 16'000'000;
+        timer.markFrame();
+    }
+    EXPECT_DOUBLE_EQ(timer.getFrametimeMs(), 16.0);
+    EXPECT_NEAR(timer.getFrametimeStdDevMs(), 0.0, 1e-6);
+    EXPECT_NEAR(timer.getFramerate(), 62.5, 1e-9);
+}
+
+TEST(FramePacingTimer, LowFrameratesReflectStutter)
+{
+    ManualClock::nowNs = 0;
+    cpputils::FramePacingTimer<ManualClock, 1000> timer;
+
+    // 980 smooth frames at 10ms and 20 hitches at 50ms
+    for (int i = 0; i < 1000; i++) {
+        ManualClock::nowNs += (i % 50 == 0 ? 50 : 10) * 1'000'000;
+        timer.markFrame();
+    }
+
+    EXPECT_NEAR(timer.getFramerate(), 1000.0 / 10.8, 0.01);
+    EXPECT_NEAR(timer.getFrametimePercentile<std::chrono::microseconds>(50.0).count(), 10'000, 200);
+    EXPECT_NEAR(timer.getOnePercentLowFramerate(), 20.0, 0.5);
+    EXPECT_NEAR(timer.getPointOnePercentLowFramerate(), 20.0, 0.5);
+    EXPECT_EQ(timer.getHistogram().getCount(), 1000u);
+
+    timer.reset();
+    EXPECT_EQ(timer.getSampleCount(), 0u);
+    EXPECT_EQ(timer.getFramerate(), 0.0);
+}
+
+TEST(FrameLimiter, HoldsPeriodWithoutEarlyWakeups)
+{
+    constexpr int FRAMES = 50;
+    constexpr auto PERIOD = 2ms;
+
+    // The limiter's first deadline is one period after construction; mirror its schedule
+    auto deadline = std::chrono::steady_clock::now() + PERIOD;
+    cpputils::FrameLimiter<> limiter(PERIOD);
+    std::vector<std::chrono::nanoseconds> lateness;
+    for (int i = 0; i < FRAMES; i++) {
+        const std::chrono::nanoseconds reported = limiter.wait();
+        const auto woke = std::chrono::steady_clock::now();
+        const auto late = std::chrono::duration_cast<std::chrono::nanoseconds>(woke - deadline);
+        EXPECT_GE(late, 0ns) << "frame " << i << " woke before its deadline";
+        EXPECT_LE(reported, late);
+        lateness.push_back(late);
+        // After an overrun the schedule restarts from the limiter's own wake time
+        deadline += reported >= PERIOD ? reported + PERIOD : PERIOD;
+    }
+
+    // A few descheduled frames on a loaded machine do not move the median; oversleeping or drifting every frame does
+    std::sort(lateness.begin(), lateness.end());
+    EXPECT_LT(lateness[FRAMES / 2], 500us);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/Futex.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int THREAD_COUNT = 4;
+constexpr uint64_t INCREMENTS = 50'000;
+
+// Non-atomic counter bumped under `lockAndBump`; lost updates mean broken exclusion
+template<typename LockAndBump>
+uint64_t hammer(LockAndBump&& lockAndBump)
+{
+    uint64_t counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&]() {
+            for (uint64_t i = 0; i < INCREMENTS; i++) {
+                lockAndBump(counter);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return counter;
+}
+
+} // namespace
+
+TEST(Futex, PrimitivesAreSmall)
+{
+    EXPECT_EQ(sizeof(cpputils::AdaptiveMutex), 4u);
+    EXPECT_EQ(sizeof(cpputils::OneShotEvent), 4u);
+    EXPECT_EQ(sizeof(cpputils::Latch), 4u);
+    EXPECT_EQ(sizeof(cpputils::Semaphore), 8u);
+    EXPECT_EQ(sizeof(cpputils::TicketLock), cpputils::CACHE_LINE_SIZE);
+    EXPECT_EQ(sizeof(cpputils::McsLock), sizeof(void*));
+}
+
+TEST(Futex, AdaptiveMutexExcludes)
+{
+    cpputils::AdaptiveMutex mutex;
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+
+    const uint64_t counter = hammer([&mutex](uint64_t& value) {
+        std::lock_guard<cpputils::AdaptiveMutex> lock(mutex);
+        value++;
+    });
+    EXPECT_EQ(counter, THREAD_COUNT * INCREMENTS);
+}
+
+TEST(Futex, TicketLockExcludes)
+{
+    cpputils::TicketLock ticketLock;
+    EXPECT_TRUE(ticketLock.try_lock());
+    EXPECT_FALSE(ticketLock.try_lock());
+    ticketLock.unlock();
+
+    const uint64_t counter = hammer([&ticketLock](uint64_t& value) {
+        std::lock_guard<cpputils::TicketLock> lock(ticketLock);
+        value++;
+    });
+    EXPECT_EQ(counter, THREAD_COUNT * INCREMENTS);
+}
+
+TEST(Futex, McsLockExcludes)
+{
+    cpputils::McsLock mcsLock;
+    cpputils::McsLock::Node first;
+    cpputils::McsLock::Node second;
+    EXPECT_TRUE(mcsLock.tryLock(first));
+    EXPECT_FALSE(mcsLock.tryLock(second));
+    mcsLock.unlock(first);
+
+    const uint64_t counter = hammer([&mcsLock](uint64_t& value) {
+        cpputils::McsLock::Guard guard(mcsLock);
+        value++;
+    });
+    EXPECT_EQ(counter, THREAD_COUNT * INCREMENTS);
+}
+
+TEST(Futex, ParkedWaiterIsWoken)
+{
+    cpputils::AdaptiveMutex mutex;
+    cpputils::TicketLock ticketLock;
+    mutex.lock();
+    ticketLock.lock();
+    std::atomic<int> acquired{0};
+    std::thread waiter([&]() {
+        mutex.lock();
+        ticketLock.lock();
+        acquired = 1;
+        ticketLock.unlock();
+        mutex.unlock();
+    });
+
+    // Long enough for the waiter to give up spinning and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(acquired.load(), 0);
+    mutex.unlock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(acquired.load(), 0);
+    ticketLock.unlock();
+    waiter.join();
+    EXPECT_EQ(acquired.load(), 1);
+}
+
+TEST(Futex, OneShotEventReleasesAllWaiters)
+{
+    cpputils::OneShotEvent event;
+    std::atomic<int> released{0};
+    std::vector<std::thread> waiters;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        waiters.emplace_back([&]() {
+            event.wait();
+            released++;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(event.isSet());
+    EXPECT_EQ(released.load(), 0);
+
+    event.set();
+    for (std::thread& waiter : waiters) {
+        waiter.join();
+    }
+    EXPECT_EQ(released.load(), THREAD_COUNT);
+    event.wait(); // Stays set
+}
+
+TEST(Futex, SemaphoreCountsUnits)
+{
+    cpputils::Semaphore semaphore(2);
+    EXPECT_TRUE(semaphore.tryAcquire());
+    EXPECT_TRUE(semaphore.tryAcquire());
+    EXPECT_FALSE(semaphore.tryAcquire());
+
+    constexpr uint32_t ITEMS = 100'000;
+    std::atomic<uint32_t> consumed{0};
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        consumers.emplace_back([&]() {
+            for (uint32_t i = 0; i < ITEMS / THREAD_COUNT; i++) {
+                semaphore.acquire();
+                consumed++;
+            }
+        });
+    }
+    for (uint32_t i = 0; i < ITEMS; i += 10) {
+        semaphore.release(10);
+    }
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(consumed.load(), ITEMS);
+    EXPECT_EQ(semaphore.getCount(), 0u);
+}
+
+TEST(Futex, LatchOpensAtZero)
+{
+    cpputils::Latch latch(THREAD_COUNT + 1);
+    EXPECT_FALSE(latch.tryWait());
+
+    std::atomic<int> arrived{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&]() {
+            arrived++;
+            latch.arriveAndWait();
+        });
+    }
+    while (arrived.load() != THREAD_COUNT) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(latch.tryWait());
+
+    latch.countDown();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(latch.tryWait());
+}
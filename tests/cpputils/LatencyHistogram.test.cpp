@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/LatencyHistogram.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+using Histogram = cpputils::LatencyHistogram<7>;
+
+TEST(LatencyHistogram, EmptyHistogramReportsZero)
+{
+    Histogram histogram;
+    EXPECT_EQ(histogram.getCount(), 0);
+    EXPECT_EQ(histogram.getMin(), 0ns);
+    EXPECT_EQ(histogram.getMax(), 0ns);
+    EXPECT_EQ(histogram.getPercentile(99.0), 0ns);
+    EXPECT_EQ(histogram.getMeanNs(), 0.0);
+}
+
+TEST(LatencyHistogram, BucketBoundsContainValue)
+{
+    for (uint64_t value : {0ull, 1ull, 127ull, 128ull, 255ull, 256ull, 1'000ull, 123'456'789ull, 60'000'000'000ull}) {
+        const size_t index = Histogram::bucketIndex(value);
+        ASSERT_LT(index, Histogram::BUCKET_COUNT);
+        EXPECT_LE(Histogram::bucketLowerBound(index), value);
+        EXPECT_GE(Histogram::bucketUpperBound(index), value);
+    }
+    EXPECT_EQ(Histogram::bucketIndex(Histogram::MAX_TRACKABLE_NS), Histogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(Histogram::bucketIndex(~0ull), Histogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogram, RelativeErrorIsBounded)
+{
+    for (uint64_t value = 1; value < 100'000'000'000ull; value = value * 3 + 7) {
+        const size_t index = Histogram::bucketIndex(value);
+        const double width = static_cast<double>(Histogram::bucketUpperBound(index) - Histogram::bucketLowerBound(index));
+        EXPECT_LE(width / static_cast<double>(value), 1.0 / Histogram::SUB_BUCKET_COUNT) << value;
+    }
+}
+
+TEST(LatencyHistogram, PercentilesOfUniformSamples)
+{
+    Histogram histogram;
+    for (int i = 1; i <= 10'000; i++) {
+        histogram.record(std::chrono::nanoseconds(i * 100));
+    }
+
+    EXPECT_EQ(histogram.getCount(), 10'000);
+    EXPECT_EQ(histogram.getMin(), 100ns);
+    EXPECT_EQ(histogram.getMax(), 1'000'000ns);
+    EXPECT_NEAR(histogram.getPercentile(50.0).count(), 500'000, 500'000 / 128);
+    EXPECT_NEAR(histogram.getPercentile(99.0).count(), 990'000, 990'000 / 128);
+    EXPECT_NEAR(histogram.getPercentile(99.9).count(), 999'000, 999'000 / 128);
+    EXPECT_EQ(histogram.getPercentile(100.0), 1'000'000ns);
+    EXPECT_DOUBLE_EQ(histogram.getMeanNs(), 500'050.0);
+    EXPECT_NEAR(histogram.getStdDevNs(), 288'675.0, 10.0);
+    EXPECT_EQ(histogram.getPercentile<std::chrono::microseconds>(50.0).count() / 10, 50);
+}
+
+TEST(LatencyHistogram, MergeMatchesCombinedRecording)
+{
+    Histogram a;
+    Histogram b;
+    Histogram combined;
+    for (int i = 0; i < 1'000; i++) {
+        const auto value = std::chrono::nanoseconds(i * i + 5);
+        (i % 2 == 0 ? a : b).record(value);
+        combined.record(value);
+    }
+
+    a.merge(b);
+    EXPECT_EQ(a.getCount(), combined.getCount());
+    EXPECT_EQ(a.getMin(), combined.getMin());
+    EXPECT_EQ(a.getMax(), combined.getMax());
+    EXPECT_EQ(a.getSum(), combined.getSum());
+    for (double percentile : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+        EXPECT_EQ(a.getPercentile(percentile), combined.getPercentile(percentile));
+    }
+}
+
+TEST(LatencyHistogram, RemoveUndoesRecord)
+{
+    Histogram window;
+    for (int i = 1; i <= 100; i++) {
+        window.record(std::chrono::nanoseconds(i * 1'000));
+    }
+    for (int i = 1; i <= 50; i++) {
+        window.remove(std::chrono::nanoseconds(i * 1'000));
+    }
+
+    EXPECT_EQ(window.getCount(), 50u);
+    EXPECT_EQ(window.getSum(), std::chrono::nanoseconds(1'000 * (51 + 100) * 50 / 2));
+    EXPECT_GE(window.getPercentile(1.0), 51us);
+    EXPECT_GE(window.getPercentile(50.0), 75us);
+    EXPECT_LE(window.getPercentile(50.0), 76us);
+}
+
+TEST(LatencyHistogram, HistogramTimerRecordsIntervals)
+{
+    cpputils::HistogramTimer<std::chrono::steady_clock> timer;
+    for (int i = 0; i < 10; i++) {
+        timer.start();
+        timer.stop();
+    }
+    EXPECT_EQ(timer.getHistogram().getCount(), 10);
+    EXPECT_LE(timer.getPercentile(50.0), timer.getHistogram().getMax());
+
+    timer.reset();
+    EXPECT_EQ(timer.getHistogram().getCount(), 0);
+}
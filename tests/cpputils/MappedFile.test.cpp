@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+static std::string tempPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(MappedFile, CreateZeroFillsAndPersistsWrites)
+{
+    const std::string path = tempPath("cpputils_mapped_file.test");
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::CREATE, 8192);
+        ASSERT_TRUE(file.valid());
+        ASSERT_EQ(file.size(), 8192u);
+
+        unsigned char* bytes = static_cast<unsigned char*>(file.data());
+        EXPECT_EQ(bytes[0], 0);
+        EXPECT_EQ(bytes[8191], 0);
+        std::memcpy(bytes + 4096, "flight", 6);
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(path), 8192u);
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::READ_ONLY);
+        ASSERT_TRUE(file.valid());
+        EXPECT_EQ(file.size(), 8192u);
+        EXPECT_EQ(std::memcmp(static_cast<const unsigned char*>(file.data()) + 4096, "flight", 6), 0);
+        EXPECT_FALSE(file.flush());
+    }
+
+    // CREATE truncates what was there
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::CREATE, 4096);
+        ASSERT_TRUE(file.valid());
+        EXPECT_EQ(static_cast<const unsigned char*>(file.data())[0], 0);
+        EXPECT_TRUE(file.flush());
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), 4096u);
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, ReadWriteModifiesExistingFile)
+{
+    const std::string path = tempPath("cpputils_mapped_file_rw.test");
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::CREATE, 4096);
+        ASSERT_TRUE(file.valid());
+    }
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::READ_WRITE);
+        ASSERT_TRUE(file.valid());
+        static_cast<char*>(file.data())[10] = 'x';
+    }
+    {
+        cpputils::MappedFile file(path, cpputils::MappedFileMode::READ_ONLY);
+        ASSERT_TRUE(file.valid());
+        EXPECT_EQ(static_cast<const char*>(file.data())[10], 'x');
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, MissingOrEmptyFileIsInvalid)
+{
+    const std::string path = tempPath("cpputils_mapped_file_missing.test");
+    std::remove(path.c_str());
+    cpputils::MappedFile missing(path, cpputils::MappedFileMode::READ_ONLY);
+    EXPECT_FALSE(missing.valid());
+    EXPECT_EQ(missing.data(), nullptr);
+
+    std::fclose(std::fopen(path.c_str(), "wb"));
+    cpputils::MappedFile empty(path, cpputils::MappedFileMode::READ_WRITE);
+    EXPECT_FALSE(empty.valid());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/MpmcQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MpmcQueue, FifoUntilFull)
+{
+    cpputils::MpmcQueue<int> queue(5);
+    ASSERT_TRUE(queue.valid());
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(8));
+    EXPECT_EQ(queue.size(), 8u);
+
+    int value = -1;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(MpmcQueue, BatchesStopAtFullAndEmpty)
+{
+    cpputils::MpmcQueue<int> queue(8);
+    const std::array<int, 5> values{1, 2, 3, 4, 5};
+    std::array<int, 8> out{};
+
+    EXPECT_EQ(queue.pushBatch(values), 5u);
+    EXPECT_EQ(queue.pushBatch(values), 3u);
+    EXPECT_EQ(queue.pushBatch(values), 0u);
+
+    EXPECT_EQ(queue.popBatch(std::span<int>(out.data(), 6)), 6u);
+    EXPECT_EQ(queue.popBatch(out), 2u);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[1], 3);
+    EXPECT_EQ(queue.popBatch(out), 0u);
+}
+
+TEST(MpmcQueue, DestroysQueuedElements)
+{
+    std::shared_ptr<int> shared = std::make_shared<int>(1);
+    {
+        cpputils::MpmcQueue<std::shared_ptr<int>> queue(4);
+        queue.push(shared);
+        queue.push(shared);
+        EXPECT_EQ(queue.pop().get(), shared.get());
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(MpmcQueue, BlockedConsumerWakesOnPush)
+{
+    cpputils::MpmcQueue<int> queue(4);
+    std::atomic<int> received{0};
+    std::thread consumer([&]() { received = queue.pop(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(received.load(), 0);
+    queue.push(7);
+    consumer.join();
+    EXPECT_EQ(received.load(), 7);
+}
+
+TEST(MpmcQueue, ManyProducersManyConsumers)
+{
+    constexpr int PRODUCER_COUNT = 4;
+    constexpr int CONSUMER_COUNT = 4;
+    constexpr uint64_t PER_PRODUCER = 100'000;
+    constexpr uint64_t STOP = ~uint64_t{0};
+
+    cpputils::MpmcQueue<uint64_t> queue(64);
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> count{0};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < CONSUMER_COUNT; c++) {
+        threads.emplace_back([&, c]() {
+            uint64_t localSum = 0;
+            uint64_t localCount = 0;
+            std::array<uint64_t, 8> batch{};
+            for (bool running = true; running;) {
+                const size_t popped = c % 2 == 0 ? queue.popBatchAtLeastOne(batch) : (batch[0] = queue.pop(), 1);
+                for (size_t i = 0; i < popped; i++) {
+                    if (batch[i] != STOP) {
+                        localSum += batch[i];
+                        localCount++;
+                    } else if (!running) {
+                        queue.push(STOP); // Took another consumer's stop marker: hand it back
+                    } else {
+                        running = false;
+                    }
+                }
+            }
+            sum += localSum;
+            count += localCount;
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        producers.emplace_back([&, p]() {
+            std::array<uint64_t, 4> batch{};
+            for (uint64_t i = 0; i < PER_PRODUCER;) {
+                const uint64_t value = p * PER_PRODUCER + i;
+                if (i % 2 == 0) {
+                    queue.push(value);
+                    i++;
+                } else {
+                    for (size_t b = 0; b < batch.size(); b++) {
+                        batch[b] = value + b;
+                    }
+                    const size_t room = std::min<uint64_t>(batch.size(), PER_PRODUCER - i);
+                    const size_t pushed = queue.pushBatch(std::span<const uint64_t>(batch.data(), room));
+                    i += pushed;
+                    if (pushed == 0)
+                        std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    for (int c = 0; c < CONSUMER_COUNT; c++) {
+        queue.push(STOP);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const uint64_t total = PRODUCER_COUNT * PER_PRODUCER;
+    EXPECT_EQ(count.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ObjectPool.h"
+#include "cpputils/SpscRing.h"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Message
+{
+    uint64_t sequence{0};
+    std::string payload;
+};
+
+bool isAligned(const void* pointer, size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+} // namespace
+
+TEST(ObjectPool, CreateAndDestroy)
+{
+    cpputils::ObjectPool<Message> pool;
+    Message* message = pool.create(Message{7, "hello"});
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(message->sequence, 7u);
+    EXPECT_EQ(message->payload, "hello");
+    EXPECT_EQ(pool.getLiveCount(), 1u);
+    EXPECT_EQ(pool.getSlabCount(), 1u);
+    EXPECT_GE(pool.getObjectsPerSlab(), cpputils::ObjectPool<Message>::DEFAULT_OBJECTS_PER_SLAB);
+
+    pool.destroy(message);
+    EXPECT_EQ(pool.getLiveCount(), 0u);
+    // A freed slot is the next one handed out
+    EXPECT_EQ(pool.allocate(), static_cast<void*>(message));
+}
+
+TEST(ObjectPool, ObjectsAreDistinctAndAligned)
+{
+    cpputils::ObjectPool<uint64_t> natural(16);
+    cpputils::ObjectPool<uint64_t> padded(16, cpputils::ObjectPoolAlignment::CACHE_LINE);
+    EXPECT_EQ(natural.getObjectStride(), sizeof(uint64_t));
+    EXPECT_EQ(padded.getObjectStride(), cpputils::CACHE_LINE_SIZE);
+
+    std::set<void*> seen;
+    for (int i = 0; i < 1000; i++) {
+        void* a = natural.allocate();
+        void* b = padded.allocate();
+        ASSERT_NE(a, nullptr);
+        ASSERT_NE(b, nullptr);
+        EXPECT_TRUE(isAligned(a, alignof(uint64_t)));
+        EXPECT_TRUE(isAligned(b, cpputils::CACHE_LINE_SIZE));
+        EXPECT_TRUE(seen.insert(a).second);
+        EXPECT_TRUE(seen.insert(b).second);
+    }
+    // Small slabs: the pool grew past its first one
+    EXPECT_GT(natural.getSlabCount(), 1u);
+    EXPECT_GE(natural.getCapacity(), 1000u);
+    EXPECT_EQ(natural.getLiveCount(), 1000u);
+    EXPECT_GE(natural.getHighWaterCount(), 1000u);
+}
+
+TEST(ObjectPool, FlushedSlotsAreReusedByOtherThreads)
+{
+    cpputils::ObjectPool<Message> pool(64);
+    std::vector<Message*> messages;
+    for (int i = 0; i < 200; i++) {
+        messages.push_back(pool.create());
+    }
+    const size_t slabs = pool.getSlabCount();
+
+    std::thread freer([&]() {
+        for (Message* message : messages) {
+            pool.destroy(message);
+        }
+        pool.flushThreadCache();
+    });
+    freer.join();
+    EXPECT_EQ(pool.getLiveCount(), 0u);
+
+    // Every slot came back, so allocating as many again needs no new slab. This thread
+    // first uses up the rest of the batch it last carved.
+    std::set<Message*> previous(messages.begin(), messages.end());
+    size_t reused = 0;
+    for (int i = 0; i < 200; i++) {
+        reused += previous.count(pool.create());
+    }
+    EXPECT_GE(reused, 200u - cpputils::ObjectPool<Message>::BATCH_SIZE);
+    EXPECT_EQ(pool.getSlabCount(), slabs);
+}
+
+TEST(ObjectPool, ProducerAllocatesConsumerFrees)
+{
+    constexpr uint64_t MESSAGES = 200'000;
+    constexpr int PAIRS = 2;
+    cpputils::ObjectPool<Message> pool(256);
+
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> sums(PAIRS, 0);
+    std::vector<std::unique_ptr<cpputils::SpscRing<Message*>>> rings;
+    for (int p = 0; p < PAIRS; p++) {
+        rings.push_back(std::make_unique<cpputils::SpscRing<Message*>>(1024));
+    }
+    for (int p = 0; p < PAIRS; p++) {
+        threads.emplace_back([&, p]() {
+            for (uint64_t i = 1; i <= MESSAGES; i++) {
+                Message* message = pool.create();
+                ASSERT_NE(message, nullptr);
+                message->sequence = i;
+                while (!rings[p]->tryPush(message)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&, p]() {
+            for (uint64_t i = 1; i <= MESSAGES; i++) {
+                Message* message = nullptr;
+                while (!rings[p]->tryPop(message)) {
+                    std::this_thread::yield();
+                }
+                EXPECT_EQ(message->sequence, i);
+                sums[p] += message->sequence;
+                message->sequence = 0;
+                pool.destroy(message);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (uint64_t sum : sums) {
+        EXPECT_EQ(sum, MESSAGES * (MESSAGES + 1) / 2);
+    }
+    EXPECT_EQ(pool.getLiveCount(), 0u);
+    // Freed objects flowed back to the producers instead of growing the pool
+    EXPECT_LT(pool.getCapacity(), PAIRS * MESSAGES / 10);
+}
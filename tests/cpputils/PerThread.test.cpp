@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/PerThread.h"
+
+#include <thread>
+#include <vector>
+
+TEST(PerThread, SameThreadGetsSameInstance)
+{
+    cpputils::PerThread<int> perThread;
+    int& first = perThread.local();
+    first = 42;
+    EXPECT_EQ(&perThread.local(), &first);
+    EXPECT_EQ(perThread.local(), 42);
+    EXPECT_EQ(perThread.size(), 1);
+}
+
+TEST(PerThread, EachThreadGetsOwnInstance)
+{
+    cpputils::PerThread<int> perThread([]() { return std::make_unique<int>(0); });
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i <= 8; i++) {
+        threads.emplace_back([&perThread, i]() {
+            for (int j = 0; j < 1000; j++) {
+                perThread.local() += i;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    int total = 0;
+    perThread.forEach([&total](int& value) { total += value; });
+    EXPECT_EQ(total, 1000 * (1 + 2 + 3 + 4 + 5 + 6 + 7 + 8));
+    EXPECT_LE(perThread.size(), 8);
+}
+
+TEST(PerThread, IndependentOwnersDoNotShareInstances)
+{
+    // More owners than cache slots forces collisions in the thread-local cache
+    std::vector<std::unique_ptr<cpputils::PerThread<int>>> owners;
+    for (int i = 0; i < 40; i++) {
+        owners.push_back(std::make_unique<cpputils::PerThread<int>>());
+        owners.back()->local() = i;
+    }
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 40; i++) {
+            EXPECT_EQ(owners[i]->local(), i);
+        }
+    }
+}
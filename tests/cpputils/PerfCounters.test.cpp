@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/PerfCounters.h"
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace {
+
+// Faults in pages that are new to the process: heap memory may reuse pages that earlier tests faulted in
+void touchFreshPages()
+{
+#if defined(__linux__)
+    constexpr size_t BYTES = 16 * 4096;
+    void* mapping = mmap(nullptr, BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        return;
+    char* memory = static_cast<char*>(mapping);
+    for (size_t i = 0; i < BYTES; i += 64) {
+        memory[i] = static_cast<char>(i);
+    }
+    munmap(mapping, BYTES);
+#endif
+}
+
+} // namespace
+
+TEST(PerfCounterValues, DifferenceAndIpc)
+{
+    cpputils::PerfCounterValues before;
+    cpputils::PerfCounterValues after;
+    before.available.fill(true);
+    after.available.fill(true);
+    before.values[static_cast<size_t>(cpputils::PerfEvent::CYCLES)] = 1'000;
+    after.values[static_cast<size_t>(cpputils::PerfEvent::CYCLES)] = 3'000;
+    before.values[static_cast<size_t>(cpputils::PerfEvent::INSTRUCTIONS)] = 500;
+    after.values[static_cast<size_t>(cpputils::PerfEvent::INSTRUCTIONS)] = 6'500;
+    after.available[static_cast<size_t>(cpputils::PerfEvent::LLC_MISSES)] = false;
+
+    const cpputils::PerfCounterValues delta = after - before;
+    EXPECT_EQ(delta.get(cpputils::PerfEvent::CYCLES), 2'000u);
+    EXPECT_EQ(delta.get(cpputils::PerfEvent::INSTRUCTIONS), 6'000u);
+    EXPECT_DOUBLE_EQ(delta.getIpc(), 3.0);
+    EXPECT_FALSE(delta.isAvailable(cpputils::PerfEvent::LLC_MISSES));
+
+    std::ostringstream output;
+    delta.print(output);
+    EXPECT_NE(output.str().find("cycles=2000"), std::string::npos);
+    EXPECT_NE(output.str().find("LLC-misses=n/a"), std::string::npos);
+    EXPECT_NE(output.str().find("ipc=3"), std::string::npos);
+}
+
+// Passes both where perf_event_open works and where it is blocked
+TEST(PerfCounterGroup, ReadsOrReportsUnavailable)
+{
+    cpputils::PerfCounterGroup group;
+    const cpputils::PerfCounterValues before = group.read();
+
+    touchFreshPages();
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 100'000; i++) {
+        sum = sum + i;
+    }
+
+    const cpputils::PerfCounterValues delta = group.read() - before;
+    if (!group.valid()) {
+        EXPECT_FALSE(group.getUnavailableReason().empty());
+        for (size_t i = 0; i < cpputils::PERF_EVENT_COUNT; i++) {
+            EXPECT_FALSE(delta.available[i]);
+            EXPECT_EQ(delta.values[i], 0u);
+        }
+        GTEST_SKIP() << group.getUnavailableReason();
+    }
+
+    for (size_t i = 0; i < cpputils::PERF_EVENT_COUNT; i++) {
+        EXPECT_EQ(delta.available[i], group.isAvailable(static_cast<cpputils::PerfEvent>(i)));
+    }
+    if (group.isAvailable(cpputils::PerfEvent::INSTRUCTIONS)) {
+        EXPECT_GT(delta.get(cpputils::PerfEvent::INSTRUCTIONS), 100'000u);
+    }
+    if (group.isAvailable(cpputils::PerfEvent::PAGE_FAULTS)) {
+        EXPECT_GT(delta.get(cpputils::PerfEvent::PAGE_FAULTS), 0u);
+    }
+}
+
+TEST(ScopePrintPerfCounters, PrintsPrefixDurationAndCounters)
+{
+    if (!cpputils::PerfCounterGroup::threadLocal().valid())
+        GTEST_SKIP() << cpputils::PerfCounterGroup::threadLocal().getUnavailableReason();
+
+    std::ostringstream output;
+    {
+        cpputils::ScopePrintPerfCounters<std::chrono::steady_clock, std::chrono::microseconds> scope("work: ", output);
+        volatile uint64_t sum = 0;
+        for (uint64_t i = 0; i < 10'000; i++) {
+            sum = sum + i;
+        }
+    }
+    const std::string printed = output.str();
+    EXPECT_EQ(printed.rfind("work: ", 0), 0u);
+    EXPECT_NE(printed.find(" cycles="), std::string::npos);
+    EXPECT_NE(printed.find(" instructions="), std::string::npos);
+    EXPECT_EQ(printed.back(), '\n');
+}
+
+TEST(PerfStats, AveragesPerOperation)
+{
+    cpputils::PerfStats<std::chrono::steady_clock> stats;
+    for (int round = 0; round < 4; round++) {
+        stats.start();
+        volatile uint64_t sum = 0;
+        for (uint64_t i = 0; i < 10'000; i++) {
+            sum = sum + i;
+        }
+        stats.stop(10'000);
+    }
+
+    EXPECT_EQ(stats.getOperationCount(), 40'000u);
+    EXPECT_GE(stats.getAvgTimeNs(), 0);
+    if (stats.getTotals().isAvailable(cpputils::PerfEvent::INSTRUCTIONS)) {
+        EXPECT_GT(stats.getPerOp(cpputils::PerfEvent::INSTRUCTIONS), 1.0);
+    } else {
+        EXPECT_EQ(stats.getPerOp(cpputils::PerfEvent::INSTRUCTIONS), 0.0);
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/RcuCell.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> liveTables{0};
+
+// Two fields a writer always keeps equal; a torn read would see them differ
+struct Table
+{
+    Table(int first = 0, int second = 0) : first(first), second(second) { liveTables++; }
+    Table(const Table& other) : first(other.first), second(other.second) { liveTables++; }
+    Table(Table&& other) noexcept : first(other.first), second(other.second) { liveTables++; }
+    ~Table() { liveTables--; }
+
+    int first;
+    int second;
+};
+
+} // namespace
+
+TEST(RcuCell, ReadStoreAndUpdate)
+{
+    cpputils::EpochDomain domain;
+    cpputils::RcuCell<std::string> cell(domain, std::in_place, "first");
+    EXPECT_EQ(*cell.read(), "first");
+    EXPECT_EQ(cell.read()->size(), 5u);
+
+    cell.store("second");
+    EXPECT_EQ(cell.load(), "second");
+
+    cell.update([](std::string& value) { value += "!"; });
+    EXPECT_EQ(cell.load(), "second!");
+}
+
+TEST(RcuCell, AcquiredVersionSurvivesReplacement)
+{
+    {
+        cpputils::EpochDomain domain;
+        {
+            cpputils::RcuCell<Table> cell(Table(1, 1), domain);
+            cpputils::RcuRef<Table> held = cell.acquire();
+            cpputils::RcuRef<Table> copy = held;
+
+            cell.store(Table(2, 2));
+            cell.synchronize();
+            EXPECT_EQ(held->first, 1);
+            EXPECT_EQ(cell.read()->first, 2);
+            EXPECT_EQ(liveTables.load(), 2);
+
+            held.reset();
+            copy.reset();
+            cell.synchronize();
+            EXPECT_EQ(liveTables.load(), 1);
+        }
+        domain.synchronize();
+        EXPECT_EQ(liveTables.load(), 0);
+    }
+    EXPECT_EQ(liveTables.load(), 0);
+}
+
+TEST(RcuCell, ReplacedVersionsAreFreedAfterGracePeriod)
+{
+    cpputils::EpochDomain domain;
+    cpputils::RcuCell<Table> cell(Table(), domain);
+    for (int i = 1; i <= 100; i++) {
+        cell.store(Table(i, i));
+    }
+    cell.synchronize();
+    EXPECT_EQ(liveTables.load(), 1);
+    EXPECT_EQ(domain.getPendingCount(), 0u);
+}
+
+TEST(RcuCell, ConcurrentReadersNeverSeeTornValues)
+{
+    constexpr int READER_COUNT = 6;
+    constexpr int UPDATES = 2000;
+
+    cpputils::EpochDomain domain;
+    {
+        cpputils::RcuCell<Table> cell(Table(), domain);
+        std::atomic<bool> done{false};
+        std::atomic<int> torn{0};
+        std::atomic<int> regressed{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < READER_COUNT; r++) {
+            readers.emplace_back([&, r]() {
+                int last = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    int first = 0;
+                    if (r % 2 == 0) {
+                        cpputils::RcuSnapshot<Table> snapshot = cell.read();
+                        first = snapshot->first;
+                        torn += snapshot->first != snapshot->second;
+                    } else {
+                        cpputils::RcuRef<Table> ref = cell.acquire();
+                        first = ref->first;
+                        torn += ref->first != ref->second;
+                    }
+                    regressed += first < last;
+                    last = first;
+                }
+            });
+        }
+
+        std::thread writer([&]() {
+            for (int i = 1; i <= UPDATES; i++) {
+                cell.update([](Table& table) {
+                    table.first++;
+                    table.second++;
+                });
+            }
+            done = true;
+        });
+
+        writer.join();
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        EXPECT_EQ(torn.load(), 0);
+        EXPECT_EQ(regressed.load(), 0);
+        EXPECT_EQ(cell.read()->first, UPDATES);
+    }
+    domain.synchronize();
+    EXPECT_EQ(liveTables.load(), 0);
+}
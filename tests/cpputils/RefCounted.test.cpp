@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/RefCounted.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Tracked : public cpputils::RefCounted
+{
+public:
+    explicit Tracked(int value, std::atomic<int>& destroyed) : value(value), destroyed(destroyed) {}
+    ~Tracked() { destroyed++; }
+
+    cpputils::RefPtr<Tracked> self() { return refFromThis(this); }
+    cpputils::WeakRef<Tracked> weakSelf() { return weakFromThis(this); }
+
+    int value;
+    std::atomic<int>& destroyed;
+};
+
+class Base : public cpputils::RefCounted
+{
+public:
+    int baseValue{1};
+};
+
+// Base has no virtual destructor; makeRef still destroys a Derived as Derived
+class Derived : public Base
+{
+public:
+    explicit Derived(bool& destroyed) : destroyed(destroyed) {}
+    ~Derived() { destroyed = true; }
+
+    bool& destroyed;
+};
+
+} // namespace
+
+TEST(RefPtr, LastReferenceDestroysObject)
+{
+    std::atomic<int> destroyed{0};
+    cpputils::RefPtr<Tracked> first = cpputils::makeRef<Tracked>(7, destroyed);
+    EXPECT_EQ(first->value, 7);
+    EXPECT_EQ(first->getRefCount(), 1u);
+    {
+        cpputils::RefPtr<Tracked> copy = first;
+        EXPECT_EQ(first->getRefCount(), 2u);
+        EXPECT_TRUE(copy == first);
+        cpputils::RefPtr<Tracked> moved = std::move(copy);
+        EXPECT_FALSE(copy);
+        EXPECT_EQ(first->getRefCount(), 2u);
+    }
+    EXPECT_EQ(first->getRefCount(), 1u);
+    EXPECT_EQ(destroyed.load(), 0);
+
+    cpputils::RefPtr<Tracked> fromThis = first->self();
+    EXPECT_EQ(fromThis.get(), first.get());
+    fromThis.reset();
+    first = nullptr;
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(RefPtr, ConvertsToBaseAndDestroysAsCreatedType)
+{
+    bool destroyed = false;
+    {
+        cpputils::RefPtr<Base> base = cpputils::makeRef<Derived>(destroyed);
+        EXPECT_EQ(base->baseValue, 1);
+    }
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(WeakRef, LockFailsOnceObjectIsGone)
+{
+    std::atomic<int> destroyed{0};
+    cpputils::RefPtr<Tracked> strong = cpputils::makeRef<Tracked>(1, destroyed);
+    cpputils::WeakRef<Tracked> weak(strong);
+    cpputils::WeakRef<Tracked> weakCopy = strong->weakSelf();
+
+    EXPECT_FALSE(weak.expired());
+    EXPECT_EQ(weak.lock()->value, 1);
+
+    strong.reset();
+    EXPECT_EQ(destroyed.load(), 1);
+    EXPECT_TRUE(weak.expired());
+    EXPECT_FALSE(weak.lock());
+    EXPECT_FALSE(weakCopy.lock());
+}
+
+TEST(RefPtr, TryRefRefusesDeadObject)
+{
+    std::atomic<int> destroyed{0};
+    cpputils::RefPtr<Tracked> strong = cpputils::makeRef<Tracked>(1, destroyed);
+    Tracked* raw = strong.get();
+    cpputils::WeakRef<Tracked> keepMemory(strong);
+
+    EXPECT_EQ(cpputils::tryRef(raw).get(), raw);
+    strong.reset();
+    EXPECT_FALSE(cpputils::tryRef(raw));
+    EXPECT_FALSE(cpputils::tryRef<Tracked>(nullptr));
+}
+
+TEST(RefPtr, ConcurrentCopiesAndReleases)
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr int ITERATIONS = 50'000;
+
+    std::atomic<int> destroyed{0};
+    cpputils::RefPtr<Tracked> shared = cpputils::makeRef<Tracked>(1, destroyed);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([shared]() {
+            for (int i = 0; i < ITERATIONS; i++) {
+                cpputils::RefPtr<Tracked> copy = shared;
+                ASSERT_EQ(copy->value, 1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(shared->getRefCount(), 1u);
+    shared.reset();
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(WeakRef, RegistryLookupsRaceWithRelease)
+{
+    // Readers upgrade weak entries of a registry while the owners drop the objects:
+    // a lookup either fails or returns an object that is still alive.
+    constexpr int OBJECT_COUNT = 64;
+    constexpr int ROUNDS = 50;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        std::atomic<int> destroyed{0};
+        std::vector<cpputils::RefPtr<Tracked>> owners;
+        std::vector<cpputils::WeakRef<Tracked>> registry;
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            owners.push_back(cpputils::makeRef<Tracked>(i, destroyed));
+            registry.emplace_back(owners.back());
+        }
+
+        std::atomic<int> found{0};
+        std::thread reader([&registry, &found]() {
+            for (const cpputils::WeakRef<Tracked>& entry : registry) {
+                if (cpputils::RefPtr<Tracked> object = entry.lock()) {
+                    ASSERT_GE(object->getRefCount(), 1u);
+                    found++;
+                }
+            }
+        });
+        owners.clear();
+        reader.join();
+
+        EXPECT_EQ(destroyed.load(), OBJECT_COUNT);
+        EXPECT_LE(found.load(), OBJECT_COUNT);
+        for (const cpputils::WeakRef<Tracked>& entry : registry) {
+            EXPECT_TRUE(entry.expired());
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ResourceUsage.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+using namespace std::chrono_literals;
+
+TEST(ResourceUsage, SleepIsOffCpu)
+{
+    const cpputils::ResourceUsage before = cpputils::ResourceUsage::captureThread();
+    std::this_thread::sleep_for(30ms);
+    const cpputils::ResourceUsage delta = cpputils::ResourceUsage::captureThread() - before;
+
+    EXPECT_GE(delta.wallTime, 30ms);
+    EXPECT_GE(delta.getOffCpuTime(), 20ms);
+#if defined(__linux__)
+    EXPECT_GE(delta.voluntarySwitches, 1);
+#endif
+}
+
+TEST(ResourceUsage, TouchingFreshMemoryFaults)
+{
+    constexpr size_t BYTES = 8 * 1024 * 1024;
+    const cpputils::ResourceUsage before = cpputils::ResourceUsage::captureThread();
+#if defined(__linux__)
+    // A new mapping: glibc may serve even 8 MiB from heap pages an earlier test already faulted in
+    void* mapping = mmap(nullptr, BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    char* memory = static_cast<char*>(mapping);
+#else
+    std::unique_ptr<char[]> buffer(new char[BYTES]);
+    char* memory = buffer.get();
+#endif
+    std::memset(memory, 1, BYTES);
+    const cpputils::ResourceUsage delta = cpputils::ResourceUsage::captureThread() - before;
+
+    EXPECT_GT(delta.minorFaults, 0);
+    EXPECT_GT(delta.residentBytes, 0);
+    EXPECT_EQ(memory[BYTES - 1], 1);
+#if defined(__linux__)
+    munmap(mapping, BYTES);
+#endif
+}
+
+TEST(ResourceStats, AggregatesScopes)
+{
+    cpputils::ResourceStats stats;
+    for (int i = 0; i < 3; i++) {
+        cpputils::ResourceScope scope(stats);
+        std::this_thread::sleep_for(5ms);
+    }
+    {
+        cpputils::ResourceScope scope(stats);
+        const auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < 20ms) {
+        }
+    }
+
+    EXPECT_EQ(stats.getRegionCount(), 4u);
+    EXPECT_GE(stats.getTotals().wallTime, 35ms);
+    EXPECT_GE(stats.getAvgWallTimeNs(), 8'000'000);
+    EXPECT_GT(stats.getCpuUtilization(), 0.0);
+    EXPECT_LE(stats.getCpuUtilization(), 1.0);
+    EXPECT_GT(stats.getPeakResidentBytes(), 0);
+
+    stats.reset();
+    EXPECT_EQ(stats.getRegionCount(), 0u);
+    EXPECT_EQ(stats.getAvgCpuTimeNs(), 0);
+}
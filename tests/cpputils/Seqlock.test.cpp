@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/Seqlock.h"
+#include "cpputils/SharedMemory.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Every field equal: a torn read shows up as a mismatch
+struct Stamp
+{
+    std::array<uint64_t, 5> fields{};
+
+    bool consistent() const
+    {
+        for (uint64_t field : fields) {
+            if (field != fields[0])
+                return false;
+        }
+        return true;
+    }
+};
+
+Stamp makeStamp(uint64_t value)
+{
+    Stamp stamp;
+    stamp.fields.fill(value);
+    return stamp;
+}
+
+} // namespace
+
+TEST(Seqlock, StoreLoadAndUpdate)
+{
+    cpputils::Seqlock<Stamp> seqlock(makeStamp(3));
+    EXPECT_EQ(seqlock.load().fields[4], 3u);
+    const uint64_t before = seqlock.getSequence();
+
+    seqlock.update([](Stamp stamp) { return makeStamp(stamp.fields[0] + 1); });
+    EXPECT_EQ(seqlock.load().fields[2], 4u);
+    EXPECT_GT(seqlock.getSequence(), before);
+    EXPECT_EQ(seqlock.getSequence() % 2, 0u);
+
+    cpputils::Seqlock<Stamp> copy(seqlock);
+    EXPECT_EQ(copy.load().fields[0], 4u);
+}
+
+TEST(Seqlock, ReadersNeverSeeTornState)
+{
+    constexpr uint64_t WRITES = 200'000;
+    cpputils::Seqlock<Stamp> seqlock;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&]() {
+            uint64_t last = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const Stamp stamp = seqlock.load();
+                if (!stamp.consistent() || stamp.fields[0] < last)
+                    failures++;
+                last = stamp.fields[0];
+            }
+        });
+    }
+    for (uint64_t i = 1; i <= WRITES; i++) {
+        seqlock.store(makeStamp(i));
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_EQ(seqlock.load().fields[0], WRITES);
+}
+
+TEST(MultiWriterSeqlock, TryLoadFailsDuringWrite)
+{
+    cpputils::MultiWriterSeqlock<Stamp> seqlock;
+    seqlock.update([&seqlock](Stamp stamp) {
+        Stamp out = makeStamp(99);
+        EXPECT_FALSE(seqlock.tryLoad(out));
+        EXPECT_EQ(out.fields[0], 99u);
+        stamp.fields.fill(7);
+        return stamp;
+    });
+    Stamp out;
+    EXPECT_TRUE(seqlock.tryLoad(out));
+    EXPECT_EQ(out.fields[1], 7u);
+}
+
+TEST(MultiWriterSeqlock, WritersSerialiseUpdates)
+{
+    constexpr uint64_t PER_WRITER = 50'000;
+    constexpr int WRITER_COUNT = 4;
+    cpputils::MultiWriterSeqlock<Stamp> seqlock;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            if (!seqlock.load().consistent())
+                failures++;
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITER_COUNT; w++) {
+        writers.emplace_back([&]() {
+            for (uint64_t i = 0; i < PER_WRITER; i++) {
+                seqlock.update([](const Stamp& stamp) { return makeStamp(stamp.fields[0] + 1); });
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_EQ(seqlock.load().fields[0], WRITER_COUNT * PER_WRITER);
+}
+
+TEST(MultiWriterSeqlock, LivesInZeroFilledSharedMemory)
+{
+    const std::string key = "cpputils_seqlock_test";
+    cpputils::SharedMemory::remove(key);
+    {
+        using SharedStamp = cpputils::MultiWriterSeqlock<Stamp>;
+        cpputils::SharedMemory first(key, sizeof(SharedStamp));
+        cpputils::SharedMemory second(key, sizeof(SharedStamp));
+        ASSERT_TRUE(first.valid() && second.valid());
+
+        auto* writer = static_cast<SharedStamp*>(first.data());
+        auto* reader = static_cast<SharedStamp*>(second.data());
+        EXPECT_EQ(reader->load().fields[0], 0u);
+        writer->store(makeStamp(42));
+        EXPECT_EQ(reader->load().fields[3], 42u);
+    }
+    cpputils::SharedMemory::remove(key);
+}
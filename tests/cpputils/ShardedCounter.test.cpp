@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ShardedCounter.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ShardedCounter, ReadIsExactAndApproximateIsBounded)
+{
+    cpputils::ShardedCounter counter(16, 4);
+    EXPECT_EQ(counter.getShardCount(), 4u);
+    for (int i = 0; i < 1000; i++) {
+        counter.add();
+    }
+    counter.subtract(10);
+    EXPECT_EQ(counter.read(), 990);
+    EXPECT_LE(counter.read() - counter.readApproximate(), 16 * 4);
+
+    counter.reset();
+    EXPECT_EQ(counter.read(), 0);
+    EXPECT_EQ(counter.readApproximate(), 0);
+}
+
+TEST(ShardedCounter, ConcurrentAddsAreAllCounted)
+{
+    constexpr int THREAD_COUNT = 8;
+    constexpr int ADDS_PER_THREAD = 100'000;
+
+    cpputils::ShardedCounter counter(64, 4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < ADDS_PER_THREAD; i++) {
+                counter.add(2);
+                counter.subtract();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.read(), THREAD_COUNT * ADDS_PER_THREAD);
+    EXPECT_LE(counter.read() - counter.readApproximate(), 64 * 4);
+}
+
+TEST(ShardedRefCount, KillWithNoOutstandingReferencesReleases)
+{
+    cpputils::ShardedRefCount refs(4);
+    refs.get();
+    EXPECT_FALSE(refs.put());
+    EXPECT_EQ(refs.read(), 1u);
+    EXPECT_TRUE(refs.kill());
+    EXPECT_TRUE(refs.isKilled());
+    EXPECT_EQ(refs.read(), 0u);
+    EXPECT_FALSE(refs.tryGet());
+}
+
+TEST(ShardedRefCount, LastPutAfterKillReleases)
+{
+    cpputils::ShardedRefCount refs(4);
+    refs.get();
+    refs.get();
+    EXPECT_FALSE(refs.kill());
+    EXPECT_EQ(refs.read(), 2u);
+
+    // Still usable through the shared counter
+    EXPECT_TRUE(refs.tryGet());
+    EXPECT_FALSE(refs.put());
+    EXPECT_FALSE(refs.put());
+    EXPECT_TRUE(refs.put());
+    EXPECT_EQ(refs.read(), 0u);
+}
+
+TEST(ShardedRefCount, ReferencesMovedBetweenThreadsBalance)
+{
+    // Gets on one thread, puts on another: individual cells go negative
+    cpputils::ShardedRefCount refs(8);
+    std::thread getter([&refs]() {
+        for (int i = 0; i < 1000; i++) {
+            refs.get();
+        }
+    });
+    getter.join();
+    std::thread putter([&refs]() {
+        for (int i = 0; i < 999; i++) {
+            EXPECT_FALSE(refs.put());
+        }
+    });
+    putter.join();
+
+    EXPECT_FALSE(refs.kill());
+    EXPECT_EQ(refs.read(), 1u);
+    EXPECT_TRUE(refs.put());
+}
+
+TEST(ShardedRefCount, ExactlyOneReleaseUnderConcurrentKill)
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr int ITERATIONS = 20'000;
+
+    for (int round = 0; round < 20; round++) {
+        cpputils::ShardedRefCount refs(4);
+        std::atomic<int> releases{0};
+        std::atomic<bool> start{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            refs.get(); // Each worker's own reference
+            threads.emplace_back([&]() {
+                while (!start.load()) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < ITERATIONS; i++) {
+                    refs.get();
+                    if (refs.put())
+                        releases++;
+                }
+                if (refs.put())
+                    releases++;
+            });
+        }
+        start = true;
+        if (refs.kill())
+            releases++;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        ASSERT_EQ(releases.load(), 1);
+        ASSERT_EQ(refs.read(), 0u);
+    }
+}
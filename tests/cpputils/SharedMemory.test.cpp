@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/SharedMemory.h"
+
+#include <cstring>
+#include <string>
+
+TEST(SharedMemory, SameKeySharesBytes)
+{
+    const std::string key = "cpputils_shared_memory_test";
+    cpputils::SharedMemory::remove(key);
+    {
+        cpputils::SharedMemory first(key, 4096);
+        ASSERT_TRUE(first.valid());
+        ASSERT_EQ(first.size(), 4096u);
+        EXPECT_EQ(static_cast<const unsigned char*>(first.data())[0], 0);
+
+        cpputils::SharedMemory second(key, 4096);
+        ASSERT_TRUE(second.valid());
+        EXPECT_NE(first.data(), second.data());
+
+        std::memcpy(first.data(), "shared", 6);
+        EXPECT_EQ(std::memcmp(second.data(), "shared", 6), 0);
+    }
+    cpputils::SharedMemory::remove(key);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/SpscRing.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SpscRing, PushPopInOrderUntilFull)
+{
+    cpputils::SpscRing<int> ring(6);
+    ASSERT_TRUE(ring.valid());
+    EXPECT_EQ(ring.capacity(), 8u);
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(8));
+    EXPECT_EQ(ring.size(), 8u);
+
+    int value = -1;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(SpscRing, BatchesWrapAround)
+{
+    cpputils::SpscRing<int> ring(8);
+    const std::array<int, 5> values{1, 2, 3, 4, 5};
+    std::array<int, 8> out{};
+
+    EXPECT_EQ(ring.pushBatch(values), 5u);
+    EXPECT_EQ(ring.popBatch(std::span<int>(out.data(), 3)), 3u);
+    // 2 queued, 6 free: the second batch wraps and only 6 fit
+    EXPECT_EQ(ring.pushBatch(values), 5u);
+    EXPECT_EQ(ring.pushBatch(values), 1u);
+    EXPECT_EQ(ring.popBatch(out), 8u);
+    EXPECT_EQ(out, (std::array<int, 8>{4, 5, 1, 2, 3, 4, 5, 1}));
+}
+
+TEST(SpscRing, ReserveCommitPeekConsume)
+{
+    cpputils::SpscRing<uint32_t> ring(8);
+    ASSERT_TRUE(ring.tryPush(100));
+    uint32_t value = 0;
+    ASSERT_TRUE(ring.tryPop(value));
+
+    // Starts at slot 1, so the first span stops at the end of the buffer
+    std::span<uint32_t> slots = ring.reserve(10);
+    EXPECT_EQ(slots.size(), 7u);
+    for (size_t i = 0; i < slots.size(); i++) {
+        slots[i] = static_cast<uint32_t>(i);
+    }
+    ring.commit(5);
+    EXPECT_EQ(ring.size(), 5u);
+
+    std::span<const uint32_t> queued = ring.peek();
+    ASSERT_EQ(queued.size(), 5u);
+    EXPECT_EQ(queued[4], 4u);
+    ring.consume(2);
+    EXPECT_EQ(ring.peek().front(), 2u);
+    EXPECT_EQ(ring.reserve(10).size(), 2u);
+}
+
+TEST(SpscRing, DestroysQueuedElements)
+{
+    std::shared_ptr<int> shared = std::make_shared<int>(1);
+    {
+        cpputils::SpscRing<std::shared_ptr<int>> ring(4);
+        ring.tryPush(shared);
+        ring.tryPush(shared);
+        std::shared_ptr<int> popped;
+        ASSERT_TRUE(ring.tryPop(popped));
+        EXPECT_EQ(shared.use_count(), 3);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(SpscRing, ProducerConsumerDeliversEverything)
+{
+    constexpr uint64_t COUNT = 1'000'000;
+    cpputils::SpscRing<uint64_t> ring(256);
+
+    std::thread producer([&ring]() {
+        uint64_t next = 0;
+        std::array<uint64_t, 16> batch{};
+        while (next < COUNT) {
+            size_t pushed = 0;
+            if (next % 3 == 0) {
+                pushed = ring.tryPush(next) ? 1 : 0;
+            } else {
+                const size_t count = std::min<uint64_t>(batch.size(), COUNT - next);
+                for (size_t i = 0; i < count; i++) {
+                    batch[i] = next + i;
+                }
+                pushed = ring.pushBatch(std::span<const uint64_t>(batch.data(), count));
+            }
+            next += pushed;
+            if (pushed == 0)
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    std::array<uint64_t, 32> out{};
+    while (expected < COUNT) {
+        const size_t count = ring.popBatch(out);
+        for (size_t i = 0; i < count; i++) {
+            ordered = ordered && out[i] == expected;
+            expected++;
+        }
+        if (count == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, FailedAllocationRejectsPushAndPop)
+{
+    cpputils::SpscRing<uint64_t> ring(size_t{1} << 60);
+    ASSERT_FALSE(ring.valid());
+    const std::array<uint64_t, 4> values{1, 2, 3, 4};
+    EXPECT_FALSE(ring.tryPush(1));
+    EXPECT_EQ(ring.pushBatch(values), 0u);
+    EXPECT_TRUE(ring.reserve(4).empty());
+
+    uint64_t value = 0;
+    EXPECT_FALSE(ring.tryPop(value));
+    std::array<uint64_t, 4> out{};
+    EXPECT_EQ(ring.popBatch(out), 0u);
+    EXPECT_TRUE(ring.peek().empty());
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ThreadPool.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+uint64_t fib(cpputils::ThreadPool& pool, uint32_t n)
+{
+    if (n < 2)
+        return n;
+    uint64_t left = 0;
+    cpputils::TaskGroup group(pool);
+    group.run([&]() { left = fib(pool, n - 1); });
+    const uint64_t right = fib(pool, n - 2);
+    group.wait();
+    return left + right;
+}
+
+} // namespace
+
+TEST(ThreadPool, TaskStoresSmallCallablesInline)
+{
+    int calls = 0;
+    std::array<uint64_t, 4> captured{1, 2, 3, 4};
+    cpputils::Task small([&calls, captured]() { calls += static_cast<int>(captured[3]); });
+    cpputils::Task moved(std::move(small));
+    EXPECT_FALSE(small);
+    moved();
+    EXPECT_EQ(calls, 4);
+
+    std::shared_ptr<int> shared = std::make_shared<int>(0);
+    std::array<uint64_t, 16> large{};
+    large[15] = 5;
+    {
+        cpputils::Task heap([shared, large]() { *shared += static_cast<int>(large[15]); });
+        cpputils::Task other;
+        other = std::move(heap);
+        other();
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(*shared, 5);
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ThreadPool, ChaseLevDequeOwnerAndThieves)
+{
+    constexpr int COUNT = 100'000;
+    std::vector<int> values(COUNT);
+    std::vector<std::atomic<int>> seen(COUNT);
+    cpputils::detail::ChaseLevDeque<int*> deque(4);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; t++) {
+        thieves.emplace_back([&]() {
+            while (!done.load()) {
+                if (int* value = deque.steal())
+                    seen[value - values.data()]++;
+            }
+        });
+    }
+    for (int i = 0; i < COUNT; i++) {
+        deque.push(&values[i]);
+        if (i % 3 == 0) {
+            if (int* value = deque.take())
+                seen[value - values.data()]++;
+        }
+    }
+    while (int* value = deque.take()) {
+        seen[value - values.data()]++;
+    }
+    done = true;
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+    for (int i = 0; i < COUNT; i++) {
+        ASSERT_EQ(seen[i].load(), 1) << i;
+    }
+}
+
+TEST(ThreadPool, SubmitRunsEverything)
+{
+    std::atomic<int> count{0};
+    {
+        cpputils::ThreadPool pool(4, 16);
+        for (int i = 0; i < 10'000; i++) {
+            pool.submit([&count]() { count++; });
+        }
+    } // Destructor drains
+    EXPECT_EQ(count.load(), 10'000);
+}
+
+TEST(ThreadPool, NestedForkJoin)
+{
+    cpputils::ThreadPool pool(4);
+    EXPECT_EQ(fib(pool, 22), 17711u);
+
+    // Waiting from inside a task helps instead of blocking a worker
+    std::atomic<uint64_t> result{0};
+    cpputils::TaskGroup outer(pool);
+    outer.run([&]() { result = fib(pool, 18); });
+    outer.wait();
+    EXPECT_EQ(result.load(), 2584u);
+}
+
+TEST(ThreadPool, ParallelForVisitsEachIndexOnce)
+{
+    cpputils::ThreadPool pool(4);
+    for (size_t grain : {size_t{0}, size_t{1}, size_t{7}, size_t{100'000}}) {
+        std::vector<std::atomic<int>> hits(10'007);
+        pool.parallelFor(0, hits.size(), [&](size_t i) { hits[i]++; }, grain);
+        for (size_t i = 0; i < hits.size(); i++) {
+            ASSERT_EQ(hits[i].load(), 1) << "grain " << grain << " index " << i;
+        }
+    }
+    pool.parallelFor(5, 5, [](size_t) { FAIL(); });
+}
+
+TEST(ThreadPool, ParallelReduceSumsInOrder)
+{
+    cpputils::ThreadPool pool(3);
+    const uint64_t sum = pool.parallelReduce(
+        0, 1'000'000, uint64_t{0},
+        [](size_t begin, size_t end, uint64_t init) {
+            for (size_t i = begin; i < end; i++) {
+                init += i;
+            }
+            return init;
+        },
+        [](uint64_t left, uint64_t right) { return left + right; });
+    EXPECT_EQ(sum, 999'999ull * 1'000'000 / 2);
+
+    // Non-commutative combine: chunks must come back in index order
+    const std::vector<size_t> order = pool.parallelReduce(
+        0, 100, std::vector<size_t>{},
+        [](size_t begin, size_t end, std::vector<size_t> init) {
+            for (size_t i = begin; i < end; i++) {
+                init.push_back(i);
+            }
+            return init;
+        },
+        [](std::vector<size_t> left, std::vector<size_t> right) {
+            left.insert(left.end(), right.begin(), right.end());
+            return left;
+        },
+        3);
+    ASSERT_EQ(order.size(), 100u);
+    for (size_t i = 0; i < order.size(); i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(ThreadPool, ManyExternalSubmitters)
+{
+    cpputils::ThreadPool pool(2, 64);
+    std::atomic<uint64_t> sum{0};
+    std::vector<std::thread> submitters;
+    for (uint64_t s = 0; s < 4; s++) {
+        submitters.emplace_back([&, s]() {
+            cpputils::TaskGroup group(pool);
+            for (uint64_t i = 0; i < 20'000; i++) {
+                group.run([&sum, value = s * 20'000 + i]() { sum += value; });
+            }
+        });
+    }
+    for (std::thread& submitter : submitters) {
+        submitter.join();
+    }
+    EXPECT_EQ(sum.load(), 79'999ull * 80'000 / 2);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/TimerLogSink.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(TimerLogSink, FlushWritesQueuedRecords)
+{
+    std::ostringstream output;
+    cpputils::TimerLogSink sink(output, 16, 1h);
+
+    EXPECT_TRUE(sink.push({"first ", 12, 3}));
+    EXPECT_TRUE(sink.push({"second ", -4, 3}));
+    sink.flush();
+
+    EXPECT_EQ(output.str(), "first 12 (thread 3)\nsecond -4 (thread 3)\n");
+    EXPECT_EQ(sink.getWrittenCount(), 2);
+    EXPECT_EQ(sink.getDroppedCount(), 0);
+}
+
+TEST(TimerLogSink, FullRingDropsAndCounts)
+{
+    std::ostringstream output;
+    cpputils::TimerLogSink sink(output, 8, 1h);
+
+    int accepted = 0;
+    for (int i = 0; i < 13; i++) {
+        accepted += sink.push({"x ", i, 1}) ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 8);
+    EXPECT_EQ(sink.getDroppedCount(), 5);
+
+    sink.flush();
+    EXPECT_EQ(sink.getWrittenCount(), 8);
+    EXPECT_NE(output.str().find("TimerLogSink dropped 5 records"), std::string::npos);
+
+    // Space is reclaimed after the flush
+    EXPECT_TRUE(sink.push({"x ", 99, 1}));
+}
+
+TEST(TimerLogSink, BackgroundThreadDrainsManyProducers)
+{
+    std::ostringstream output;
+    {
+        cpputils::TimerLogSink sink(output, 4096, 1ms);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&sink]() {
+                for (int i = 0; i < 1000; i++) {
+                    cpputils::AsyncScopePrintTimer<std::chrono::steady_clock, std::chrono::nanoseconds> timer("op ",
+                                                                                                            sink);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Every record is a line beginning with the prefix
+    std::istringstream lines(output.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(line.rfind("op ", 0), 0u);
+        count++;
+    }
+    EXPECT_EQ(count, 4000);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/TimingCollector.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using Collector = cpputils::ShardedTimingCollector<std::chrono::steady_clock>;
+
+TEST(ShardedTimingCollector, SingleThreadSnapshot)
+{
+    Collector collector;
+    collector.record(100ns);
+    collector.record(300ns);
+
+    Collector::Histogram snapshot = collector.snapshot();
+    EXPECT_EQ(snapshot.getCount(), 2);
+    EXPECT_EQ(snapshot.getSum(), 400ns);
+    EXPECT_EQ(snapshot.getMin(), 100ns);
+    EXPECT_EQ(snapshot.getMax(), 300ns);
+
+    // Snapshots are cumulative
+    collector.record(200ns);
+    EXPECT_EQ(collector.snapshot().getCount(), 3);
+
+    collector.reset();
+    EXPECT_EQ(collector.snapshot().getCount(), 0);
+}
+
+TEST(ShardedTimingCollector, ScopeRecordsOnDestruction)
+{
+    Collector collector;
+    {
+        Collector::Scope scope(collector);
+    }
+    EXPECT_EQ(collector.snapshot().getCount(), 1);
+}
+
+TEST(ShardedTimingCollector, ConcurrentSnapshotsAreConsistent)
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr int RECORDS_PER_THREAD = 200'000;
+
+    Collector collector;
+    std::atomic<bool> done{false};
+
+    // Every sample is 10ns, so a consistent cut always has sum == 10 * count
+    std::thread reader([&]() {
+        uint64_t lastCount = 0;
+        while (!done.load()) {
+            Collector::Histogram snapshot = collector.snapshot();
+            EXPECT_EQ(snapshot.getSum().count(), static_cast<int64_t>(snapshot.getCount()) * 10);
+            EXPECT_GE(snapshot.getCount(), lastCount);
+            lastCount = snapshot.getCount();
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        writers.emplace_back([&]() {
+            for (int j = 0; j < RECORDS_PER_THREAD; j++) {
+                collector.record(10ns);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    Collector::Histogram snapshot = collector.snapshot();
+    EXPECT_EQ(snapshot.getCount(), THREAD_COUNT * RECORDS_PER_THREAD);
+    EXPECT_EQ(snapshot.getSum().count(), THREAD_COUNT * RECORDS_PER_THREAD * 10);
+    EXPECT_LE(collector.getShardCount(), THREAD_COUNT + 1);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/TimingWheel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct TestTimer : cpputils::TimerNode
+{
+    int id{0};
+    std::vector<uint64_t> firedTicks;
+};
+
+template<typename Wheel>
+void advanceRecording(Wheel& wheel, uint64_t targetTick)
+{
+    wheel.advanceToTick(targetTick, [&wheel](cpputils::TimerNode& node) {
+        static_cast<TestTimer&>(node).firedTicks.push_back(wheel.getCurrentTick());
+    });
+}
+
+} // namespace
+
+TEST(TimingWheel, FiresExactlyOnExpiryTickAcrossLevels)
+{
+    cpputils::TimingWheel<> wheel;
+    const std::vector<uint64_t> expiries{1, 2, 255, 256, 257, 511, 65'535, 65'536, 65'537, 70'000, 16'777'221};
+    std::vector<TestTimer> timers(expiries.size());
+    for (size_t i = 0; i < expiries.size(); i++) {
+        wheel.scheduleTick(timers[i], expiries[i]);
+    }
+    EXPECT_EQ(wheel.size(), expiries.size());
+
+    advanceRecording(wheel, 16'777'300);
+    for (size_t i = 0; i < expiries.size(); i++) {
+        ASSERT_EQ(timers[i].firedTicks.size(), 1u) << "expiry " << expiries[i];
+        EXPECT_EQ(timers[i].firedTicks[0], expiries[i]);
+        EXPECT_FALSE(timers[i].isScheduled());
+    }
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimingWheel, CancelAndRearm)
+{
+    cpputils::TimingWheel<> wheel;
+    TestTimer cancelled;
+    TestTimer rearmed;
+    wheel.scheduleTick(cancelled, 10);
+    wheel.scheduleTick(rearmed, 10);
+
+    wheel.cancel(cancelled);
+    wheel.cancel(cancelled);
+    wheel.scheduleTick(rearmed, 300);
+    EXPECT_EQ(wheel.size(), 1u);
+
+    advanceRecording(wheel, 299);
+    EXPECT_TRUE(cancelled.firedTicks.empty());
+    EXPECT_TRUE(rearmed.firedTicks.empty());
+    advanceRecording(wheel, 300);
+    EXPECT_EQ(rearmed.firedTicks, std::vector<uint64_t>{300});
+}
+
+TEST(TimingWheel, CallbackCanRearmItsOwnNode)
+{
+    TestTimer periodic;
+    cpputils::TimingWheel<> wheel;
+    wheel.scheduleTick(periodic, 100);
+
+    const size_t expired = wheel.advanceToTick(1'000, [&wheel](cpputils::TimerNode& node) {
+        static_cast<TestTimer&>(node).firedTicks.push_back(wheel.getCurrentTick());
+        wheel.scheduleTick(node, wheel.getCurrentTick() + 100);
+    });
+
+    EXPECT_EQ(expired, 10u);
+    EXPECT_EQ(periodic.firedTicks.back(), 1'000u);
+    EXPECT_TRUE(periodic.isScheduled());
+}
+
+TEST(TimingWheel, TimersBeyondRangeAreRefiled)
+{
+    // Two levels of four slots cover only 15 ticks
+    cpputils::TimingWheel<std::chrono::steady_clock, 2, 2> wheel;
+    TestTimer far;
+    wheel.scheduleTick(far, 100);
+
+    advanceRecording(wheel, 99);
+    EXPECT_TRUE(far.firedTicks.empty());
+    advanceRecording(wheel, 200);
+    EXPECT_EQ(far.firedTicks, std::vector<uint64_t>{100});
+}
+
+TEST(TimingWheel, ClockTimesRoundUpToResolution)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    cpputils::TimingWheel<> wheel(10ms, start);
+    TestTimer timer;
+    wheel.schedule(timer, start + 25ms);
+    EXPECT_EQ(timer.getExpiryTick(), 3u);
+
+    int fired = 0;
+    EXPECT_EQ(wheel.advance(start + 29ms, [&fired](cpputils::TimerNode&) { fired++; }), 0u);
+    EXPECT_EQ(wheel.advance(start + 30ms, [&fired](cpputils::TimerNode&) { fired++; }), 1u);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(TimingWheel, RandomScheduleMatchesReference)
+{
+    // Nodes must outlive the wheel unless they are cancelled first
+    std::vector<TestTimer> timers(2'000);
+    cpputils::TimingWheel<std::chrono::steady_clock, 4, 3> wheel;
+    std::mt19937_64 random(7);
+    std::vector<uint64_t> expected(timers.size(), 0);
+
+    uint64_t now = 0;
+    for (int round = 0; round < 50; round++) {
+        for (size_t i = 0; i < timers.size(); i++) {
+            const uint64_t action = random() % 4;
+            if (action == 0) {
+                wheel.cancel(timers[i]);
+                expected[i] = 0;
+            } else if (action == 1 || !timers[i].isScheduled()) {
+                expected[i] = now + 1 + random() % 10'000;
+                wheel.scheduleTick(timers[i], expected[i]);
+            }
+        }
+
+        now += 1 + random() % 500;
+        advanceRecording(wheel, now);
+        for (size_t i = 0; i < timers.size(); i++) {
+            if (expected[i] != 0 && expected[i] <= now) {
+                ASSERT_FALSE(timers[i].firedTicks.empty());
+                EXPECT_EQ(timers[i].firedTicks.back(), expected[i]);
+                expected[i] = 0;
+            }
+            timers[i].firedTicks.clear();
+            EXPECT_EQ(timers[i].isScheduled(), expected[i] != 0);
+        }
+    }
+}
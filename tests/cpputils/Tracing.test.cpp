@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/Tracing.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using Tracer = cpputils::Tracer<std::chrono::steady_clock>;
+using TraceScope = cpputils::TraceScope<std::chrono::steady_clock>;
+
+static size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+TEST(Tracer, DisabledRecordsNothing)
+{
+    Tracer tracer(64);
+    {
+        TraceScope scope("ignored", "test", tracer);
+    }
+    tracer.instant("ignored");
+
+    std::ostringstream output;
+    tracer.exportJson(output);
+    EXPECT_EQ(output.str().find("ignored"), std::string::npos);
+}
+
+TEST(Tracer, ExportsScopesInstantsCountersAndThreadNames)
+{
+    Tracer tracer(64);
+    tracer.setEnabled(true);
+    tracer.setThreadName("main \"test\" thread");
+    {
+        TraceScope scope("outer", "test", tracer);
+        TraceScope inner("inner", "test", tracer);
+    }
+    tracer.instant("marker", "test");
+    tracer.counter("queue depth", 3.5);
+
+    std::thread worker([&tracer]() {
+        tracer.setThreadName("worker");
+        TraceScope scope("work", "test", tracer);
+    });
+    worker.join();
+
+    std::ostringstream output;
+    tracer.exportJson(output);
+    const std::string json = output.str();
+
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"X\""), 3u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"i\""), 1u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"M\""), 2u);
+    EXPECT_NE(json.find("\"name\":\"queue depth\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":3.5}"), std::string::npos);
+    EXPECT_NE(json.find("main \\\"test\\\" thread"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"worker\""), std::string::npos);
+}
+
+TEST(Tracer, RingKeepsMostRecentEvents)
+{
+    static const char* NAMES[] = {"e0", "e1", "e2", "e3", "e4", "e5", "e6", "e7", "e8", "e9"};
+
+    // Capacity rounds up to 8 slots, one of which is kept spare
+    Tracer tracer(5);
+    tracer.setEnabled(true);
+    for (const char* name : NAMES) {
+        tracer.instant(name);
+    }
+
+    std::ostringstream output;
+    tracer.exportJson(output);
+    const std::string json = output.str();
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"i\""), 7u);
+    EXPECT_EQ(json.find("\"e2\""), std::string::npos);
+    EXPECT_NE(json.find("\"e3\""), std::string::npos);
+    EXPECT_NE(json.find("\"e9\""), std::string::npos);
+
+    tracer.clear();
+    std::ostringstream cleared;
+    tracer.exportJson(cleared);
+    EXPECT_EQ(countOccurrences(cleared.str(), "\"ph\":\"i\""), 0u);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/WaitFreeCounter.h"
+
+#include <thread>
+#include <vector>
+
+TEST(Counter, DecrementToZeroIsDetectedOnce)
+{
+    Counter counter;
+    EXPECT_TRUE(counter.increment_if_not_zero());
+    EXPECT_EQ(counter.read(), 2u);
+    EXPECT_FALSE(counter.decrement());
+    EXPECT_TRUE(counter.decrement());
+    EXPECT_EQ(counter.read(), 0u);
+    EXPECT_FALSE(counter.increment_if_not_zero());
+}
+
+TEST(Counter, BulkIncrementAndDecrement)
+{
+    Counter counter;
+    EXPECT_TRUE(counter.increment_if_not_zero(10));
+    EXPECT_EQ(counter.read(), 11u);
+    EXPECT_FALSE(counter.decrement(5));
+    EXPECT_EQ(counter.read(), 6u);
+    EXPECT_TRUE(counter.decrement(6));
+    EXPECT_FALSE(counter.increment_if_not_zero(3));
+    EXPECT_EQ(counter.read(), 0u);
+}
+
+TEST(Counter, ConcurrentDecrementsReportZeroExactlyOnce)
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr int REFERENCES_PER_THREAD = 10'000;
+
+    Counter counter;
+    ASSERT_TRUE(counter.increment_if_not_zero(THREAD_COUNT * REFERENCES_PER_THREAD - 1));
+
+    std::atomic<int> zeroCount{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&counter, &zeroCount]() {
+            for (int i = 0; i < REFERENCES_PER_THREAD; i++) {
+                if (counter.decrement())
+                    zeroCount++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(zeroCount.load(), 1);
+    EXPECT_EQ(counter.read(), 0u);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "cpputils/ZoneProfiler.h"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using Profiler = cpputils::ZoneProfiler<std::chrono::steady_clock>;
+using Scope = cpputils::ZoneScope<std::chrono::steady_clock>;
+
+static constexpr cpputils::ZoneSite OUTER_SITE{"outer", std::source_location::current()};
+static constexpr cpputils::ZoneSite INNER_SITE{"inner", std::source_location::current()};
+static constexpr cpputils::ZoneSite OTHER_SITE{"other", std::source_location::current()};
+
+static void profiledWork(Profiler& profiler)
+{
+    Scope outer(OUTER_SITE, profiler);
+    for (int i = 0; i < 3; i++) {
+        Scope inner(INNER_SITE, profiler);
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(1ms);
+}
+
+TEST(ZoneProfiler, NestedZonesBuildCallTree)
+{
+    Profiler profiler;
+    profiledWork(profiler);
+    profiledWork(profiler);
+    {
+        Scope other(OTHER_SITE, profiler);
+    }
+
+    std::unique_ptr<Profiler::ReportNode> report = profiler.collect();
+    ASSERT_EQ(report->children.size(), 2u);
+
+    const Profiler::ReportNode* outer = report->find("outer");
+    ASSERT_NE(outer, nullptr);
+    EXPECT_EQ(outer->calls, 2u);
+    EXPECT_EQ(outer->histogram.getCount(), 2u);
+
+    const Profiler::ReportNode* inner = outer->find("inner");
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->calls, 6u);
+    EXPECT_TRUE(inner->children.empty());
+
+    // Inner time is attributed to outer's children, not its exclusive time
+    EXPECT_EQ(outer->childrenNs, inner->inclusiveNs);
+    EXPECT_GE(inner->inclusiveNs, 6'000'000u);
+    EXPECT_GE(outer->getExclusiveNs(), 2'000'000u);
+    EXPECT_LT(outer->getExclusiveNs(), outer->inclusiveNs);
+
+    // Same site in a different call path is a different node
+    EXPECT_EQ(report->find("inner"), nullptr);
+    EXPECT_EQ(report->find("other")->calls, 1u);
+}
+
+TEST(ZoneProfiler, MergesThreadTrees)
+{
+    Profiler profiler;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&profiler]() { profiledWork(profiler); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::unique_ptr<Profiler::ReportNode> report = profiler.collect();
+    ASSERT_EQ(report->children.size(), 1u);
+    EXPECT_EQ(report->find("outer")->calls, 4u);
+    EXPECT_EQ(report->find("outer")->find("inner")->calls, 12u);
+}
+
+TEST(ZoneProfiler, DumpListsZonesIndented)
+{
+    Profiler profiler;
+    profiledWork(profiler);
+
+    std::ostringstream output;
+    const std::ios_base::fmtflags flags = output.flags();
+    const std::streamsize precision = output.precision();
+    profiler.dump(output);
+    EXPECT_NE(output.str().find("\nouter"), std::string::npos);
+    EXPECT_NE(output.str().find("\n  inner"), std::string::npos);
+    EXPECT_EQ(output.flags(), flags);
+    EXPECT_EQ(output.precision(), precision);
+}
+
+TEST(ZoneProfiler, MacroUsesGlobalProfiler)
+{
+    {
+        CPPUTILS_PROFILE_ZONE("macro zone");
+    }
+    std::unique_ptr<cpputils::ZoneProfiler<>::ReportNode> report = cpputils::ZoneProfiler<>::instance().collect();
+    ASSERT_NE(report->find("macro zone"), nullptr);
+    EXPECT_GE(report->find("macro zone")->calls, 1u);
+}